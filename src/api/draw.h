@@ -9,6 +9,8 @@
 
 typedef void * SurfaceHandle;
 
+class Texture;
+
 class DrawingTool
 {
 public:
@@ -102,6 +104,9 @@ public:
     virtual void drawPolygon(const glm::dvec2 *vtx, int nvtx) { }
     virtual void drawPolygonLine(const glm::dvec2 *vtx, int nvtx) { }
 
+    // Composite surface (cached panel layer) onto this pad
+    virtual void drawSurface(Texture *surf, int x, int y) { }
+
 private:
     SurfaceHandle surf = nullptr;
 };
\ No newline at end of file
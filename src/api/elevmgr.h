@@ -53,7 +53,7 @@ struct ElevationTile
 
     int tgtlod;
     double lat0, lng0;
-    double lastAccess;
+    double lastAccess = 0.0;
 };
 
 using elevTileList_t = std::vector<ElevationTile>;
\ No newline at end of file
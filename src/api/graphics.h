@@ -8,7 +8,11 @@
 #include "api/ofsapi.h"
 #include "api/draw.h"
 #include "api/elevmgr.h"
-#include <GLFW/glfw3.h>
+
+// GLFW types - clients include GLFW themselves
+struct GLFWwindow;
+struct GLFWmonitor;
+struct GLFWvidmode;
 
 class Universe;
 class CelestialBody;
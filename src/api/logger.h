@@ -10,9 +10,143 @@
 #include <iostream>
 #include <fstream>
 #include <format>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
 
-#pragma once
+// Maximum log level compiled in (0 = fatal .. 5 = debug).
+// Define lower in release builds to remove debug messages.
+#ifndef OFS_LOG_LEVEL
+#define OFS_LOG_LEVEL       5
+#endif
+
+#define LOG_RINGSIZE        (256 * 1024)        // Per-thread ring buffer size [bytes]
+#define LOG_MAXMESSAGE      (LOG_RINGSIZE / 4)  // Maximum message size [bytes]
+#define LOG_FLUSHINTERVAL   20                  // Writer flush interval [ms]
+
+#define LOG_MAGIC           0x4c53464f          // 'OFSL'
+#define LOG_VERSION         1
+
+// Binary log file header
+struct LogFileHeader
+{
+    uint32_t magic;     // log file magic code
+    uint32_t version;   // log format version
+    uint32_t size;      // header size
+    uint32_t recSize;   // record header size
+};
+
+// Log record header - followed by message text
+struct LogRecord
+{
+    uint64_t time;      // time since logger started [ns]
+    uint64_t seq;       // global sequence number
+    uint32_t size;      // message size [bytes]
+    uint16_t thread;    // producer thread index
+    uint8_t  level;     // log level
+    uint8_t  category;  // log category
+};
+
+// Single producer/single consumer byte ring. Each thread
+// logging owns one ring and logger writer drains them all.
+class LogRing
+{
+public:
+    LogRing(uint16_t idx, size_t size = LOG_RINGSIZE)
+    : buffer(size), index(idx)
+    { }
+
+    inline uint16_t getIndex() const    { return index; }
+
+    // Ring ownership - producer thread releases its ring
+    // on exit and next new thread takes it over.
+    inline bool acquire()
+    {
+        bool owned = false;
+        return bOwned.compare_exchange_strong(owned, true, std::memory_order_acquire);
+    }
+    inline void release()               { bOwned.store(false, std::memory_order_release); }
+
+    inline bool isHalfFull() const
+    {
+        return head.load(std::memory_order_relaxed) -
+            tail.load(std::memory_order_relaxed) > buffer.size() / 2;
+    }
+
+    // Producer side - false if no room for record.
+    bool push(LogRecord &rec, std::string_view msg)
+    {
+        size_t need = sizeof(LogRecord) + align(msg.size());
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h + need - tail.load(std::memory_order_acquire) > buffer.size())
+            return false;
+
+        rec.size = msg.size();
+        rec.thread = index;
+        copyIn(h, &rec, sizeof(LogRecord));
+        copyIn(h + sizeof(LogRecord), msg.data(), msg.size());
+        head.store(h + need, std::memory_order_release);
+        return true;
+    }
 
+    // Consumer side - pass all pending records to func.
+    template <typename Func>
+    void drain(Func func)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t h = head.load(std::memory_order_acquire);
+
+        while (t < h)
+        {
+            LogRecord rec;
+            copyOut(t, &rec, sizeof(LogRecord));
+            std::string msg(rec.size, '\0');
+            copyOut(t + sizeof(LogRecord), msg.data(), rec.size);
+            func(rec, std::move(msg));
+            t += sizeof(LogRecord) + align(rec.size);
+        }
+        tail.store(t, std::memory_order_release);
+    }
+
+private:
+    static inline size_t align(size_t size)    { return (size + 7) & ~size_t(7); }
+
+    void copyIn(size_t pos, const void *src, size_t size)
+    {
+        size_t ofs = pos % buffer.size();
+        size_t first = std::min(size, buffer.size() - ofs);
+        std::memcpy(buffer.data() + ofs, src, first);
+        std::memcpy(buffer.data(), (const char *)src + first, size - first);
+    }
+
+    void copyOut(size_t pos, void *dst, size_t size) const
+    {
+        size_t ofs = pos % buffer.size();
+        size_t first = std::min(size, buffer.size() - ofs);
+        std::memcpy(dst, buffer.data() + ofs, first);
+        std::memcpy((char *)dst + first, buffer.data(), size - first);
+    }
+
+    std::vector<char> buffer;
+    uint16_t index;
+    std::atomic<bool> bOwned = true;
+
+    alignas(64) std::atomic<size_t> head = 0;   // producer write position
+    alignas(64) std::atomic<size_t> tail = 0;   // consumer read position
+};
+
+// Asynchronous logger
+//
+// Callers format messages into their own thread ring and return
+// without any I/O. Background writer thread collects records from
+// all rings in batches, orders them by sequence number and writes
+// them out as text or binary records.
 class Logger
 {
 public:
@@ -29,71 +163,177 @@ public:
         logDebug
     };
 
+    enum categoryType
+    {
+        catGeneral = 0,     // General messages
+        catConfig,          // Configuration (JSON) parameters
+        catUniverse,        // Universe/planetary systems
+        catVehicle,         // Vehicles and vehicle modules
+        catGraphics,        // Graphics clients
+        catMaxCategories
+    };
+
+    enum outputType
+    {
+        outText = 0,        // Formatted text
+        outBinary           // Binary records (log file only)
+    };
+
     Logger()
     : outLog(std::clog), outError(std::cerr)
-    { }
+    {
+        start();
+    }
 
     Logger(levelType logType, outStream &log, outStream &err)
-    : level(logType), outLog(log), outError(err)
-    { }
+    : outLog(log), outError(err)
+    {
+        setLevel(logType);
+        start();
+    }
 
-    Logger(levelType logType, const fs::path &logName)
-    : level(logType), outLog(std::clog), outError(std::cerr)
+    Logger(levelType logType, const fs::path &logName, outputType type = outText)
+    : outType(type), outLog(std::clog), outError(std::cerr)
     {
-        outLogFile.open(logName);
+        setLevel(logType);
+        if (outType == outBinary)
+        {
+            outLogFile.open(logName, std::ios::out|std::ios::binary);
+            LogFileHeader hdr = { LOG_MAGIC, LOG_VERSION, sizeof(LogFileHeader), sizeof(LogRecord) };
+            outLogFile.write((char *)&hdr, sizeof(hdr));
+        }
+        else
+            outLogFile.open(logName);
+        start();
     }
 
     ~Logger()
     {
+        {
+            std::unique_lock<std::mutex> lock(muWriter);
+            bRunning = false;
+        }
+        cvWriter.notify_one();
+        if (writer.joinable())
+            writer.join();
+
         if (outLogFile.is_open())
             outLogFile.close();
     }
 
-    inline void setLevel(levelType nLevel)      { level = nLevel; }
+    inline void setLevel(levelType nLevel)
+    {
+        for (auto &lvl : catLevels)
+            lvl.store(nLevel, std::memory_order_relaxed);
+    }
+
+    inline void setCategoryLevel(categoryType cat, levelType nLevel)
+    {
+        catLevels[cat].store(nLevel, std::memory_order_relaxed);
+    }
+
+    inline bool isEnabled(categoryType cat, levelType logType) const
+    {
+        return logType <= OFS_LOG_LEVEL &&
+            logType <= catLevels[cat].load(std::memory_order_relaxed);
+    }
 
-    // void vlog(levelType type, fmt::string_view format, fmt::format_args args) const;
+    // Wait until all messages logged so far are written out.
+    void flush() const
+    {
+        std::unique_lock<std::mutex> lock(muWriter);
+        uint64_t req = ++flushRequest;
+        cvWriter.notify_one();
+        cvFlushed.wait(lock, [&] { return flushDone >= req || !bRunning; });
+    }
 
     template <typename... Args>
     void log(levelType logType, cchar_t *format, const Args&... args) const
     {
-        if (logType <= level)
-            vlog(logType, std::string_view(format), std::make_format_args(args...));
+        log(catGeneral, logType, format, args...);
+    }
+
+    template <typename... Args>
+    void log(categoryType cat, levelType logType, cchar_t *format, const Args&... args) const
+    {
+        if (isEnabled(cat, logType))
+            vlog(cat, logType, std::string_view(format), std::make_format_args(args...));
     }
 
     template <typename... Args>
     inline void fatal(cchar_t *format, const Args&... args) const
     {
-        log(logFatal, format, args...);
+        log(catGeneral, logFatal, format, args...);
     }
 
     template <typename... Args>
     inline void error(cchar_t *format, const Args&... args) const
     {
-        log(logError, format, args...);
+        if constexpr (logError <= OFS_LOG_LEVEL)
+            log(catGeneral, logError, format, args...);
+    }
+
+    template <typename... Args>
+    inline void error(categoryType cat, cchar_t *format, const Args&... args) const
+    {
+        if constexpr (logError <= OFS_LOG_LEVEL)
+            log(cat, logError, format, args...);
     }
 
     template <typename... Args>
     inline void warn(cchar_t *format, const Args&... args) const
     {
-        log(logWarning, format, args...);
+        if constexpr (logWarning <= OFS_LOG_LEVEL)
+            log(catGeneral, logWarning, format, args...);
+    }
+
+    template <typename... Args>
+    inline void warn(categoryType cat, cchar_t *format, const Args&... args) const
+    {
+        if constexpr (logWarning <= OFS_LOG_LEVEL)
+            log(cat, logWarning, format, args...);
     }
 
     template <typename... Args>
     inline void info(cchar_t *format, const Args&... args) const
     {
-        log(logInfo, format, args...);
+        if constexpr (logInfo <= OFS_LOG_LEVEL)
+            log(catGeneral, logInfo, format, args...);
+    }
+
+    template <typename... Args>
+    inline void info(categoryType cat, cchar_t *format, const Args&... args) const
+    {
+        if constexpr (logInfo <= OFS_LOG_LEVEL)
+            log(cat, logInfo, format, args...);
     }
 
     template <typename... Args>
     inline void verbose(cchar_t *format, const Args&... args) const
     {
-        log(logVerbose, format, args...);
+        if constexpr (logVerbose <= OFS_LOG_LEVEL)
+            log(catGeneral, logVerbose, format, args...);
+    }
+
+    template <typename... Args>
+    inline void verbose(categoryType cat, cchar_t *format, const Args&... args) const
+    {
+        if constexpr (logVerbose <= OFS_LOG_LEVEL)
+            log(cat, logVerbose, format, args...);
     }
 
     template <typename... Args>
     inline void debug(cchar_t *format, const Args&... args) const
     {
-        log(logDebug, format, args...);
+        if constexpr (logDebug <= OFS_LOG_LEVEL)
+            log(catGeneral, logDebug, format, args...);
+    }
+
+    template <typename... Args>
+    inline void debug(categoryType cat, cchar_t *format, const Args&... args) const
+    {
+        if constexpr (logDebug <= OFS_LOG_LEVEL)
+            log(cat, logDebug, format, args...);
     }
 
     // void logMatrix(const glm::dmat4 &m, cstr_t &desc)
@@ -106,31 +346,171 @@ public:
     // }
 
 protected:
-    // inline void vlog(levelType level, fmt::string_view format, fmt::format_args args) const
-    // {
-    //     if (outLogFile.is_open())
-    //         outLogFile << fmt::vformat(format, args) << std::flush;
-    //     else
-    //     {
-    //         auto &out = (level <= logWarning || level == logDebug) ? outError : outLog;   
-    //         fmt::vprint(out, format, args);
-    //     }
-    // }
+    void vlog(categoryType cat, levelType logType, std::string_view format, std::format_args args) const
+    {
+        // Format into reusable per-thread buffer
+        thread_local std::string msg;
+        msg.clear();
+        std::vformat_to(std::back_inserter(msg), format, args);
+        if (msg.size() > LOG_MAXMESSAGE)
+            msg.resize(LOG_MAXMESSAGE);
+
+        LogRecord rec;
+        rec.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - startTime).count();
+        rec.seq = sequence.fetch_add(1, std::memory_order_relaxed);
+        rec.level = logType;
+        rec.category = cat;
+
+        LogRing *ring = getThreadRing();
+        while (!ring->push(rec, msg))
+        {
+            // Ring full - wake writer up and wait for room
+            cvWriter.notify_one();
+            std::this_thread::yield();
+        }
+        if (ring->isHalfFull())
+            cvWriter.notify_one();
+
+        // Errors are written out before returning.
+        if (logType <= logError)
+            flush();
+    }
 
-    inline void vlog(levelType level, std::string_view format, std::format_args args) const
+private:
+    LogRing *getThreadRing() const
+    {
+        struct ringEntry
+        {
+            const Logger *logger;
+            uint64_t id;
+            std::shared_ptr<LogRing> ring;
+        };
+        struct ringList
+        {
+            std::vector<ringEntry> entries;
+
+            // Thread exits - hand rings back for reuse.
+            ~ringList()
+            {
+                for (auto &entry : entries)
+                    entry.ring->release();
+            }
+        };
+        thread_local ringList threadRings;
+
+        for (auto &entry : threadRings.entries)
+            if (entry.logger == this && entry.id == loggerId)
+                return entry.ring.get();
+
+        // First message from this thread - take over ring
+        // released by exited thread or register new one.
+        std::erase_if(threadRings.entries, [this](const ringEntry &entry) { return entry.logger == this; });
+        std::unique_lock<std::mutex> lock(muRings);
+        std::shared_ptr<LogRing> ring;
+        for (auto &free : rings)
+            if (free->acquire())
+            {
+                ring = free;
+                break;
+            }
+        if (ring == nullptr)
+        {
+            ring = std::make_shared<LogRing>(rings.size());
+            rings.push_back(ring);
+        }
+        threadRings.entries.push_back({ this, loggerId, ring });
+        return ring.get();
+    }
+
+    void start()
+    {
+        bRunning = true;
+        writer = std::thread(&Logger::runWriter, this);
+    }
+
+    void runWriter()
+    {
+        std::vector<std::pair<LogRecord, std::string>> batch;
+        std::unique_lock<std::mutex> lock(muWriter);
+
+        for (;;)
+        {
+            cvWriter.wait_for(lock, std::chrono::milliseconds(LOG_FLUSHINTERVAL),
+                [this] { return !bRunning || flushRequest > flushDone; });
+            bool bStop = !bRunning;
+            uint64_t req = flushRequest;
+            lock.unlock();
+
+            {
+                std::unique_lock<std::mutex> rlock(muRings);
+                for (auto &ring : rings)
+                    ring->drain([&](const LogRecord &rec, std::string &&msg)
+                        { batch.emplace_back(rec, std::move(msg)); });
+            }
+
+            if (!batch.empty())
+            {
+                std::sort(batch.begin(), batch.end(),
+                    [](auto &a, auto &b) { return a.first.seq < b.first.seq; });
+                writeBatch(batch);
+                batch.clear();
+            }
+
+            lock.lock();
+            flushDone = req;
+            cvFlushed.notify_all();
+            if (bStop)
+                break;
+        }
+    }
+
+    void writeBatch(const std::vector<std::pair<LogRecord, std::string>> &batch)
     {
         if (outLogFile.is_open())
-            outLogFile << std::vformat(format, args) << std::flush;
-        else
         {
-            auto &out = (level <= logWarning || level == logDebug) ? outError : outLog;   
-            out << std::vformat(format, args) << std::flush;
+            for (auto &[rec, msg] : batch)
+            {
+                if (outType == outBinary)
+                    outLogFile.write((const char *)&rec, sizeof(LogRecord));
+                outLogFile.write(msg.data(), msg.size());
+            }
+            outLogFile.flush();
+            return;
+        }
+
+        for (auto &[rec, msg] : batch)
+        {
+            auto &out = (rec.level <= logWarning || rec.level == logDebug) ? outError : outLog;
+            out.write(msg.data(), msg.size());
         }
+        outLog.flush();
+        outError.flush();
     }
 
-private:
-    levelType level = logInfo;
+    static inline std::atomic<uint64_t> nextLoggerId = 1;
+
+    const uint64_t loggerId = nextLoggerId.fetch_add(1);
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    std::atomic<int> catLevels[catMaxCategories] = {
+        logInfo, logInfo, logInfo, logInfo, logInfo };
+    outputType outType = outText;
+
+    mutable std::atomic<uint64_t> sequence = 0;
+    mutable std::mutex muRings;
+    mutable std::vector<std::shared_ptr<LogRing>> rings;
+
+    // Background writer controls
+    std::thread writer;
+    mutable std::mutex muWriter;
+    mutable std::condition_variable cvWriter;
+    mutable std::condition_variable cvFlushed;
+    mutable uint64_t flushRequest = 0;
+    uint64_t flushDone = 0;
+    bool bRunning = false;
+
     mutable logStream outLogFile;
     outStream &outLog;
     outStream &outError;
-};
\ No newline at end of file
+};
@@ -273,6 +273,8 @@ namespace ofs {
         lkeyLRCSLinMoveForward,
         lkeyLRCSLinMoveBackward,
 
+        lkeyToggleProfiler,
+
         lkeyCount
     };
 };
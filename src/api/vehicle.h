@@ -49,6 +49,10 @@ public:
     virtual void setClassCaps() {}
     virtual void setGearParameters(double state) {}
 
+    // Module state for checkpoint save/restore (opaque blob)
+    virtual void saveState(std::vector<uint8_t> &blob) {}
+    virtual void restoreState(const std::vector<uint8_t> &blob) {}
+
 protected:
     // thrust_t *createThruster(const glm::dvec3 &pos, const glm::dvec3 &dir, double maxth, tank_t *tank = nullptr);
     // void createThrusterGroup(thrust_t **th, int nThrusts, thrustType_t type);
@@ -86,6 +86,18 @@ IndexBuffer::~IndexBuffer()
     glDeleteBuffers(1, &id);
 }
 
+// Load 32-bit indices. Buffer must be bound while
+// VAO is bound to be part of its state.
+void IndexBuffer::allocate(const uint32_t *data, size_t size, int nmode)
+{
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, id);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(uint32_t), data, nmode);
+    type = GL_UNSIGNED_INT;
+    szData = size;
+    count = size;
+    mode = nmode;
+}
+
 void *IndexBuffer::map() const
 {
     bind();
@@ -155,3 +167,147 @@ void VertexArray::unbind() const
 {
     glBindVertexArray(0);
 }
+
+// ******** uniform buffer objects ********
+
+UniformBuffer::UniformBuffer(size_t size, int nFrames)
+: szFrame(size), nFrames(nFrames), fences(nFrames, nullptr)
+{
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &szAlign);
+    szFrame = (szFrame + szAlign - 1) & ~size_t(szAlign - 1);
+    create();
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    for (auto fence : fences)
+        if (fence != nullptr)
+            glDeleteSync(fence);
+
+    for (auto &buf : retired)
+    {
+        if (buf.fence != nullptr)
+            glDeleteSync(buf.fence);
+        release(buf.id, buf.data);
+    }
+    release(id, data);
+}
+
+void UniformBuffer::create()
+{
+    glGenBuffers(1, &id);
+    glBindBuffer(GL_UNIFORM_BUFFER, id);
+
+    bPersistent = GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage;
+    if (bPersistent)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT|GL_MAP_PERSISTENT_BIT|GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, szFrame * nFrames, nullptr, flags);
+        data = (uint8_t *)glMapBufferRange(GL_UNIFORM_BUFFER, 0, szFrame * nFrames, flags);
+        bPersistent = (data != nullptr);
+    }
+    if (!bPersistent)
+    {
+        glBufferData(GL_UNIFORM_BUFFER, szFrame * nFrames, nullptr, GL_DYNAMIC_DRAW);
+        data = new uint8_t[szFrame * nFrames];
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void UniformBuffer::release(GLuint bid, uint8_t *bdata)
+{
+    if (bPersistent)
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, bid);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    else
+        delete [] bdata;
+    glDeleteBuffers(1, &bid);
+}
+
+// Replace buffer by larger one. Blocks bound earlier in this
+// frame still refer to old buffer, so it is kept alive until
+// fence at end of this frame is signaled.
+void UniformBuffer::grow(size_t size)
+{
+    size_t nsize = std::max(szFrame * 2, size);
+    glLogger->warn(Logger::catGraphics, "Uniform buffer: frame region full - growing from {} to {} bytes\n",
+        szFrame, nsize);
+
+    retired.push_back({ id, data, nullptr });
+
+    // Fences guard regions of old buffer only.
+    for (auto &fence : fences)
+    {
+        if (fence != nullptr)
+            glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    szFrame = nsize;
+    create();
+    cOffset = 0;
+}
+
+void UniformBuffer::beginFrame()
+{
+    cFrame = (cFrame + 1) % nFrames;
+    cOffset = 0;
+
+    // Wait for GPU to finish with this region
+    GLsync &fence = fences[cFrame];
+    if (fence != nullptr)
+    {
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED)
+            ;
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    // Release replaced buffers that GPU is done with
+    std::erase_if(retired, [this](retired_t &buf)
+    {
+        if (buf.fence == nullptr || glClientWaitSync(buf.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+            return false;
+        glDeleteSync(buf.fence);
+        release(buf.id, buf.data);
+        return true;
+    });
+}
+
+void UniformBuffer::endFrame()
+{
+    if (fences[cFrame] != nullptr)
+        glDeleteSync(fences[cFrame]);
+    fences[cFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    for (auto &buf : retired)
+        if (buf.fence == nullptr)
+            buf.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void *UniformBuffer::allocate(size_t size, GLintptr &offset)
+{
+    size = (size + szAlign - 1) & ~size_t(szAlign - 1);
+    if (cOffset + size > szFrame)
+        grow(size);
+
+    offset = cFrame * szFrame + cOffset;
+    cOffset += size;
+
+    return data + offset;
+}
+
+void UniformBuffer::bind(int binding, GLintptr offset, size_t size) const
+{
+    if (!bPersistent)
+    {
+        glBindBuffer(GL_UNIFORM_BUFFER, id);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data + offset);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, id, offset, size);
+}
@@ -39,6 +39,9 @@ public:
     ~IndexBuffer();
 
     inline uint32_t getCount() const { return count; }
+    inline GLenum getType() const    { return type; }
+
+    void allocate(const uint32_t *data, size_t size, int mode = GL_STATIC_DRAW);
 
     void *map() const;
     void unmap() const;
@@ -49,6 +52,7 @@ public:
 private:
     GLuint id;
     int mode;
+    GLenum type = GL_UNSIGNED_SHORT;
     uint32_t count = 0;
     size_t szData = 0;
 };
@@ -75,3 +79,59 @@ private:
     std::vector<VertexBuffer *> vboList;
     std::vector<IndexBuffer *> iboList;
 };
+
+// Uniform buffer for std140 uniform blocks
+//
+// Buffer is split into one region per frame in flight. Blocks
+// are sub-allocated from current frame region and bound with
+// glBindBufferRange. Region is fenced at end of frame and waited
+// for before reuse, so data still read by GPU is never overwritten.
+// Buffer is persistently mapped if ARB_buffer_storage is available,
+// otherwise blocks are written to CPU copy and uploaded on bind.
+// When frame region runs full, buffer is replaced by one twice as
+// large. Old buffer is kept until GPU is done with current frame.
+class UniformBuffer
+{
+public:
+    UniformBuffer(size_t size, int nFrames = 3);
+    ~UniformBuffer();
+
+    void beginFrame();
+    void endFrame();
+
+    void *allocate(size_t size, GLintptr &offset);
+    void bind(int binding, GLintptr offset, size_t size) const;
+
+    template <typename T>
+    void update(int binding, const T &block)
+    {
+        GLintptr offset;
+        void *ptr = allocate(sizeof(T), offset);
+        memcpy(ptr, &block, sizeof(T));
+        bind(binding, offset, sizeof(T));
+    }
+
+private:
+    struct retired_t
+    {
+        GLuint   id;
+        uint8_t *data;
+        GLsync   fence;
+    };
+
+    void create();
+    void release(GLuint bid, uint8_t *bdata);
+    void grow(size_t size);
+
+    GLuint   id = 0;
+    size_t   szFrame;           // region size per frame
+    GLint    szAlign = 256;     // block offset alignment
+    int      nFrames;
+    int      cFrame = 0;        // current frame region
+    size_t   cOffset = 0;       // next block offset in region
+    bool     bPersistent = false;
+    uint8_t *data = nullptr;    // mapped buffer or CPU copy
+
+    std::vector<GLsync> fences;
+    std::vector<retired_t> retired; // replaced buffers in flight
+};
@@ -102,6 +102,7 @@ void glClient::cbCleanup()
 
     // Global initialization
     glPad::gexit();
+    SurfaceManager::gexit();
 
     // Release GLFW inteface
     glfwTerminate();
@@ -116,6 +117,9 @@ GLFWwindow *glClient::createRenderingWindow()
     // Set OpenGL version request
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+#ifdef DEBUG
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
     switch (videoData.mode)
     {
@@ -157,6 +161,7 @@ GLFWwindow *glClient::createRenderingWindow()
 
     glLogger->info("Loaded OpenGL version: {}.{}\n",
         GLAD_VERSION_MAJOR(version), GLAD_VERSION_MINOR(version));
+    glRenderer::initDebugOutput();
 
     // Initialize scene package
     ofsPath = OFS_HOME_DIR;
@@ -168,6 +173,7 @@ GLFWwindow *glClient::createRenderingWindow()
 
     // Global initialization
     glPad::ginit();
+    SurfaceManager::ginit();
 
     return window;
 }
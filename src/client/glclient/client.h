@@ -6,6 +6,7 @@
 #pragma once
 
 #include "glad/gl.h"
+#include <GLFW/glfw3.h>
 
 #include "api/logger.h"
 #include "api/module.h"
@@ -93,11 +94,16 @@ extern Logger *glLogger;
 extern Scene *glScene;
 extern fs::path ofsPath;
 
+// Synchronous error query - stalls the pipeline, so it is
+// compiled in debug builds only. Debug builds also report
+// errors through KHR_debug output (see glRenderer).
 inline void checkErrors()
 {
+#ifdef DEBUG
     GLenum err;
     while((err = glGetError()) != GL_NO_ERROR)
     {
         glLogger->debug("OpenGL Error: {}\n", err);
     }
+#endif
 }
\ No newline at end of file
@@ -12,7 +12,6 @@
 
 SurfaceHandler::SurfaceHandler()
 {
-    msFreq = 50;
     start();
 }
 
@@ -25,49 +24,42 @@ SurfaceHandler::~SurfaceHandler()
 void SurfaceHandler::start()
 {
     // Start handle() in separate thread process
+    runHandler = true;
     loader = std::thread([this]{ handle(); });
 }
 
 void SurfaceHandler::shutdown()
 {
     // terminate handle() in separate thread process
-    runHandler = false;
+    {
+        std::unique_lock<std::mutex> lock(muQueue);
+        runHandler = false;
+    }
+    cvQueue.notify_one();
     loader.join();
 }
 
 void SurfaceHandler::handle()
 {
-    const int nTiles = 12;
-    SurfaceTile *tile[nTiles];
-    int nCount = 0;
-
-    runHandler = true;
-    while (runHandler)
+    for (;;)
     {
-        // Loading tile(s) from queue
-        if (!tiles.empty())
-        {
-            std::unique_lock<std::mutex> mu1(muQueue);
-            while (!tiles.empty() && (nCount < nTiles))
-            {
-                tile[nCount++] = tiles.front();
-                tiles.pop();
-            }
-            mu1.unlock();
-        }
+        std::unique_lock<std::mutex> lock(muQueue);
+        cvQueue.wait(lock, [this] { return !runHandler || !tiles.empty(); });
+        if (!runHandler)
+            break;
 
-        // Loading texture images
-        if (nCount > 0)
-        {
-            std::unique_lock<std::mutex> mu2(muLoading);
-            for (int idx = 0; idx < nCount; idx++)
-                tile[idx]->load();
-            mu2.unlock();
-            nCount = 0;
-        }
+        SurfaceTile *tile = tiles.front();
+        tiles.pop_front();
 
-        // Periodic idle
-        std::this_thread::sleep_for(std::chrono::milliseconds(msFreq));
+        // Hold loading lock before releasing queue lock so that
+        // unqueue() can wait for tile in progress.
+        std::unique_lock<std::mutex> load(muLoading);
+        lock.unlock();
+
+        // Read data and build mesh. Texture upload is
+        // done later by render thread.
+        FrameScope scope(prfLoader);
+        tile->load();
     }
 }
 
@@ -75,32 +67,25 @@ void SurfaceHandler::queue(SurfaceTile *tile)
 {
     if (tile == nullptr)
         return;
-    if (tile->type == SurfaceTile::tileInQueue)
-        return;
-    
-    tile->type = SurfaceTile::tileInQueue;
-    tiles.push(tile);
-}
-
-bool SurfaceHandler::unqueue(SurfaceTile *tile)
-{
-    if (tile == nullptr)
-        return false;
-    if (tiles.empty())
-        return false;
-    if (tile->type != SurfaceTile::tileInQueue)
-        return false;
-
-    std::unique_lock<std::mutex> mu(muQueue);
 
-    mu.unlock();
-    return true;
+    {
+        std::unique_lock<std::mutex> lock(muQueue);
+        if (tile->type == SurfaceTile::tileInQueue)
+            return;
+        tile->type = SurfaceTile::tileInQueue;
+        tiles.push_back(tile);
+    }
+    cvQueue.notify_one();
 }
 
 void SurfaceHandler::unqueue(SurfaceManager *mgr)
 {
     if (mgr == nullptr)
         return;
-    if (tiles.empty())
-        return;
-}
\ No newline at end of file
+
+    std::unique_lock<std::mutex> lock(muQueue);
+    std::erase_if(tiles, [mgr](SurfaceTile *tile) { return &tile->mgr == mgr; });
+
+    // Wait for tile in progress
+    std::unique_lock<std::mutex> load(muLoading);
+}
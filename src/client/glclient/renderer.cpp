@@ -24,11 +24,37 @@ struct fbSaveParam
 std::vector<fbSaveParam> lastFBParams;
 
 #ifdef DEBUG
-void checkError(cchar_t *str)
+void glRenderer::checkError(cchar_t *str)
 {
     GLenum err;
     while ((err = glGetError()) != GL_NO_ERROR)
-        glogger->debug("OGL Error: {} - {}\n", str, err);
+        glLogger->debug("OGL Error: {} - {}\n", str, err);
+}
+
+static void GLAD_API_PTR glDebugOutput(GLenum source, GLenum type, GLuint id,
+    GLenum severity, GLsizei length, const GLchar *message, const void *userParam)
+{
+    if (type == GL_DEBUG_TYPE_ERROR)
+        glLogger->error(Logger::catGraphics, "OGL Error {}: {}\n", id, message);
+    else
+        glLogger->debug(Logger::catGraphics, "OGL Debug {}: {}\n", id, message);
+}
+
+// Report OpenGL errors through KHR_debug callback
+// instead of polling glGetError after each call.
+void glRenderer::initDebugOutput()
+{
+    if (!GLAD_GL_KHR_debug && !GLAD_GL_VERSION_4_3)
+    {
+        glLogger->info("KHR_debug not supported - no OpenGL debug output\n");
+        return;
+    }
+
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(glDebugOutput, nullptr);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION,
+        0, nullptr, GL_FALSE);
 }
 #endif
 
@@ -95,4 +121,67 @@ void glRenderer::pushFlag(int flag, bool val)
 
 void glRenderer::popFlag()
 {
-}
\ No newline at end of file
+}
+
+// ******** GPU section timers ********
+
+glTimer::~glTimer()
+{
+    for (auto &queries : frames)
+        for (auto &query : queries)
+            pool.push_back(query.id);
+    if (!pool.empty())
+        glDeleteQueries(pool.size(), pool.data());
+}
+
+// Collect results from oldest frame in ring
+void glTimer::beginFrame()
+{
+    frameIndex = (frameIndex + 1) % GLTIMER_FRAMES;
+    std::vector<Query> &queries = frames[frameIndex];
+    if (queries.empty())
+        return;
+
+    // Drop whole frame if GPU is still behind rather than stall
+    GLint available = 0;
+    glGetQueryObjectiv(queries.back().id, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available && ofsProfiler != nullptr)
+    {
+        for (auto &query : queries)
+        {
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &elapsed);
+            ofsProfiler->addGPUTime(query.sec, elapsed / 1.0e6);
+        }
+    }
+
+    for (auto &query : queries)
+        pool.push_back(query.id);
+    queries.clear();
+}
+
+bool glTimer::begin(ProfileSection sec)
+{
+    if (bActive)
+        return false;
+
+    GLuint id;
+    if (pool.empty())
+        glGenQueries(1, &id);
+    else
+    {
+        id = pool.back();
+        pool.pop_back();
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED, id);
+    frames[frameIndex].push_back({ id, sec });
+    bActive = true;
+    return true;
+}
+
+void glTimer::end()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    bActive = false;
+}
@@ -6,16 +6,21 @@
 #pragma once
 
 //#include "glad/gl.h"
+#include "main/profiler.h"
 
 class glTexture;
 
+#define GLTIMER_FRAMES      4   // Frames in flight before query results are read
+
 class glRenderer
 {
 public:
 #ifdef DEBUG
     void checkError(cchar_t *str);
+    static void initDebugOutput();
 #else
     inline void checkError(cchar_t *str) {}
+    static inline void initDebugOutput() {}
 #endif
     static void sync();
 
@@ -24,4 +29,52 @@ public:
 
     static void pushFlag(int flag, bool val);
     static void popFlag();
+};
+
+// GPU section timers using GL_TIME_ELAPSED query ring
+//
+// Results are read back GLTIMER_FRAMES frames later so that the
+// CPU never waits on the GPU. Elapsed time queries cannot nest,
+// so inner sections are skipped while an outer one is active.
+class glTimer
+{
+public:
+    glTimer() = default;
+    ~glTimer();
+
+    void beginFrame();
+    bool begin(ProfileSection sec);
+    void end();
+
+private:
+    struct Query
+    {
+        GLuint id;
+        ProfileSection sec;
+    };
+
+    std::vector<Query> frames[GLTIMER_FRAMES];
+    std::vector<GLuint> pool;
+    int frameIndex = 0;
+    bool bActive = false;
+};
+
+class glTimerScope
+{
+public:
+    glTimerScope(glTimer &timer, ProfileSection sec)
+    : timer(timer)
+    {
+        bStarted = timer.begin(sec);
+    }
+
+    ~glTimerScope()
+    {
+        if (bStarted)
+            timer.end();
+    }
+
+private:
+    glTimer &timer;
+    bool bStarted;
 };
\ No newline at end of file
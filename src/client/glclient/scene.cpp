@@ -23,11 +23,13 @@ Scene::Scene(int width, int height)
 
 void Scene::checkErrors()
 {
+#ifdef DEBUG
     GLenum err;
     while((err = glGetError()) != GL_NO_ERROR)
     {
         glLogger->debug("OpenGL Error: {}\n", err);
     }
+#endif
 }
 
 void Scene::init(Universe *uv)
@@ -35,9 +37,12 @@ void Scene::init(Universe *uv)
     universe = uv;
 
     vobjList.clear();
+    vobjMap.clear();
 
     initConstellations();
     initStarRenderer();
+    initObjectPoints();
+    vmeshmgr.init(shmgr);
 }
 
 void Scene::start()
@@ -116,7 +121,8 @@ void Scene::update(Player *player)
     now = player->getTimeDate()->getSimTime0();
 
     visibleStars.clear();
-    renderList.clear();
+    renderQueue.clear();
+    pointList.clear();
     lightSources.clear();
     secondaryLights.clear();
 
@@ -131,16 +137,24 @@ void Scene::update(Player *player)
 
 void Scene::render(Player *player)
 {
+    FrameScope scope(prfScene);
+    gpuTimer.beginFrame();
+
     // update(player);
 
     // Clear all framebuffer
     glClearColor(0.0, 0.0, 0.0, 1.0);
     glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
 
+    // Load per-frame camera block
+    shmgr.beginFrame();
+    shmgr.setCameraParameters(camera->getViewMatrix(), camera->getProjMatrix());
+
     renderConstellations();
     renderStars(faintestMag, mjd);
 
     glm::dvec3 obs = observer->getPosition(); //  camera->getGlobalPosition();
+    setViewFrustum(camera->getProjViewMatrix());
 
     // for (auto sun : nearStars)
     // {
@@ -175,10 +189,13 @@ void Scene::render(Player *player)
         glm::dvec3 vpn = obs * glm::dvec3(0, 0, -1);
 
         buildSystems(sun->getSecondaries(), apos, vpn);
+        buildVehicles(psys, apos);
     }
 
     // Set light sources for planetshines
     setupSecondaryLightSources(lightSources, secondaryLights);
 
     renderSystemObjects();
+
+    shmgr.endFrame();
 }
\ No newline at end of file
@@ -8,8 +8,13 @@
 #include "main/core.h"
 #include "universe/universe.h"
 #include "engine/player.h"
+#include "engine/mesh.h"
 #include "shader.h"
 #include "lights.h"
+#include "vmesh.h"
+#include "renderer.h"
+
+#include <unordered_map>
 
 class Camera;
 class StarRenderer;
@@ -98,6 +103,37 @@ struct ObjectListEntry
     double mjd;         // MJD time/date
 };
 
+// Per-frame render queue
+//
+// Entries are kept across frames and reused, so building the
+// queue does not touch the heap once it reached working size.
+// Entries are drawn in sorted order - grouped by object type
+// (shader state), then front to back.
+class RenderQueue
+{
+public:
+    inline int size() const                     { return nEntries; }
+    inline bool empty() const                   { return nEntries == 0; }
+    inline ObjectListEntry &operator [] (int idx) { return entries[order[idx]]; }
+
+    inline void clear()                         { nEntries = 0; }
+
+    ObjectListEntry &alloc();
+    void sort();
+
+private:
+    std::vector<ObjectListEntry> entries;
+    std::vector<uint32_t> order;
+    int nEntries = 0;
+};
+
+struct objVertex
+{
+    glm::vec3   posObject;
+    color_t     color;
+    float       size;
+};
+
 class Scene
 {
 public:
@@ -105,13 +141,16 @@ public:
     ~Scene() = default;
 
     inline ShaderManager &getShaderManager()        { return shmgr; }
+    inline MeshManager &getMeshManager()            { return meshmgr; }
+    inline vMeshManager &getVisualMeshManager()     { return vmeshmgr; }
+    inline glTimer &getGPUTimer()                   { return gpuTimer; }
     inline Camera *getCamera() const                { return camera; }
     inline Player *getObserver() const              { return observer; }
 
     inline int getWidth() const                     { return width; }
     inline int getHeight() const                    { return height; }
 
-    inline void addRenderList(ObjectListEntry &ole) { renderList.push_back(ole); }
+    inline void addRenderList(const ObjectListEntry &ole) { renderQueue.alloc() = ole; }
 
     void init(Universe *universe);
     void start();
@@ -130,11 +169,13 @@ public:
 
 protected:
     void initStarRenderer();
+    void initObjectPoints();
     void initConstellations();
     void renderStars(double faintest, double mjd);
     void renderConstellations();
 
-    void renderObjectAsPoint(ObjectListEntry &ole);
+    void addObjectAsPoint(const glm::dvec3 &vpos, const color_t &color, double appMag);
+    void renderObjectPoints();
     void renderCelestialBody(ObjectListEntry &ole);
     void renderOrbitPath(ObjectListEntry &ole);
 
@@ -153,6 +194,10 @@ protected:
     //     const glm::dvec3 &vpnorm, const glm::dvec3 &origin);
     void buildSystems(secondaries_t &bodies, const glm::dvec3 &obs,
         const glm::dvec3 &vpnorm);
+    void buildVehicles(pSystem *psys, const glm::dvec3 &obs);
+
+    void setViewFrustum(const glm::dmat4 &projView);
+    bool isVisible(const glm::dvec3 &vpos, double radius) const;
 
     void renderSystemObjects();
 
@@ -177,6 +222,9 @@ private:
     double mjd = 0;
 
     ShaderManager shmgr;
+    MeshManager meshmgr;
+    vMeshManager vmeshmgr;
+    glTimer gpuTimer;
 
     Universe *universe = nullptr;
     Player *observer = nullptr;
@@ -201,5 +249,16 @@ private:
     std::vector<LightSource> lightSources;
     std::vector<SecondaryLight> secondaryLights;
 
-    std::vector<ObjectListEntry> renderList;
+    std::unordered_map<const Object *, vObject *> vobjMap;
+
+    // Render queue and sub-pixel objects (point sprites)
+    RenderQueue renderQueue;
+    std::vector<objVertex> pointList;
+    VertexArray *vaoPoints = nullptr;
+    VertexBuffer *vboPoints = nullptr;
+    size_t szPoints = 0;
+    mat4Uniform uPointMVP;
+    vec2Uniform uPointClip;
+
+    glm::dvec4 frustum[4];      // side planes (camera-relative)
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "main/core.h"
 #include "client.h"
 #include "shader.h"
+#include "buffer.h"
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -299,48 +300,6 @@ ShaderStatus ShaderProgram::link()
     return shrSuccessful;
 }
 
-void ShaderProgram::initLightParameters()
-{
-    ambient = vec3Uniform(id, "uAmbient");
-    nLights = intUniform(id, "unLights");
-
-    for (int idx = 0; idx < MAX_LIGHTS; idx++)
-    {
-        lights[idx].spos = vec3Uniform(id, strLightProperty(idx, "spos"));
-        lights[idx].diffuse = vec3Uniform(id, strLightProperty(idx, "diffuse"));
-        lights[idx].specular = vec3Uniform(id, strLightProperty(idx, "specular"));
-
-    }
-
-    //     GLuint blkLights;
-    //     GLuint bindingPoint = 1;
-
-    //     blkLights = glGetUniformBlockIndex(id, "Lights");
-    //     glUniformBlockBinding(id, blkLights, bindingPoint);
-    //     fmt::printf("Block index = %d\n", blkLights);
-
-}
-
-void ShaderProgram::setLightParameters(const LightState &ls)
-{
-    assert (ls.nLights < MAX_LIGHTS);
-    int idx;
-
-    // glLogger->debug("Set {} lights\n", ls.nLights);
-    nLights = ls.nLights;
-    ambient = ls.ambientColor;
-    for (idx = 0; idx < ls.nLights; idx++)
-    {
-        lights[idx].spos = ls.lights[idx].spos;
-        lights[idx].diffuse = ls.lights[idx].color.vec3() * ls.lights[idx].irradiance;
-        lights[idx].specular = { 0, 0, 0 };
-
-        // glLogger->debug("{}: Color ({}, {}, {}) Irradiance {}\n", idx, ls.lights[idx].color.getRed(),
-        //     ls.lights[idx].color.getGreen(), ls.lights[idx].color.getBlue(),
-        //     ls.lights[idx].irradiance);
-    }
-}
-
 void ShaderProgram::listUniforms()
 {
     GLint uCount;
@@ -374,6 +333,60 @@ ShaderManager::ShaderManager(cstr_t &folder)
 : shaderFolder(folder)
 {
     programs.clear();
+    ubo = new UniformBuffer(UBO_FRAMESIZE);
+}
+
+ShaderManager::~ShaderManager()
+{
+    if (ubo != nullptr)
+        delete ubo;
+}
+
+void ShaderManager::beginFrame()
+{
+    ubo->beginFrame();
+}
+
+void ShaderManager::endFrame()
+{
+    ubo->endFrame();
+}
+
+void ShaderManager::setCameraParameters(const glm::dmat4 &view, const glm::dmat4 &proj)
+{
+    glCameraBlock block;
+
+    block.mView = glm::mat4(view);
+    block.mProj = glm::mat4(proj);
+    block.mViewProj = glm::mat4(proj * view);
+    ubo->update(UBO_CAMERA, block);
+}
+
+void ShaderManager::setObjectParameters(const glm::dmat4 &model, const glm::dmat4 &world, const glm::vec2 &clip)
+{
+    glObjectBlock block;
+
+    block.mModel = glm::mat4(model);
+    block.mWorld = glm::mat4(world);
+    block.clip = clip;
+    block.pad = glm::vec2(0);
+    ubo->update(UBO_OBJECT, block);
+}
+
+void ShaderManager::setLightParameters(const LightState &ls)
+{
+    assert (ls.nLights < MAX_LIGHTS);
+    glLightBlock block = {};
+
+    block.ambient = glm::vec4(ls.ambientColor, 0);
+    block.nLights = ls.nLights;
+    for (int idx = 0; idx < ls.nLights; idx++)
+    {
+        block.lights[idx].spos = glm::vec4(ls.lights[idx].spos, 0);
+        block.lights[idx].diffuse = glm::vec4(ls.lights[idx].color.vec3() * float(ls.lights[idx].irradiance), 0);
+        block.lights[idx].specular = glm::vec4(0);
+    }
+    ubo->update(UBO_LIGHTS, block);
 }
 
 ShaderProgram *ShaderManager::createShader(cstr_t &name, const ShaderPackage list[], int size)
@@ -8,6 +8,43 @@
 #include "lights.h"
 
 class ShaderManager;
+class UniformBuffer;
+
+// Uniform block binding points (see shaders/lib/blocks.glsl)
+#define UBO_CAMERA      0       // per-frame camera parameters
+#define UBO_OBJECT      1       // per-object transform
+#define UBO_LIGHTS      2       // per-object light sources
+
+#define UBO_FRAMESIZE   (1 << 20)   // uniform buffer size per frame
+
+// std140 uniform blocks - must match shaders/lib/blocks.glsl
+struct glCameraBlock
+{
+    glm::mat4 mView;
+    glm::mat4 mProj;
+    glm::mat4 mViewProj;
+};
+
+struct glObjectBlock
+{
+    glm::mat4 mModel;
+    glm::mat4 mWorld;
+    glm::vec2 clip;
+    glm::vec2 pad;
+};
+
+struct glLightBlock
+{
+    glm::vec4 ambient;
+    int32_t   nLights;
+    int32_t   pad[3];
+    struct
+    {
+        glm::vec4 spos;
+        glm::vec4 diffuse;
+        glm::vec4 specular;
+    } lights[MAX_LIGHTS];
+};
 
 enum ShaderType
 {
@@ -60,12 +97,17 @@ public:
     bool isValid() const { return slot != -1; }
 
 protected:
+    // Uniform setters do not query glGetError - it stalls
+    // the pipeline. Debug builds report errors through
+    // KHR_debug callback instead (see glRenderer).
     void checkError()
     {
+#ifdef DEBUG
         int err;
 
         if ((err = glGetError()) != GL_NO_ERROR)
             glLogger->debug("{}: OpenGL Error: {}\n", uName, err);
+#endif
     }
 
 protected:
@@ -84,7 +126,7 @@ public:
     boolUniform &operator = (bool val)
     {
         if (slot != -1)
-            glUniform1i(slot, val), checkError();
+            glUniform1i(slot, val);
         return *this;
     }
 };
@@ -100,7 +142,7 @@ public:
     intUniform &operator = (int val)
     {
         if (slot != -1)
-            glUniform1i(slot, val), checkError();
+            glUniform1i(slot, val);
         return *this;
     }
 };
@@ -116,7 +158,7 @@ public:
     floatUniform &operator = (float val)
     {
         if (slot != -1)
-            glUniform1f(slot, val), checkError();
+            glUniform1f(slot, val);
         return *this;
     }
 };
@@ -132,7 +174,7 @@ public:
     vec2Uniform &operator = (const glm::vec2 &val)
     {
         if (slot != -1)
-            glUniform2fv(slot, 1, glm::value_ptr(val)), checkError();
+            glUniform2fv(slot, 1, glm::value_ptr(val));
         return *this;
     }
 };
@@ -148,7 +190,7 @@ public:
     vec3Uniform &operator = (const glm::vec3 &val)
     {
         if (slot != -1)
-            glUniform3fv(slot, 1, glm::value_ptr(val)), checkError();
+            glUniform3fv(slot, 1, glm::value_ptr(val));
         return *this;
     }
 };
@@ -164,7 +206,7 @@ public:
     vec4Uniform &operator = (const glm::vec4 &val)
     {
         if (slot != -1)
-            glUniform4fv(slot, 1, glm::value_ptr(val)), checkError();
+            glUniform4fv(slot, 1, glm::value_ptr(val));
         return *this;
     }
 };
@@ -180,7 +222,7 @@ public:
     mat3Uniform &operator = (const glm::mat3 &val)
     {
         if (slot != -1)
-            glUniformMatrix3fv(slot, 1, GL_FALSE, glm::value_ptr(val)), checkError();
+            glUniformMatrix3fv(slot, 1, GL_FALSE, glm::value_ptr(val));
         return *this;
     }
 };
@@ -196,7 +238,7 @@ public:
     mat4Uniform &operator = (const glm::mat4 &val)
     {
         if (slot != -1)
-            glUniformMatrix4fv(slot, 1, GL_FALSE, glm::value_ptr(val)), checkError();
+            glUniformMatrix4fv(slot, 1, GL_FALSE, glm::value_ptr(val));
         return *this;
     }
 };
@@ -269,32 +311,12 @@ public:
     inline void use() const           { glUseProgram(id); }
     inline void release() const       { glUseProgram(0); }
 
-    void initLightParameters();
-    void setLightParameters(const LightState &ls);
-    // color_t materialDiffuse, color_t materialSpecular, color_t materialEmissive);
-
     void listUniforms();
     
-protected:
-    str_t strLightProperty(int idx, cstr_t &name)
-    {
-        return std::format("lights[{}].{}", idx, name);
-    }
-
 private:
     str_t pgmName;
     GLuint id = 0;
 
-    struct
-    {    
-        vec3Uniform spos;
-        vec3Uniform diffuse;
-        vec3Uniform specular;
-    } lights[MAX_LIGHTS];
-
-    vec3Uniform ambient;
-    intUniform  nLights;
-
     // std::vector<ShaderSource &> shaders;
 };
 
@@ -305,12 +327,21 @@ class ShaderManager
 
 public:
     ShaderManager(cstr_t &folder);
-    ~ShaderManager() = default;
+    ~ShaderManager();
 
     ShaderProgram *createShader(cstr_t &name, const ShaderPackage list[], int size);
 
+    // Uniform block updates
+    void beginFrame();
+    void endFrame();
+    void setCameraParameters(const glm::dmat4 &view, const glm::dmat4 &proj);
+    void setObjectParameters(const glm::dmat4 &model, const glm::dmat4 &world, const glm::vec2 &clip);
+    void setLightParameters(const LightState &ls);
+
 private:
     cstr_t shaderFolder;
 
+    UniformBuffer *ubo = nullptr;
+
     std::vector<ShaderProgram *> programs;
 };
\ No newline at end of file
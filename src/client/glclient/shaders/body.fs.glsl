@@ -2,26 +2,12 @@
 
 #include "logdepth.glsl"
 #include "atmo.glsl"
+#include "blocks.glsl"
 
-#define MAX_NLIGHTS 10
-
-struct lightSource
-{
-    vec3 spos;  // sun position
-    vec3 diffuse;
-    vec3 specular;
-
-    // float attenuation[4];
-};
-
-uniform vec3  uAmbient;
-uniform int   unLights;
-uniform lightSource lights[MAX_NLIGHTS];
-
-uniform vec2  uCamClip;
 // uniform float uCameraK;
 
 layout (binding = 0) uniform sampler2D sTile;
+layout (binding = 2) uniform sampler2DArray sTiles;
 
 // layout (std140) uniform Lights {
 //     lightSource light[MAX_NLIGHTS];
@@ -31,6 +17,7 @@ layout (binding = 0) uniform sampler2D sTile;
 in vec3 normal;
 in vec3 fragPos;
 in vec2 texCoord;
+flat in int texLayer;
 
 out vec4 fragColor;
 
@@ -182,14 +169,14 @@ void addLight(in lightSource light, in vec3 normal, in vec3 fragPos, in vec3 vie
     in float specPower, inout vec3 diffuse, inout vec3 specular)
 {
     float diff, spec;
-    vec3 lightDir = normalize(light.spos - fragPos);
+    vec3 lightDir = normalize(light.spos.xyz - fragPos);
     vec3 reflectDir = reflect(-lightDir, normal);
 
     diff = clamp(dot(normal, lightDir), 0.0, 1.0);
     spec = pow(clamp(dot(viewDir, -reflectDir), 0.0, 1.0), specPower);
 
-    diffuse += light.diffuse * diff;
-    specular += light.diffuse * spec;
+    diffuse += light.diffuse.rgb * diff;
+    specular += light.diffuse.rgb * spec;
 }
 
 void main()
@@ -197,9 +184,13 @@ void main()
     float uCameraK = 1.0;
 
 
-    fragColor = texture(sTile, texCoord);
+    // Pooled tile textures (shared terrain grid)
+    if (texLayer >= 0)
+        fragColor = texture(sTiles, vec3(texCoord, texLayer));
+    else
+        fragColor = texture(sTile, texCoord);
 
-    vec3 diff = uAmbient;
+    vec3 diff = uAmbient.rgb;
     vec3 spec = vec3(0.0);
     vec3 norm = normalize(-normal);
     vec3 vdir = normalize(-fragPos);
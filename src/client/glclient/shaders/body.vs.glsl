@@ -8,9 +8,30 @@
 layout (location = 0) in vec3 vPosition;
 layout (location = 1) in vec3 vNormal;
 layout (location = 2) in vec2 vTexCoord;
+layout (location = 3) in uint vInstance;
 
-uniform mat4 uModel;
-uniform mat4 uWorld;
+#include "blocks.glsl"
+
+// Shared terrain grid parameters
+uniform bool uTerrain;
+uniform vec2 uElevParams;   // body radius, elevation scale
+
+struct TileInstance
+{
+    mat4  mWorld;           // projection * RTC model/view matrix
+    mat4  mModel;           // RTC model matrix
+    vec4  center;           // sin/cos of center latitude, sin/cos of center longitude
+    vec4  span;             // latitude/longitude span, center latitude/longitude
+    vec4  texRange;         // tumin, tumax, tvmin, tvmax
+    ivec4 layers;           // elevation layer (-1 = none), texture layer (-1 = none)
+};
+
+layout (std430, binding = 0) readonly buffer TileInstances
+{
+    TileInstance tiles[];
+};
+
+layout (binding = 1) uniform isampler2DArray sElev;
 
 // uniform vec3 uCamEyeHigh;
 // uniform vec3 uCamEyeLow;
@@ -19,9 +40,93 @@ uniform mat4 uWorld;
 out vec3 normal;
 out vec3 fragPos;
 out vec2 texCoord;
+flat out int texLayer;
+
+float getElevation(int x, int y, int layer)
+{
+    return float(texelFetch(sElev, ivec3(x+1, y+1, layer), 0).r);
+}
+
+mat3 yRotate(float a)
+{
+    float s = sin(a), c = cos(a);
+    return mat3(c, 0.0, s, 0.0, 1.0, 0.0, -s, 0.0, c);
+}
+
+mat3 zRotate(float a)
+{
+    float s = sin(a), c = cos(a);
+    return mat3(c, -s, 0.0, s, c, 0.0, 0.0, 0.0, 1.0);
+}
+
+// Place grid vertex on sphere patch relative to tile center.
+// Latitude/longitude are expanded around tile center with
+// cos(d)-1 = -2sin^2(d/2) so that small differences stay
+// precise in single float.
+void terrainVertex(in TileInstance tile, out vec3 pos, out vec3 nml, out vec2 tc)
+{
+    const float pi = 3.14159265358979;
+
+    int x = int(vPosition.x), y = int(vPosition.y);
+    int layer = tile.layers.x;
+    float dlat = tile.span.x * (vTexCoord.y - 0.5);
+    float dlng = tile.span.y * (vTexCoord.x - 0.5);
+
+    float slatc = tile.center.x, clatc = tile.center.y;
+    float slngc = tile.center.z, clngc = tile.center.w;
+
+    float sdlat = sin(dlat), cdlat = sin(dlat * 0.5);
+    float sdlng = sin(dlng), cdlng = sin(dlng * 0.5);
+    cdlat = -2.0 * cdlat * cdlat;
+    cdlng = -2.0 * cdlng * cdlng;
+
+    float dclat = clatc*cdlat - slatc*sdlat;
+    float dslat = slatc*cdlat + clatc*sdlat;
+    float dclng = clngc*cdlng - slngc*sdlng;
+    float dslng = slngc*cdlng + clngc*sdlng;
+
+    float clat = clatc + dclat, slat = slatc + dslat;
+    float clng = clngc + dclng, slng = slngc + dslng;
+
+    vec3 n  = vec3(clat*clng, slat, clat*-slng);
+    vec3 dn = vec3(clatc*dclng + dclat*clngc + dclat*dclng, dslat,
+                 -(clatc*dslng + dclat*slngc + dclat*dslng));
+
+    float elev = 0.0;
+    nml = n;
+    if (layer >= 0)
+    {
+        float escale = uElevParams.y;
+        elev = getElevation(x, y, layer) * escale / 1000.0;
+
+        vec3 lnml = vec3(2.0,
+            escale * (getElevation(x, y+1, layer) - getElevation(x, y-1, layer)),
+            escale * (getElevation(x+1, y, layer) - getElevation(x-1, y, layer)));
+        nml = yRotate(-(tile.span.w + dlng) - pi) * zRotate(tile.span.z + dlat) *
+            normalize(-lnml);
+    }
+
+    pos = dn * uElevParams.x + n * elev;
+    tc  = vec2(mix(tile.texRange.x, tile.texRange.y, vTexCoord.x),
+               tile.texRange.w - (tile.texRange.w - tile.texRange.z) * vTexCoord.y);
+}
 
 void main()
 {
+    if (uTerrain)
+    {
+        TileInstance tile = tiles[vInstance];
+        vec3 pos, nml;
+        terrainVertex(tile, pos, nml, texCoord);
+
+        gl_Position = tile.mWorld * vec4(pos, 1.0);
+        normal = mat3(transpose(inverse(tile.mModel))) * nml;
+        fragPos = vec3(tile.mModel * vec4(pos, 1.0));
+        texLayer = tile.layers.y;
+        return;
+    }
+    texLayer = -1;
+
     // vec3 t1 = vPositionl - uCamEyeLow;
     // vec3 e = t1 - vPositionl;
     // vec3 t2 = ((-uCamEyeLow - e) + (vPositionl - (t1 - e))) +
@@ -0,0 +1,22 @@
+#version 430
+
+#include "logdepth.glsl"
+#include "blocks.glsl"
+
+in vec4 color;
+out vec4 fragColor;
+
+void main()
+{
+    float uCameraK = 1.0;
+
+    // Round sprite with soft edge
+    vec2 circCoord = (gl_PointCoord * 2.0) - 1.0;
+    float r2 = dot(circCoord, circCoord);
+    if (r2 > 1.0)
+        discard;
+
+    fragColor = vec4(color.rgb * (1.0 - 0.5 * r2), color.a);
+
+    gl_FragDepth = getDepth(uCamClip.y, uCameraK);
+}
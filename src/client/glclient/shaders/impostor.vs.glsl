@@ -0,0 +1,26 @@
+#version 430
+
+#include "blocks.glsl"
+
+// Must match ImpostorInstance in vmesh.h
+struct ImpostorInstance
+{
+    vec4 pos;       // w = size [pixels]
+    vec4 color;
+};
+
+layout (std430, binding = 0) readonly buffer Impostors
+{
+    ImpostorInstance impostors[];
+};
+
+out vec4 color;
+
+void main()
+{
+    ImpostorInstance inst = impostors[gl_VertexID];
+
+    gl_Position = uViewProj * vec4(inst.pos.xyz, 1.0);
+    gl_PointSize = max(inst.pos.w, 1.0);
+    color = inst.color;
+}
@@ -0,0 +1,36 @@
+// blocks.glsl - Uniform blocks shared by shader programs
+//
+// Must match std140 structures in shader.h
+
+#define MAX_NLIGHTS 10
+
+struct lightSource
+{
+    vec4 spos;      // sun position
+    vec4 diffuse;
+    vec4 specular;
+};
+
+// Per-frame camera parameters
+layout (std140, binding = 0) uniform CameraBlock
+{
+    mat4 uView;
+    mat4 uProj;
+    mat4 uViewProj;
+};
+
+// Per-object transform
+layout (std140, binding = 1) uniform ObjectBlock
+{
+    mat4 uModel;
+    mat4 uWorld;
+    vec2 uCamClip;
+};
+
+// Per-object light sources
+layout (std140, binding = 2) uniform LightBlock
+{
+    vec4 uAmbient;
+    int  unLights;
+    lightSource lights[MAX_NLIGHTS];
+};
@@ -1,6 +1,7 @@
 #version 430
 
 #include "logdepth.glsl"
+#include "blocks.glsl"
 
 // layout (binding = 0) uniform sampler2D sTile;
 
@@ -8,7 +9,6 @@ uniform vec4 uColor;
 uniform vec3 uCentralDir;
 uniform float uRadius;
 
-uniform vec2  uCamClip;
 // uniform float uCameraK;
 
 in vec3 fPosition;
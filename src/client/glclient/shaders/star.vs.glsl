@@ -9,9 +9,9 @@ layout (location = 0) in vec3 vPosition;
 layout (location = 1) in vec3 vNormal;
 layout (location = 2) in vec2 vTexCoord;
 
-uniform mat4 uViewProj;
+#include "blocks.glsl"
+
 // uniform mat4 uView;
-uniform mat4 uModel;
 uniform mat4 urte;
 
 uniform vec3 uCamEyeHigh;
@@ -0,0 +1,35 @@
+#version 430
+
+#include "logdepth.glsl"
+#include "blocks.glsl"
+
+layout (binding = 0) uniform sampler2D sTexture;
+
+uniform vec4 uDiffuse;
+uniform bool uTextured;
+
+in vec3 normal;
+in vec3 fragPos;
+in vec2 texCoord;
+
+out vec4 fragColor;
+
+void main()
+{
+    float uCameraK = 1.0;
+
+    fragColor = uDiffuse;
+    if (uTextured)
+        fragColor *= texture(sTexture, texCoord);
+
+    vec3 diff = uAmbient.rgb;
+    vec3 norm = normalize(normal);
+    for (int idx = 0; idx < unLights; idx++)
+    {
+        vec3 lightDir = normalize(lights[idx].spos.xyz - fragPos);
+        diff += lights[idx].diffuse.rgb * clamp(dot(norm, lightDir), 0.0, 1.0);
+    }
+    fragColor.rgb *= diff;
+
+    gl_FragDepth = getDepth(uCamClip.y, uCameraK);
+}
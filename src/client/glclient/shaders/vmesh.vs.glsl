@@ -0,0 +1,36 @@
+#version 430
+
+layout (location = 0) in vec3 vPosition;
+layout (location = 1) in vec3 vNormal;
+layout (location = 2) in vec3 vTangent;
+layout (location = 3) in vec2 vTexCoord;
+layout (location = 4) in uint vInstance;
+
+#include "blocks.glsl"
+
+// Must match MeshInstance in vmesh.h
+struct MeshInstance
+{
+    mat4 mWorld;
+    mat4 mModel;
+    vec4 anim;
+};
+
+layout (std430, binding = 0) readonly buffer MeshInstances
+{
+    MeshInstance meshes[];
+};
+
+out vec3 normal;
+out vec3 fragPos;
+out vec2 texCoord;
+
+void main()
+{
+    MeshInstance inst = meshes[vInstance];
+
+    gl_Position = inst.mWorld * vec4(vPosition, 1.0);
+    normal = mat3(inst.mModel) * vNormal;
+    fragPos = vec3(inst.mModel * vec4(vPosition, 1.0));
+    texCoord = vTexCoord;
+}
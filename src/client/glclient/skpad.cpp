@@ -95,6 +95,9 @@ glPad::glPad(Texture *tex, bool antialiased)
 
 glPad::~glPad()
 {
+    for (auto &[id, img] : images)
+        nvgDeleteImage(ctx, img.image);
+    images.clear();
 }
 
 void glPad::ginit()
@@ -315,6 +318,48 @@ void glPad::drawPolygonLine(const glm::dvec2 *vtx, int nvtx)
     endStrokeFromPen();
 }
 
+// Wrap render surface as NanoVG image. Texture is still owned
+// by texture manager, so image must not delete it.
+int glPad::getImage(glTexture *tx)
+{
+    int w = tx->getWidth();
+    int h = tx->getHeight();
+
+    auto it = images.find(tx->getID());
+    if (it != images.end())
+    {
+        if (it->second.width == w && it->second.height == h)
+            return it->second.image;
+        // Texture ID was recycled for another surface
+        nvgDeleteImage(ctx, it->second.image);
+        images.erase(it);
+    }
+
+    // Surfaces are drawn through Y-flipped contexts, so they
+    // are already stored top-down as NanoVG expects.
+    int image = nvglCreateImageFromHandleGL3(ctx, tx->getID(), w, h, NVG_IMAGE_NODELETE);
+    if (image != 0)
+        images[tx->getID()] = { image, w, h };
+    return image;
+}
+
+void glPad::drawSurface(Texture *surf, int x, int y)
+{
+    glTexture *tx = dynamic_cast<glTexture *>(surf);
+    if (tx == nullptr || tx == txPad)
+        return;
+    int image = getImage(tx);
+    if (image == 0)
+        return;
+
+    int w = tx->getWidth();
+    int h = tx->getHeight();
+    NVGpaint paint = nvgImagePattern(ctx, xOrigin+x, yOrigin+y, w, h, 0.0f, image, 1.0f);
+    nvgBeginPath(ctx);
+    nvgRect(ctx, xOrigin+x, yOrigin+y, w, h);
+    nvgFillPaint(ctx, paint);
+    nvgFill(ctx);
+}
 
 NVGalign glPad::toNVGTextAlign(TAHorizontal tah)
 {
@@ -89,6 +89,7 @@ public:
     void drawEllipse(int cx, int cy, int x1, int y1) override;
     void drawPolygon(const glm::dvec2 *vtx, int nvtx) override;
     void drawPolygonLine(const glm::dvec2 *vtx, int nvtx) override;
+    void drawSurface(Texture *surf, int x, int y) override;
 
     int getCharSize() override;
     int getTextWidth(cchar_t *str, int len = 0) override;
@@ -103,9 +104,18 @@ protected:
     NVGalign toNVGTextAlign(TAHorizontal tah);
     NVGalign toNVGTextAlign(TAVertical tav);
 
+    int getImage(glTexture *tx);
+
 private:
     NVGcontext *ctx = nullptr;
     glTexture *txPad = nullptr;
+
+    struct nvgImage
+    {
+        int image;
+        int width, height;
+    };
+    std::map<GLuint, nvgImage> images;  // NanoVG images by texture ID
     int width;
     int height;
 
@@ -244,6 +244,9 @@ void Scene::initStarRenderer()
 
 void Scene::renderStars(double faintest, double mjd)
 {
+    FrameScope scope(prfStars);
+    glTimerScope gpuScope(gpuTimer, prfStars);
+
     glm::dvec3 obs = observer->getPosition(); //  camera->getGlobalPosition();
     glm::dmat3 rot = observer->getRotation(); //  camera->getGlobalRotation();
     double fov = camera->getFOV();
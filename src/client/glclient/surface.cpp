@@ -18,6 +18,53 @@
 
 #include <unordered_map>
 
+// ******** Trigonometric Lattice ********
+
+// Grid rows and columns of all tiles at same LOD are spaced by
+// same angle - pi / (nlat*grid) for both latitude and longitude.
+// Sine/cosine of multiples of that step are cached once per
+// LOD/grid for all bodies. Tiles rotate them to own origin by
+// angle addition instead of calling sin/cos per vertex.
+struct TrigLattice
+{
+    std::vector<double> sinv;   // sin(k*step), k = 0..grid
+    std::vector<double> cosv;   // cos(k*step), k = 0..grid
+
+    // Sine/cosine of (ang0 + k*step) for k = 0..grid
+    void rotate(double ang0, double *sang, double *cang) const
+    {
+        double s0 = sin(ang0), c0 = cos(ang0);
+        for (int k = 0; k < sinv.size(); k++)
+        {
+            sang[k] = s0*cosv[k] + c0*sinv[k];
+            cang[k] = c0*cosv[k] - s0*sinv[k];
+        }
+    }
+};
+
+// Shared by loader thread and render thread
+static const TrigLattice &getTrigLattice(int lod, int grid)
+{
+    static std::mutex muLattice;
+    static std::map<std::pair<int, int>, std::unique_ptr<TrigLattice>> lattices;
+
+    std::lock_guard<std::mutex> lock(muLattice);
+    auto &lattice = lattices[{ lod, grid }];
+    if (lattice == nullptr)
+    {
+        double step = pi / (double(1 << lod) * grid);
+        lattice = std::make_unique<TrigLattice>();
+        lattice->sinv.resize(grid+1);
+        lattice->cosv.resize(grid+1);
+        for (int k = 0; k <= grid; k++)
+        {
+            lattice->sinv[k] = sin(k * step);
+            lattice->cosv[k] = cos(k * step);
+        }
+    }
+    return *lattice;
+}
+
 // ******** Surface Tile ********
 
 static tcRange range = { 0, 1, 0, 1 };
@@ -32,8 +79,15 @@ SurfaceTile::SurfaceTile(SurfaceManager &mgr, int lod, int ilat, int ilng, Surfa
 
 SurfaceTile::~SurfaceTile()
 {
+    mgr.memUsed -= memSize;
+    if (ddsImage != nullptr)
+        delete [] ddsImage;
     if (mesh != nullptr)
         delete mesh;
+    if (elevLayer >= 0)
+        mgr.terrain->release(elevLayer);
+    if (txOwn == true && txLayer >= 0)
+        mgr.terrain->releaseTexture(txLayer);
     if (txOwn == true && txImage != nullptr)
         delete txImage;
     if (txOwn == true && spImage != nullptr)
@@ -51,14 +105,42 @@ SurfaceTile *SurfaceTile::createChild(int idx)
     int nlng = ilng*2 + (idx % 2);
 
     child = new SurfaceTile(mgr, nlod, nlat, nlng, this);
-    // if (child != nullptr)
-    //     mgr.loader->queue(child);
-    child->load();
     addChild(idx, child);
+    mgr.loader->queue(child);
 
     return child;
 }
 
+// Mark this tile and its active descendants as inactive
+// but keep them loaded for reuse.
+void SurfaceTile::setInactive()
+{
+    if ((type & TILE_ACTIVE) == 0)
+        return;
+    type = tileInactive;
+    for (int idx = 0; idx < QTREE_NODES; idx++)
+    {
+        SurfaceTile *child = getChild(idx);
+        if (child != nullptr)
+            child->setInactive();
+    }
+}
+
+// Check if any tile in this subtree is still waiting
+// for or in progress of loading.
+bool SurfaceTile::isBusy() const
+{
+    if (type == tileInQueue || type == tileLoading)
+        return true;
+    for (int idx = 0; idx < QTREE_NODES; idx++)
+    {
+        SurfaceTile *child = getChild(idx);
+        if (child != nullptr && child->isBusy())
+            return true;
+    }
+    return false;
+}
+
 void SurfaceTile::setCenter(glm::dvec3 &cnml, glm::dvec3 &wpos)
 {
     int nlat = 1 << lod;
@@ -103,34 +185,23 @@ void SurfaceTile::setSubregionRange(const tcRange &range)
     }
 }
 
+// Load tile data and build mesh. Called from loader thread
+// for all tiles except root tiles - no OpenGL calls here.
 void SurfaceTile::load()
 {
     type = tileLoading;
-    uint32_t szImage;
-
-    uint8_t *ddsImage = nullptr;
 
     if (mgr.zTrees[0] != nullptr)
     {
         // Loading terrain texture from database
         szImage = mgr.zTrees[0]->read(lod+4, ilat, ilng, &ddsImage);
-        if (szImage > 0 && ddsImage != nullptr)
-            txImage = mgr.tmgr.loadDDSTextureFromMemory(ddsImage, szImage, 0);
-        // if (txImage != nullptr)
-        //     logger->info("Loaded texture (ID {}: ({}, {}))\n",
-        //         txImage->id, txImage->txWidth, txImage->txHeight);
-        delete ddsImage;
-
-        if (txImage != nullptr)
-            txOwn = true;
-        else {
+        if (szImage == 0 || ddsImage == nullptr)
+        {
             // Non-existent tile. Get lower LOD tile from
             // ancestor and set subregion range of that.
             SurfaceTile *pTile = dynamic_cast<SurfaceTile *>(getParent());
             if (pTile != nullptr)
             {
-                txImage = pTile->getTexture();
-                txOwn = false;
                 setSubregionRange(pTile->txRange);
 
                 // Get parent tile with last own texture image.
@@ -158,14 +229,105 @@ void SurfaceTile::load()
     //     }
     // }
 
+    createMesh();
+    type = tileLoaded;
+}
+
+void SurfaceTile::createMesh()
+{
     // Load elevation data
     int16_t *elev = elevEnable ? getElevationData() : nullptr;
 
+    if (mesh != nullptr)
+        delete mesh, mesh = nullptr;
+
+    // Patch tiles are displaced by vertex shader with
+    // shared terrain grid - nothing to build here.
+    gridMesh = (mgr.terrain != nullptr && lod > 0);
+    if (gridMesh)
+        return;
+
     if (lod == 0)
         mesh = createHemisphere(mgr.elevGrids, elev, mgr.elevScale);
     else
         mesh = mgr.createSpherePatch(mgr.elevGrids, lod, ilat, ilng,
             (lod >= 4), center, txRange, elev, mgr.elevScale, 0.0);
+}
+
+// Upload loaded tile data to GPU. Must be called from render thread.
+void SurfaceTile::upload()
+{
+    if (mgr.zTrees[0] != nullptr)
+    {
+        bool bFailed = false;
+
+        if (ddsImage != nullptr)
+        {
+            txImage = mgr.tmgr.loadDDSTextureFromMemory(ddsImage, szImage, 0);
+            // if (txImage != nullptr)
+            //     logger->info("Loaded texture (ID {}: ({}, {}))\n",
+            //         txImage->id, txImage->txWidth, txImage->txHeight);
+            delete [] ddsImage;
+            ddsImage = nullptr;
+            txOwn = (txImage != nullptr);
+            bFailed = !txOwn;
+            if (bFailed)
+                szImage = 0;
+        }
+
+        if (!txOwn)
+        {
+            SurfaceTile *pTile = getParent();
+            if (pTile != nullptr)
+            {
+                txImage = pTile->getTexture();
+                txLayer = pTile->txLayer;
+                if (bFailed)
+                {
+                    // Bad texture data - rebuild mesh for subregion.
+                    setSubregionRange(pTile->txRange);
+                    parentTile = pTile->txOwn ? pTile : pTile->parentTile;
+                    createMesh();
+                }
+            }
+        }
+    }
+
+    memSize = szImage;
+    if (gridMesh)
+    {
+        // Upload elevation samples into terrain layer.
+        int16_t *elev = elevEnable ? ggelev : nullptr;
+        if (elev != nullptr && elevLayer < 0)
+        {
+            elevLayer = mgr.terrain->allocate();
+            if (elevLayer < 0)
+            {
+                // No free layers - build mesh on CPU instead.
+                gridMesh = false;
+                mesh = mgr.createSpherePatch(mgr.elevGrids, lod, ilat, ilng,
+                    (lod >= 4), center, txRange, elev, mgr.elevScale, 0.0);
+            }
+        }
+        if (elevLayer >= 0)
+        {
+            mgr.terrain->upload(elevLayer, elev);
+            memSize += mgr.terrain->getLayerSize();
+        }
+    }
+
+    // Copy own texture into terrain texture pool. Keep own
+    // texture - descendants that run out of elevation layers
+    // are built on CPU and bind it instead of pool layer.
+    if (gridMesh && txOwn)
+        txLayer = mgr.terrain->addTexture(txImage);
+
+    if (mesh != nullptr)
+    {
+        mesh->upload();
+        memSize += mesh->nvtx * sizeof(Vertex) + mesh->nidx * sizeof(uint16_t);
+    }
+    mgr.memUsed += memSize;
     type = tileInactive;
 }
 
@@ -183,6 +345,11 @@ void SurfaceTile::load()
 
 void SurfaceTile::render()
 {
+    if (gridMesh)
+    {
+        addGridInstance();
+        return;
+    }
     if (mesh == nullptr)
         return;
     if (mesh->vao == nullptr)
@@ -208,12 +375,12 @@ void SurfaceTile::render()
 
     // mgr.uViewProj = glm::mat4(mgr.prm.dmViewProj);
 
-    // Load per-tile model matrix into GLSL space
+    // Load per-tile model matrix into object block
     // mgr.uModel = glm::mat4(mgr.prm.dmWorld);
-    mgr.uModel = glm::mat4(mgr.prm.dmWorld);
     // mgr.uView = glm::mat4(mgr.prm.dmView);
     // mgr.uWorld = glm::mat4(mgr.prm.dmProj * mgr.prm.dmRTE);
-    mgr.uWorld = glm::mat4(mgr.prm.dmProj * mgr.prm.dmWorldt);
+    mgr.scene.getShaderManager().setObjectParameters(mgr.prm.dmWorld,
+        mgr.prm.dmProj * mgr.prm.dmWorldt, mgr.prm.clip);
     // mgr.uRTE = mgr.prm.dmViewProj * mgr.prm.dmRTE;
     // mgr.uRTE = mgr.prm.dmRTE * mgr.prm.dmView * mgr.prm.dmProj;
     // mgr.uRTE = mgr.prm.dmProj * mgr.prm.dmView * mgr.prm.dmRTE;
@@ -223,8 +390,6 @@ void SurfaceTile::render()
     // mgr.uCamEyeHigh = high;
     // mgr.uCamEyeLow = low;
 
-    mgr.uCamClip = mgr.prm.clip;
-
     // if (mgr.bPolygonLines)
     //     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
     glDrawElements(GL_TRIANGLES, mesh->ibo->getCount(), GL_UNSIGNED_SHORT, 0);
@@ -241,6 +406,34 @@ void SurfaceTile::render()
     mgr.pgm->release();
 }
 
+// Queue patch tile for batched terrain rendering. Vertex
+// shader places grid vertices with per-tile parameters below.
+void SurfaceTile::addGridInstance()
+{
+    if ((type & TILE_VALID) == 0)
+        return;
+
+    int nlat = 1 << lod;
+    int nlng = 2 << lod;
+    double latc = (pi/2.0) - pi * ((double(ilat)+0.5) / double(nlat));
+    double lngc = (pi*2.0) * ((double(ilng)+0.5) / double(nlng)) + pi;
+
+    // Grid vertices are relative to tile center
+    // at all LOD levels. See getWorldMatrix().
+    glm::dmat4 dmModel = mgr.prm.dmWorld;
+    dmModel[3] = mgr.prm.dmWorld * glm::dvec4(center, 1.0);
+
+    TileInstance inst;
+    inst.mWorld = glm::mat4(mgr.prm.dmProj * mgr.prm.dmWorldt);
+    inst.mModel = glm::mat4(dmModel);
+    inst.center = glm::vec4(sin(latc), cos(latc), sin(lngc), cos(lngc));
+    inst.span = glm::vec4(pi / nlat, (pi*2.0) / nlng, latc, lngc);
+    inst.texRange = glm::vec4(txRange.tumin, txRange.tumax, txRange.tvmin, txRange.tvmax);
+    inst.layers = glm::ivec4(elevLayer, txLayer, 0, 0);
+
+    mgr.terrain->addTile(inst, txLayer < 0 ? txImage : nullptr);
+}
+
 void SurfaceTile::renderNormals()
 {
     if (mesh == nullptr)
@@ -259,7 +452,7 @@ void SurfaceTile::renderNormals()
     mgr.pgmNormals->release();
 }
 
-Mesh *SurfaceTile::createHemisphere(int grid, int16_t *elev, double gelev)
+SurfaceMesh *SurfaceTile::createHemisphere(int grid, int16_t *elev, double gelev)
 {
     double erad, rad = mgr.objSize + gelev;
     double slat, clat, slng, clng;
@@ -270,25 +463,24 @@ Mesh *SurfaceTile::createHemisphere(int grid, int16_t *elev, double gelev)
     Vertex *vtx = new Vertex[nvtx];
     int cvtx = 0;
 
-    double dang = pi / grid;
-    double lng, lat = 0;
     double du = 0.5 / 512;
     double a = (1.0 - 2.0 * du) / double(grid);
     int x1 = grid;
     int x2 = x1+1;
 
+    // Colatitude/longitude steps are pi/grid (LOD 0 lattice).
+    // Western hemisphere is shifted by pi (negated sin/cos).
+    const TrigLattice &trig = getTrigLattice(0, grid);
+    double lsign = (ilng != 0) ? 1.0 : -1.0;
+
     for (int y = 1; y < grid; y++)
     {
-        lat += dang;
-        slat = sin(lat), clat = cos(lat);
-        tv = lat / pi;
+        slat = trig.sinv[y], clat = trig.cosv[y];
+        tv = double(y) / double(grid);
 
         for (int x = 0; x < x2; x++)
         {
-            lng = x*dang - pi;
-            if (ilng != 0)
-                lng += pi;
-            slng = sin(lng), clng = cos(lng);
+            slng = lsign * trig.sinv[x], clng = lsign * trig.cosv[x];
             erad = rad + gelev;
             if (elev != nullptr)
                 erad += double(elev[(grid+1 - y) * ELEV_STRIDE + x+1]);
@@ -463,7 +655,7 @@ Mesh *SurfaceTile::createHemisphere(int grid, int16_t *elev, double gelev)
     }
 
  
-    return new Mesh(cvtx, vtx, cidx, idx);
+    return new SurfaceMesh(cvtx, vtx, cidx, idx);
 }
 
 // ******** Surface Manager ********
@@ -517,10 +709,7 @@ SurfaceManager::SurfaceManager(const Object *object, Scene &scene)
 
         pgm->use();
 
-        uViewProj = mat4Uniform(pgm->getID(), "uViewProj");
         // uView = mat4Uniform(pgm->getID(), "uView");
-        uModel = mat4Uniform(pgm->getID(), "uModel");
-        uCamClip = vec2Uniform(pgm->getID(), "uCamClip");
 
         uRadius = floatUniform(pgm->getID(), "uRadius");
         uColor = vec4Uniform(pgm->getID(), "uColor");
@@ -540,7 +729,7 @@ SurfaceManager::SurfaceManager(const Object *object, Scene &scene)
 
         // uint16_t cidx[6] = { 0, 1, 2, 2, 3, 0 };
 
-        // meshCorona = new Mesh(4, cvtx, 6, cidx);
+        // meshCorona = new SurfaceMesh(4, cvtx, 6, cidx);
     
         pgmCorona->release();
 
@@ -548,6 +737,7 @@ SurfaceManager::SurfaceManager(const Object *object, Scene &scene)
         {
             tiles[idx] = new SurfaceTile(*this, 0, 0, idx);
             tiles[idx]->load();
+            tiles[idx]->upload();
         }
         // meshStar = createIcosphere(4);
         break;
@@ -561,18 +751,24 @@ SurfaceManager::SurfaceManager(const Object *object, Scene &scene)
 
         pgm->use();
 
-        pgm->initLightParameters();
+        // Transform, camera clip and lights are
+        // in uniform blocks - see ShaderManager.
         // uViewProj = mat4Uniform(pgm->getID(), "uViewProj");
         // uView = mat4Uniform(pgm->getID(), "uView");
-        uModel = mat4Uniform(pgm->getID(), "uModel");
-        uWorld = mat4Uniform(pgm->getID(), "uWorld");
 
         // uCamEyeHigh = vec3Uniform(pgm->getID(), "uCamEyeHigh");
         // uCamEyeLow = vec3Uniform(pgm->getID(), "uCamEyeLow");
-        uCamClip = vec2Uniform(pgm->getID(), "uCamClip");
+
+        uTerrain = boolUniform(pgm->getID(), "uTerrain");
+        uElevParams = vec2Uniform(pgm->getID(), "uElevParams");
+        uTerrain = false;
 
         pgm->release();
 
+        // Use shared terrain grid if shader supports it.
+        if (uTerrain.isValid())
+            terrain = new TerrainGrid(elevGrids, TILE_ELEVLAYERS, TILE_TEXLAYERS);
+
         pgmNormals->use();
 
         unColor = vec4Uniform(pgmNormals->getID(), "uColor");
@@ -604,6 +800,7 @@ SurfaceManager::SurfaceManager(const Object *object, Scene &scene)
         {
             tiles[idx] = new SurfaceTile(*this, 0, 0, idx);
             tiles[idx]->load();
+            tiles[idx]->upload();
         }
         break;
     }
@@ -611,7 +808,13 @@ SurfaceManager::SurfaceManager(const Object *object, Scene &scene)
 
 SurfaceManager::~SurfaceManager()
 {
-    delete tiles[0],tiles[1];
+    // Remove pending tiles from loader queue first
+    if (loader != nullptr)
+        loader->unqueue(this);
+    delete tiles[0];
+    delete tiles[1];
+    if (terrain != nullptr)
+        delete terrain;
 }
 
 void SurfaceManager::ginit()
@@ -669,7 +872,8 @@ glm::dmat4 SurfaceManager::getWorldMatrix(const SurfaceTile *tile)
     glm::dmat4 dmWorld = prm.dmView * prm.dmWorld;
 
     // Return with RTW method as default.
-    if (tile->lod < 4)
+    // Shared grid tiles are always relative to center.
+    if (tile->lod < 4 && !tile->gridMesh)
         return dmWorld;
 
     // Set RTC world matrix with tile center.
@@ -744,8 +948,10 @@ void SurfaceManager::process(SurfaceTile *tile)
     int nlng = 2 << tile->lod;
 
     bool bStepdown = true;
+    bool bRefined = (tile->type == SurfaceTile::tileActive);
 
     tile->type = SurfaceTile::tileRendering;
+    tile->frameUsed = frameCount;
     
     static const double trad0 = sqrt(3.0)*(pi/2.0);
     double trad  = trad0 / double(nlat);
@@ -787,6 +993,10 @@ void SurfaceManager::process(SurfaceTile *tile)
             //         ofs::degrees(adist), ofs::degrees(prm.viewap));
             // }
 
+            // Keep children loaded for reuse
+            for (int idx = 0; idx < QTREE_NODES; idx++)
+                if (tile->getChild(idx) != nullptr)
+                    tile->getChild(idx)->setInactive();
             tile->type = SurfaceTile::tileInvisible;
             return;
         }
@@ -808,7 +1018,12 @@ void SurfaceManager::process(SurfaceTile *tile)
         }
         double apr = tdist * scene.getCamera()->getAperature(); // * resScale;
 
-        int tres = apr < 1e-6 ? prm.maxlod : std::max(0, std::min(prm.maxlod, int(bias - log(apr) * scale)));
+        // Already refined tiles keep their children until resolution
+        // drops by hysteresis margin to avoid LOD flickering.
+        double lres = bias - log(apr) * scale;
+        if (bRefined)
+            lres += TILE_HYSTERESIS;
+        int tres = apr < 1e-6 ? prm.maxlod : std::max(0, std::min(prm.maxlod, int(lres)));
         // logger->debug("lod = {}, tres = {}\n", tile->lod, tres);
         bStepdown = (tile->lod < tres);
     }
@@ -817,13 +1032,17 @@ void SurfaceManager::process(SurfaceTile *tile)
     {
         bool valid = true;
 
+        // Request children from loader and keep rendering this
+        // tile until all four children are loaded and uploaded.
         for (int idx = 0; idx < QTREE_NODES; idx++)
         {
             SurfaceTile *child = tile->getChild(idx);
             if (child == nullptr)
                 child = tile->createChild(idx);
             else if (child->type == SurfaceTile::tileInvalid)
-                child->load();
+                loader->queue(child);
+            else if (child->type == SurfaceTile::tileLoaded && nUploads > 0)
+                child->upload(), nUploads--;
             if ((child->type & TILE_VALID) == 0)
                 valid = false;
         }
@@ -859,9 +1078,60 @@ void SurfaceManager::process(SurfaceTile *tile)
     // prm.dmWorldt = tile->mgr.getWorldMatrix(tile->ilat, nlat, tile->ilng, nlng);
     // prm.dmWorld = tile->mgr.getWorldMatrix2(tile);
 
-    // Release all old tiles.
-    if (bStepdown == false)
-        tile->deleteChildren();
+    // Retire children - they stay loaded until
+    // evicted by memory budget.
+    for (int idx = 0; idx < QTREE_NODES; idx++)
+        if (tile->getChild(idx) != nullptr)
+            tile->getChild(idx)->setInactive();
+}
+
+// Release least recently used retired subtrees
+// while tile memory is over budget.
+void SurfaceManager::evictTiles()
+{
+    // Terrain grid layers count against budget too.
+    auto overBudget = [this]() {
+        return memUsed > memBudget || (terrain != nullptr &&
+            terrain->getFreeLayers() < TILE_MAXUPLOADS);
+    };
+
+    if (!overBudget())
+        return;
+
+    // Collect tiles with retired children
+    std::vector<std::pair<uint64_t, SurfaceTile *>> retired;
+    std::vector<SurfaceTile *> stack = { tiles[0], tiles[1] };
+    while (!stack.empty())
+    {
+        SurfaceTile *tile = stack.back();
+        stack.pop_back();
+
+        uint64_t lastUsed = 0;
+        bool hasChildren = false;
+        for (int idx = 0; idx < QTREE_NODES; idx++)
+        {
+            SurfaceTile *child = tile->getChild(idx);
+            if (child == nullptr)
+                continue;
+            hasChildren = true;
+            lastUsed = std::max(lastUsed, child->frameUsed);
+            if (tile->type == SurfaceTile::tileActive)
+                stack.push_back(child);
+        }
+        if (hasChildren && tile->type != SurfaceTile::tileActive)
+            retired.push_back({ lastUsed, tile });
+    }
+
+    std::sort(retired.begin(), retired.end(),
+        [](auto &a, auto &b) { return a.first < b.first; });
+
+    for (auto &[lastUsed, tile] : retired)
+    {
+        if (!overBudget())
+            break;
+        if (!tile->isBusy())
+            tile->deleteChildren();
+    }
 }
 
 void SurfaceManager::render(SurfaceTile *tile)
@@ -887,18 +1157,37 @@ void SurfaceManager::render(SurfaceTile *tile)
 
 void SurfaceManager::renderBody(const ObjectListEntry &ole)
 {
+    FrameScope scope(prfSurface);
+    glTimerScope gpuScope(scene.getGPUTimer(), prfSurface);
+
     setRenderParams(ole);
 
+    frameCount++;
+    nUploads = TILE_MAXUPLOADS;
     for (int idx = 0; idx < 2; idx++)
         process(tiles[idx]);
+    evictTiles();
 
-    pgm->use();
     // Set light source parameters
-    pgm->setLightParameters(ole.lights);
-    pgm->release();
+    scene.getShaderManager().setLightParameters(ole.lights);
 
+    if (terrain != nullptr)
+        terrain->begin();
     for (int idx = 0; idx < 2; idx++)
         render(tiles[idx]);
+
+    // Draw all queued grid tiles at once.
+    if (terrain != nullptr)
+    {
+        pgm->use();
+        uTerrain = true;
+        uElevParams = glm::vec2(objSize, elevScale);
+        scene.getShaderManager().setObjectParameters(prm.dmWorld,
+            prm.dmProj * prm.dmView * prm.dmWorld, prm.clip);
+        terrain->render();
+        uTerrain = false;
+        pgm->release();
+    }
     // pgm->release();
 }
 
@@ -911,12 +1200,11 @@ void SurfaceManager::renderStar(const ObjectListEntry &ole)
     // Updating time for solar granules aninmation
     dTime += 0.0002;
 
-    uViewProj = glm::mat4(prm.dmViewProj);
-    uModel = glm::mat4(prm.dmWorld);
+    // Model matrix and camera clip are loaded into
+    // object block by each tile - see SurfaceTile::render().
     uRadius = objSize;
     uColor = ole.color.vec4();
     uCentralDir = prm.cdir;
-    uCamClip = ole.camClip;
     uTime = dTime;
 
     // glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -933,7 +1221,7 @@ void SurfaceManager::renderStar(const ObjectListEntry &ole)
     pgm->release();
 }
 
-Mesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng, 
+SurfaceMesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng, 
     bool rtcEnable, const glm::dvec3 &center, const tcRange &range,
     int16_t *elev, double escale, double gelev)
 {
@@ -948,10 +1236,15 @@ Mesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng,
     glm::dvec3 pos, nml;
     double radius = objSize;
 
-    double slat, clat, slng, clng;
-    double lat, lng;
     double erad;
 
+    // Row/column sine and cosine from shared lattice
+    const TrigLattice &trig = getTrigLattice(lod, grid);
+    std::vector<double> slat(grid+1), clat(grid+1);
+    std::vector<double> slng(grid+1), clng(grid+1);
+    trig.rotate(mlat0, slat.data(), clat.data());
+    trig.rotate(mlng0, slng.data(), clng.data());
+
     // Initialize vertices
     int nvtx  = (grid+1)*(grid+1);
     int nvtxe = nvtx + grid+1 + grid+1;
@@ -972,20 +1265,16 @@ Mesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng,
 
     for (int y = 0; y <= grid; y++)
     {
-        lat = mlat0 + (mlat1-mlat0) * double(y)/double(grid);       
-        slat = sin(lat), clat = cos(lat);
         tv = range.tvmax - tvr * float(y)/float(grid);
 
         for (int x = 0; x <= grid; x++)
         {
-            lng = mlng0 + (mlng1-mlng0) * double(x)/double(grid);
-            slng = sin(lng), clng = cos(lng);
             tu = range.tumin + tur * float(x)/float(grid);
             erad = radius + gelev;
 
             if (elev != nullptr)
                 erad += (double(elev[(y+1)*ELEV_STRIDE + (x+1)]) * escale) / 1000.0;
-            nml = glm::dvec3(clat*clng, slat, clat*-slng);
+            nml = glm::dvec3(clat[y]*clng[x], slat[y], clat[y]*-slng[x]);
             pos = nml * erad;
 
             // Subtract vertices with tile center
@@ -1091,21 +1380,21 @@ Mesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng,
 
     if (elev != nullptr)
     {
-        double dy, dz, dydz;
-        glm::dmat3 lhrot;
+        glm::dmat3 latrot, lngrot;
         int en;
 
-        dy = radius * pi/(nlat*grid);
         for (int y = 0, n = 0; y <= grid; y++)
         {
-            lat = mlat0 + (mlat1-mlat0) * double(y)/double(grid);       
-            slat = sin(lat), clat = cos(lat);
-            dz = radius * pi2*clat / (nlng*grid);
-            dydz = dy*dz;
+            // zRotate(lat)
+            latrot = glm::dmat3({ clat[y], -slat[y], 0 },
+                                { slat[y],  clat[y], 0 },
+                                { 0,        0,       1 });
             for (int x = 0; x <= grid; x++)
             {
-                lng = mlng0 + (mlng1-mlng0) * double(x)/double(grid);
-                slng = sin(lng+pi/2), clng = cos(lng+pi/2);
+                // yRotate(-lng-pi)
+                lngrot = glm::dmat3({ -clng[x], 0,  slng[x] },
+                                    {  0,       1,  0       },
+                                    { -slng[x], 0, -clng[x] });
                 en = (y+1)*ELEV_STRIDE + (x+1);
 
                 // nml = { escale*(elev[en+1]-elev[en-1]),
@@ -1116,7 +1405,7 @@ Mesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng,
                         escale*(elev[en+ELEV_STRIDE]-elev[en-ELEV_STRIDE]),
                         escale*(elev[en+1]-elev[en-1])};
                 nml = glm::normalize(-nml);
-                nml = ofs::yRotate(-lng-pi) * ofs::zRotate(lat) * nml;
+                nml = lngrot * latrot * nml;
 
                 vtx[n].nx = nml.x;
                 vtx[n].ny = nml.y;
@@ -1131,7 +1420,7 @@ Mesh *SurfaceManager::createSpherePatch(int grid, int lod, int ilat, int ilng,
     for (int idx = 0; idx <= grid; idx++)
         vtx[cvtx++] = vtx[idx + ((ilat & 1) ? 0 : (grid+1)*grid)];
 
-    return new Mesh(nvtx, vtx, nidx, idx);
+    return new SurfaceMesh(nvtx, vtx, nidx, idx);
 }
 
 // Icosphere mesh creation
@@ -1206,7 +1495,7 @@ public:
     }
 };
 
-Mesh *SurfaceManager::createIcosphere(int maxlod)
+SurfaceMesh *SurfaceManager::createIcosphere(int maxlod)
 {
     std::vector<uint32_t>   indices;
     std::vector<glm::dvec3> vertices;
@@ -1328,7 +1617,7 @@ Mesh *SurfaceManager::createIcosphere(int maxlod)
 
     glLogger->debug("Done - Creating mesh...\n");
 
-    return new Mesh(nvtx, vtx, nidx, idx);
+    return new SurfaceMesh(nvtx, vtx, nidx, idx);
     
     // logger->debug("All done.\n");
 }
@@ -1494,9 +1783,289 @@ Mesh *SurfaceManager::createIcosphere(int maxlod)
 //     }
 // }
 
-// ******** Mesh ********
+// ******** Terrain Grid ********
+
+// Shared grid with (grid+1)^2 vertices. Vertex position holds
+// integer grid coordinates and texture coordinates hold grid
+// fraction for vertex shader. Triangle diagonals are fixed
+// because the grid is shared by all tiles.
+SurfaceMesh *SurfaceManager::createTerrainGrid(int grid)
+{
+    int nvtx = (grid+1)*(grid+1);
+    Vertex *vtx = new Vertex[nvtx];
+    int cvtx = 0;
+
+    for (int y = 0; y <= grid; y++)
+    {
+        for (int x = 0; x <= grid; x++)
+        {
+            vtx[cvtx].vx = float(x);
+            vtx[cvtx].vy = float(y);
+            vtx[cvtx].vz = 0.0f;
+            vtx[cvtx].nx = 0.0f;
+            vtx[cvtx].ny = 0.0f;
+            vtx[cvtx].nz = 0.0f;
+            vtx[cvtx].tu = float(x) / float(grid);
+            vtx[cvtx].tv = float(y) / float(grid);
+            cvtx++;
+        }
+    }
+
+    int nidx = 2 * grid*grid * 3;
+    uint16_t *idx = new uint16_t[nidx];
+    int cidx = 0;
+
+    for (int y = 0, nofs0 = 0; y < grid; y++)
+    {
+        int nofs1 = nofs0+grid+1;
+        for (int x = 0; x < grid; x++)
+        {
+            idx[cidx++] = nofs0+x;
+            idx[cidx++] = nofs1+x;
+            idx[cidx++] = nofs0+x+1;
+            idx[cidx++] = nofs1+x+1;
+            idx[cidx++] = nofs0+x+1;
+            idx[cidx++] = nofs1+x;
+        }
+        nofs0 = nofs1;
+    }
+
+    return new SurfaceMesh(nvtx, vtx, nidx, idx);
+}
+
+TerrainGrid::TerrainGrid(int grid, int nLayers, int nTexLayers)
+: grid(grid), nLayers(nLayers), nTexLayers(nTexLayers)
+{
+    mesh = SurfaceManager::createTerrainGrid(grid);
+    mesh->upload();
+
+    glGenBuffers(1, &idBuffer);
+    glGenBuffers(1, &ssbo);
+    glGenBuffers(1, &dibo);
+    resize(256);
+
+    // Elevation samples with one-sample border
+    // for normal calculation.
+    glGenTextures(1, &txElev);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, txElev);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_R16I, grid+3, grid+3, nLayers);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    checkErrors();
+
+    freeLayers.reserve(nLayers);
+    for (int layer = nLayers-1; layer >= 0; layer--)
+        freeLayers.push_back(layer);
+    freeTexLayers.reserve(nTexLayers);
+    for (int layer = nTexLayers-1; layer >= 0; layer--)
+        freeTexLayers.push_back(layer);
+}
+
+TerrainGrid::~TerrainGrid()
+{
+    if (txElev != 0)
+        glDeleteTextures(1, &txElev);
+    if (txTiles != 0)
+        glDeleteTextures(1, &txTiles);
+    glDeleteBuffers(1, &idBuffer);
+    glDeleteBuffers(1, &ssbo);
+    glDeleteBuffers(1, &dibo);
+    if (mesh != nullptr)
+        delete mesh;
+}
+
+// Grow instance buffers. Instance index attribute
+// (location 3) steps once per instance so that
+// baseInstance of each draw command selects its tile.
+void TerrainGrid::resize(int nInstances)
+{
+    if (nInstances <= nCapacity)
+        return;
+    nCapacity = std::max(nInstances, nCapacity*2);
+
+    std::vector<uint32_t> ids(nCapacity);
+    for (int idx = 0; idx < nCapacity; idx++)
+        ids[idx] = idx;
+
+    mesh->vao->bind();
+    glBindBuffer(GL_ARRAY_BUFFER, idBuffer);
+    glBufferData(GL_ARRAY_BUFFER, nCapacity * sizeof(uint32_t), ids.data(), GL_STATIC_DRAW);
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void *)0);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+    mesh->vao->unbind();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, nCapacity * sizeof(TileInstance), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, dibo);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, nCapacity * sizeof(DrawElementsCommand), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    checkErrors();
+}
+
+int TerrainGrid::allocate()
+{
+    if (freeLayers.empty())
+        return -1;
+    int layer = freeLayers.back();
+    freeLayers.pop_back();
+    return layer;
+}
+
+void TerrainGrid::release(int layer)
+{
+    freeLayers.push_back(layer);
+}
+
+// Upload (grid+3)^2 elevation block from ancestor
+// elevation data with ELEV_STRIDE row length.
+void TerrainGrid::upload(int layer, const int16_t *elev)
+{
+    glBindTexture(GL_TEXTURE_2D_ARRAY, txElev);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, ELEV_STRIDE);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, grid+3, grid+3, 1,
+        GL_RED_INTEGER, GL_SHORT, elev);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+// Copy tile texture into texture pool. Pool takes size,
+// format and mipmap levels from first texture. Returns
+// -1 if texture does not fit or pool is full.
+int TerrainGrid::addTexture(const glTexture *tx)
+{
+    if (tx == nullptr || freeTexLayers.empty())
+        return -1;
+
+    GLint w, h, fmt, levels = 1;
+    glBindTexture(GL_TEXTURE_2D, tx->getID());
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &w);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &h);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &fmt);
+    for (GLint lw = 1; (w >> levels) > 0 || (h >> levels) > 0; levels++)
+    {
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, levels, GL_TEXTURE_WIDTH, &lw);
+        if (lw == 0)
+            break;
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    if (txTiles == 0)
+    {
+        txWidth = w, txHeight = h;
+        txFormat = fmt, txLevels = levels;
+
+        glGenTextures(1, &txTiles);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, txTiles);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, txLevels, txFormat, txWidth, txHeight, nTexLayers);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+            txLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        checkErrors();
+    }
+    else if (w != txWidth || h != txHeight || fmt != txFormat || levels < txLevels)
+        return -1;
+
+    int layer = freeTexLayers.back();
+    freeTexLayers.pop_back();
+
+    for (int lv = 0; lv < txLevels; lv++)
+        glCopyImageSubData(tx->getID(), GL_TEXTURE_2D, lv, 0, 0, 0,
+            txTiles, GL_TEXTURE_2D_ARRAY, lv, 0, 0, layer,
+            std::max(txWidth >> lv, 1), std::max(txHeight >> lv, 1), 1);
+    checkErrors();
+
+    return layer;
+}
+
+void TerrainGrid::releaseTexture(int layer)
+{
+    freeTexLayers.push_back(layer);
+}
+
+void TerrainGrid::begin()
+{
+    instances.clear();
+    txSingles.clear();
+}
+
+void TerrainGrid::addTile(const TileInstance &tile, glTexture *tx)
+{
+    instances.push_back(tile);
+    txSingles.push_back(tx);
+}
+
+// Draw all queued tiles. State is set once - pooled tiles
+// go out with one multi-draw-indirect call, others are
+// drawn one by one with their own texture bound.
+void TerrainGrid::render()
+{
+    int nInstances = instances.size();
+    if (nInstances == 0)
+        return;
+    resize(nInstances);
+
+    cmds.clear();
+    uint32_t count = mesh->ibo->getCount();
+    for (int idx = 0; idx < nInstances; idx++)
+        if (txSingles[idx] == nullptr)
+            cmds.push_back({ count, 1, 0, 0, uint32_t(idx) });
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, nInstances * sizeof(TileInstance), instances.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssbo);
+
+    mesh->vao->bind();
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, txElev);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, txTiles);
+    glActiveTexture(GL_TEXTURE0);
+
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+
+    if (!cmds.empty())
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, dibo);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, cmds.size() * sizeof(DrawElementsCommand), cmds.data());
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, nullptr, cmds.size(), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    for (int idx = 0; idx < nInstances; idx++)
+    {
+        if (txSingles[idx] == nullptr)
+            continue;
+        txSingles[idx]->bind();
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, count, GL_UNSIGNED_SHORT,
+            nullptr, 1, idx);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glDisable(GL_CULL_FACE);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+    mesh->vao->unbind();
+}
+
+// ******** SurfaceMesh ********
 
-void Mesh::upload()
+void SurfaceMesh::upload()
 {
     if (vao == nullptr)
         vao = new VertexArray();
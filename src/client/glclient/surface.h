@@ -27,13 +27,13 @@ struct Vertex
     float tu, tv;           // Texture coordinates
 };
 
-struct Mesh
+struct SurfaceMesh
 {
-    Mesh(int nvtx, Vertex *vtx, int nidx, uint16_t *idx)
+    SurfaceMesh(int nvtx, Vertex *vtx, int nidx, uint16_t *idx)
     : nvtx(nvtx), vtx(vtx), nidx(nidx), idx(idx)
     { }
 
-    ~Mesh()
+    ~SurfaceMesh()
     {
         delete [] vtx;
         delete [] idx;
@@ -53,6 +53,87 @@ struct Mesh
     uint16_t   *idx;
 };
 
+// Per-tile parameters for shared terrain grid (std430 layout)
+struct TileInstance
+{
+    glm::mat4 mWorld;       // projection * RTC model/view matrix
+    glm::mat4 mModel;       // RTC model matrix
+    glm::vec4 center;       // sin/cos of center latitude/longitude
+    glm::vec4 span;         // latitude/longitude span, center latitude/longitude
+    glm::vec4 texRange;     // tumin, tumax, tvmin, tvmax
+    glm::ivec4 layers;      // elevation layer, texture layer
+};
+
+struct DrawElementsCommand
+{
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t  baseVertex;
+    uint32_t baseInstance;
+};
+
+// Shared terrain grid for GPU-displaced tiles
+//
+// All patch tiles of a body are drawn with one (grid+1)^2
+// vertex/index grid. Vertices carry grid coordinates only -
+// position is computed in vertex shader from per-tile
+// parameters and elevation samples held in R16 texture
+// array layers.
+//
+// Visible tiles are collected into a per-frame instance
+// buffer and drawn with one multi-draw-indirect call. Tile
+// textures are copied into a pooled texture array so that
+// no per-tile binding is needed. Tiles with textures that
+// do not fit the pool are drawn one by one.
+class TerrainGrid
+{
+public:
+    TerrainGrid(int grid, int nLayers, int nTexLayers);
+    ~TerrainGrid();
+
+    inline int getGrid() const      { return grid; }
+    inline SurfaceMesh *getMesh() const { return mesh; }
+    inline size_t getLayerSize() const  { return (grid+3)*(grid+3)*sizeof(int16_t); }
+    inline int getFreeLayers() const    { return freeLayers.size(); }
+
+    int allocate();
+    void release(int layer);
+    void upload(int layer, const int16_t *elev);
+
+    int addTexture(const glTexture *tx);
+    void releaseTexture(int layer);
+
+    void begin();
+    void addTile(const TileInstance &tile, glTexture *tx);
+    void render();
+
+private:
+    void resize(int nInstances);
+
+    int grid;
+    int nLayers;
+    int nTexLayers;
+
+    SurfaceMesh *mesh = nullptr;
+    GLuint txElev = 0;
+    GLuint txTiles = 0;         // texture pool (created on first texture)
+    GLint  txWidth = 0, txHeight = 0;
+    GLint  txFormat = 0, txLevels = 0;
+
+    GLuint idBuffer = 0;        // per-instance index (divisor 1)
+    GLuint ssbo = 0;            // tile instance buffer
+    GLuint dibo = 0;            // draw indirect buffer
+    int    nCapacity = 0;
+
+    std::vector<int> freeLayers;
+    std::vector<int> freeTexLayers;
+
+    std::vector<TileInstance> instances;
+    std::vector<glTexture *> txSingles;     // non-pooled texture per instance
+    std::vector<DrawElementsCommand> cmds;
+};
+
 struct tcRange
 {
     double tumin, tumax;
@@ -62,6 +143,12 @@ struct tcRange
 #define TILE_ACTIVE     64
 #define TILE_VALID      128
 
+#define TILE_HYSTERESIS 0.5             // LOD hysteresis for releasing children
+#define TILE_MAXUPLOADS 8               // Maximum texture uploads per frame
+#define TILE_MEMBUDGET  (128 << 20)     // Tile memory budget per body [bytes]
+#define TILE_ELEVLAYERS 2048            // Elevation texture layers per body
+#define TILE_TEXLAYERS  256             // Tile texture pool layers per body
+
 class Scene;
 class SurfaceHandler;
 class SurfaceManager;
@@ -78,6 +165,7 @@ public:
         tileInvalid   = 0,
         tileInQueue   = 1,
         tileLoading   = 2,
+        tileLoaded    = 7,  // loaded, waiting for upload
         tileInactive  = 3|TILE_VALID,
         tileActive    = 4|TILE_VALID|TILE_ACTIVE,
         tileInvisible = 5|TILE_VALID|TILE_ACTIVE,
@@ -99,11 +187,13 @@ public:
     void setSubregionRange(const tcRange &range);
 
     void load();
+    void upload();
     void render();
+    void addGridInstance();
     void renderNormals();
 
-    Mesh *createHemisphere(int grid, int16_t *elev, double gelev);
-    // Mesh *createSpherePatch(int grid, int lod, int ilat, int ilng, const tcRange &range,
+    SurfaceMesh *createHemisphere(int grid, int16_t *elev, double gelev);
+    // SurfaceMesh *createSpherePatch(int grid, int lod, int ilat, int ilng, const tcRange &range,
     //     int16_t *elev = nullptr, double selev = 1.0, double gelev = 0.0);
 
     void fixLongtitudeBoundary(SurfaceTile *nbr, bool keep = false);
@@ -119,11 +209,17 @@ public:
     int16_t *getElevationData();
 
 private:
+    void createMesh();
+    void setInactive();
+    bool isBusy() const;
+
     // void getTwoFloats(const glm::dvec3 &val, glm::fvec3 &high, glm::fvec3 &low);
 
     SurfaceManager &mgr;
 
-    tileType type = tileInvalid;
+    std::atomic<tileType> type = tileInvalid;
+    uint64_t frameUsed = 0;     // last frame processed
+    size_t   memSize = 0;       // texture/mesh memory size [bytes]
 
     int lod;
     int ilat, ilng;
@@ -133,10 +229,15 @@ private:
     glm::dvec3 wpos;
 
     SurfaceTile *parentTile = nullptr;
-    Mesh *mesh = nullptr;
+    SurfaceMesh *mesh = nullptr;
+    bool gridMesh = false;      // rendered with shared terrain grid
+    int  elevLayer = -1;        // elevation texture layer (grid mode)
+    int  txLayer = -1;          // texture pool layer (grid mode)
 
     // Surface data parameters
     bool txOwn = false;
+    uint8_t *ddsImage = nullptr;    // texture data waiting for upload
+    uint32_t szImage = 0;
     glTexture *txImage = nullptr;
     glTexture *spImage = nullptr;
     tcRange txRange;
@@ -163,20 +264,19 @@ public:
     void shutdown();
 
     void queue(SurfaceTile *tile);
-    bool unqueue(SurfaceTile *tile);
     void unqueue(SurfaceManager *mgr);
 
 protected:
     void handle();
 
 private:
-    std::queue<SurfaceTile *> tiles;
+    std::deque<SurfaceTile *> tiles;
 
-    volatile bool runHandler;
-    int           msFreq;
+    std::atomic<bool> runHandler = false;
     std::thread   loader;
     std::mutex    muQueue;
     std::mutex    muLoading;
+    std::condition_variable cvQueue;
 };
 
 class SurfaceManager
@@ -204,18 +304,22 @@ public:
     //     elevTileList_t *elevTiles, glm::dvec3 *nml, int *lod) const;
 
     // Creating planet surface - quadsphere
-    Mesh *createHemisphere(int grid, int16_t *elev, double gelev);
-    Mesh *createSpherePatch(int grid, int lod, int ilat, int ilng, 
+    SurfaceMesh *createHemisphere(int grid, int16_t *elev, double gelev);
+    SurfaceMesh *createSpherePatch(int grid, int lod, int ilat, int ilng, 
         bool rtcEnable, const glm::dvec3 &center, const tcRange &range,
         int16_t *elev = nullptr, double selev = 1.0, double gelev = 0.0);
 
+    // Creating shared terrain grid
+    static SurfaceMesh *createTerrainGrid(int grid);
+
     // Creating star surface - icosphere
-    Mesh *createIcosphere(int maxlod);
+    SurfaceMesh *createIcosphere(int maxlod);
 
     void setRenderParams(const ObjectListEntry &ole);
 
     void process(SurfaceTile *tile);
     void render(SurfaceTile *tile); 
+    void evictTiles();
 
     void renderBody(const ObjectListEntry &ole);
     void renderStar(const ObjectListEntry &ole);
@@ -254,13 +358,12 @@ private:
     ShaderProgram *pgmCorona = nullptr;
     ShaderProgram *pgmGlow = nullptr;
 
-    Mesh *meshStar = nullptr;
-    Mesh *meshCorona = nullptr;
-    Mesh *meshGlow = nullptr;
+    TerrainGrid *terrain = nullptr;     // GPU terrain mode if not null
+
+    SurfaceMesh *meshStar = nullptr;
+    SurfaceMesh *meshCorona = nullptr;
+    SurfaceMesh *meshGlow = nullptr;
 
-    mat4Uniform uViewProj;
-    mat4Uniform uModel;
-    mat4Uniform uWorld;
 
     // vec3Uniform uCamEyeHigh;
     // vec3Uniform uCamEyeLow;
@@ -269,7 +372,10 @@ private:
     floatUniform uRadius;
     vec4Uniform uColor;
     vec3Uniform uCentralDir;
-    vec2Uniform uCamClip;
+
+    // Uniforms for GPU terrain tiles
+    boolUniform  uTerrain;
+    vec2Uniform  uElevParams;
 
     // Uniforms for normals rendering
     vec4Uniform unColor;
@@ -285,6 +391,12 @@ private:
 
     bool showNormals = true;
 
+    // Tile streaming parameters
+    uint64_t frameCount = 0;
+    int      nUploads = 0;          // texture uploads left this frame
+    size_t   memUsed = 0;           // memory used by all tiles [bytes]
+    size_t   memBudget = TILE_MEMBUDGET;
+
     int elevGrids = 32; // 1 << 5
     double elevScale = 1.0;
     int  elevMode = 1;
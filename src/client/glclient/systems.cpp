@@ -6,15 +6,150 @@
 #include "main/core.h"
 #include "universe/universe.h"
 #include "universe/celbody.h"
+#include "universe/psystem.h"
+#include "engine/vehicle/vehicle.h"
 
 #include "client.h"
 #include "scene.h"
 #include "lights.h"
 #include "vobject.h"
 
-void Scene::renderObjectAsPoint(ObjectListEntry &ole)
+static ShaderPackage glslPoint[] = {
+    { "point.vs.glsl", true, shrVertexProcessor },
+    { "point.fs.glsl", true, shrFragmentProcessor }
+};
+
+// ******** Render queue ********
+
+ObjectListEntry &RenderQueue::alloc()
+{
+    if (nEntries == entries.size())
+        entries.emplace_back();
+    ObjectListEntry &ole = entries[nEntries++];
+    ole = ObjectListEntry();
+    return ole;
+}
+
+void RenderQueue::sort()
+{
+    order.resize(nEntries);
+    for (int idx = 0; idx < nEntries; idx++)
+        order[idx] = idx;
+
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+    {
+        const ObjectListEntry &ea = entries[a], &eb = entries[b];
+        ObjectType ta = ea.object->getType(), tb = eb.object->getType();
+        if (ta != tb)
+            return ta < tb;
+        return ea.vdist < eb.vdist;
+    });
+}
+
+// ******** Culling ********
+
+// Extract side planes from projection/view matrix. Near and far
+// planes are not tested - depth range is practically unlimited
+// with logarithmic depth buffer.
+void Scene::setViewFrustum(const glm::dmat4 &pv)
+{
+    glm::dvec4 row0 = { pv[0][0], pv[1][0], pv[2][0], pv[3][0] };
+    glm::dvec4 row1 = { pv[0][1], pv[1][1], pv[2][1], pv[3][1] };
+    glm::dvec4 row3 = { pv[0][3], pv[1][3], pv[2][3], pv[3][3] };
+
+    frustum[0] = row3 + row0;   // left
+    frustum[1] = row3 - row0;   // right
+    frustum[2] = row3 + row1;   // bottom
+    frustum[3] = row3 - row1;   // top
+    for (auto &plane : frustum)
+        plane /= glm::length(glm::dvec3(plane));
+}
+
+bool Scene::isVisible(const glm::dvec3 &vpos, double radius) const
+{
+    for (auto &plane : frustum)
+        if (glm::dot(glm::dvec3(plane), vpos) + plane.w < -radius)
+            return false;
+    return true;
+}
+
+// ******** Object points ********
+
+void Scene::initObjectPoints()
+{
+    pgmObjectAsPoint = shmgr.createShader("point", glslPoint, ARRAY_SIZE(glslPoint));
+    if (pgmObjectAsPoint == nullptr)
+        return;
+
+    pgmObjectAsPoint->use();
+    uPointMVP = mat4Uniform(pgmObjectAsPoint->getID(), "mvp");
+    uPointClip = vec2Uniform(pgmObjectAsPoint->getID(), "uCamClip");
+    pgmObjectAsPoint->release();
+
+    vaoPoints = new VertexArray();
+    vaoPoints->bind();
+
+    vboPoints = new VertexBuffer(1);
+    vboPoints->allocate(256 * sizeof(objVertex), nullptr, GL_STREAM_DRAW);
+    szPoints = 256;
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(objVertex), (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(objVertex), (void *)12);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(objVertex), (void *)28);
+    glEnableVertexAttribArray(2);
+    checkErrors();
+
+    vaoPoints->unbind();
+}
+
+// Queue sub-pixel object as point sprite. All
+// points are drawn with one call at end of frame.
+void Scene::addObjectAsPoint(const glm::dvec3 &vpos, const color_t &color, double appMag)
 {
+    double pointSize, alpha;
+
+    calculatePointSize(appMag, 5.0, pointSize, alpha);
+    if (alpha <= 0.0)
+        return;
 
+    objVertex &vtx = pointList.emplace_back();
+    vtx.posObject = vpos;
+    vtx.color = { color, float(alpha) };
+    vtx.size = pointSize;
+}
+
+void Scene::renderObjectPoints()
+{
+    if (pointList.empty() || vaoPoints == nullptr)
+        return;
+
+    pgmObjectAsPoint->use();
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glEnable(GL_PROGRAM_POINT_SIZE);
+
+    vaoPoints->bind();
+    vboPoints->bind();
+    if (pointList.size() > szPoints)
+    {
+        szPoints = std::max(pointList.size(), szPoints*2);
+        vboPoints->allocate(szPoints * sizeof(objVertex), nullptr, GL_STREAM_DRAW);
+    }
+    vboPoints->update(pointList.data(), pointList.size() * sizeof(objVertex));
+
+    uPointMVP = glm::mat4(camera->getProjViewMatrix());
+    uPointClip = camera->getClip();
+
+    glDrawArrays(GL_POINTS, 0, pointList.size());
+    vaoPoints->unbind();
+
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    glDisable(GL_BLEND);
+
+    pgmObjectAsPoint->release();
 }
 
 void Scene::renderCelestialBody(ObjectListEntry &ole)
@@ -48,7 +183,7 @@ void Scene::renderCelestialBody(ObjectListEntry &ole)
         // vobj->render(prm, op, lights);
     }
     else
-        renderObjectAsPoint(ole);
+        addObjectAsPoint(ole.vpos, ole.color, ole.appMag);
 }
 
 void Scene::renderOrbitPath(ObjectListEntry &ole)
@@ -58,23 +193,73 @@ void Scene::renderOrbitPath(ObjectListEntry &ole)
 
 void Scene::renderSystemObjects()
 {
-    if (renderList.empty())
-        return;
+    // Vehicles queue mesh instances during render
+    vmeshmgr.begin();
 
-    glm::dmat4 view = camera->getViewMatrix();
-    glm::dmat4 proj = camera->getProjMatrix();
-
-    for (auto ole : renderList)
+    renderQueue.sort();
+    for (int idx = 0; idx < renderQueue.size(); idx++)
     {
+        ObjectListEntry &ole = renderQueue[idx];
+
         // glLogger->debug("Rendering {}...\n", ole.object->getName());
 
-        setObjectLighting(lightSources, ole.vpos, ole.orot, ole.lights);
+        // Instanced vehicles are lit at camera position (see below)
+        if (ole.object->getType() != ObjectType::objVehicle)
+            setObjectLighting(lightSources, ole.vpos, ole.orot, ole.lights);
 
         ole.camClip = camera->getClip();
         ole.visual->render(ole);
     }
+
+    // Instanced vehicles share lighting at camera position.
+    LightState lights;
+    setObjectLighting(lightSources, glm::dvec3(0.0), glm::dquat(1.0, 0.0, 0.0, 0.0), lights);
+    shmgr.setLightParameters(lights);
+    {
+        FrameScope scope(prfVehicles);
+        glTimerScope gpuScope(gpuTimer, prfVehicles);
+        vmeshmgr.render(shmgr, camera->getClip());
+    }
+
+    renderObjectPoints();
 }
 
+void Scene::buildVehicles(pSystem *psys, const glm::dvec3 &obs)
+{
+    for (int idx = 0; idx < psys->getVehiclesSize(); idx++)
+    {
+        Vehicle *veh = psys->getVehicle(idx);
+        glm::dvec3 vpos = veh->getgPosition() - obs;
+        if (!isVisible(vpos, veh->getBoundingRadius()))
+            continue;
+
+        double vdist = glm::length(vpos);
+        double vSize = veh->getRadius() / vdist;
+
+        ObjectListEntry &ole = renderQueue.alloc();
+
+        ole.object  = veh;
+        ole.visual  = getVisualObject(ole.object, true);
+        ole.objSize = veh->getRadius();
+        ole.color   = veh->getColor();
+
+        ole.vpos    = vpos;
+        ole.vdist   = vdist;
+        ole.vSize   = vSize;
+        ole.pxSize  = vSize / pixelSize;
+        ole.orot    = veh->getgRotation();
+
+        ole.zCenter = 0.0;
+        ole.zFar    = 1e24;
+        ole.zNear   = 0.0001;
+        ole.camClip = glm::vec2(ole.zNear, ole.zFar);
+    }
+}
+
+// Walk planetary system tree and queue visible bodies. Bodies
+// outside view frustum are skipped, and bodies smaller than one
+// pixel are drawn as point sprites. Children are always visited
+// since moons may be in view while their planet is not.
 void Scene::buildSystems(secondaries_t &bodies, const glm::dvec3 &obs,
     const glm::dvec3 &vpnorm)
 {
@@ -85,70 +270,56 @@ void Scene::buildSystems(secondaries_t &bodies, const glm::dvec3 &obs,
         if (body->getCelestialType() == cbObserver)
             continue;
 
+        glm::dvec3 vpos = body->getgPosition() - obs;
+        double rad = body->getRadius();
+        double vdist = glm::length(vpos);
+        double vSize = rad / vdist;
+        double pxSize = vSize / pixelSize;
+
+        if (body->isSecondaryIlluminator() && pxSize > 1.0)
+        {
+            SecondaryLight reflected;
+
+            reflected.object = body;
+            reflected.vpos = vpos;
+            reflected.radius = rad;
+            secondaryLights.push_back(reflected);
+        }
+
+        if (isVisible(vpos, std::max(rad, body->getCullingRadius())))
         {
-            glm::dvec3 opos = body->getgPosition();
-            glm::dmat3 orot = body->getgRotation();
-            glm::dvec3 vpos = opos - obs;
-
-            double vdist = glm::length(vpos);
-            double vbnorm = glm::dot(vpnorm, vpos);
-            double vSize  = body->getRadius() / vdist;
-            
             double appMag = std::numeric_limits<double>::infinity();
-            for (auto light : lightSources)
+            for (auto &light : lightSources)
                 appMag = std::min(appMag, body->getApparentMagnitude(light.spos, light.luminosity, vpos));
 
-            if (body->isSecondaryIlluminator())
+            if (pxSize < 1.0)
+                addObjectAsPoint(vpos, body->getColor(), appMag);
+            else
             {
-
-                double rad = body->getRadius();
-                if ((rad / glm::length(vpos)) / pixelSize > 1.0)
-                {
-                    SecondaryLight reflected;
-
-                    reflected.object = body;
-                    reflected.vpos = vpos;
-                    reflected.radius = rad;
-                    secondaryLights.push_back(reflected);
-                }
-            }
-
-            // if (pxSize > 1)
-            // {
-                ObjectListEntry ole;
-
-                // setObjectLighting(lightSources, vpos, orot, ole.lights);
+                ObjectListEntry &ole = renderQueue.alloc();
 
                 ole.object  = body;
                 ole.visual  = getVisualObject(ole.object, true);
-                ole.objSize = body->getRadius();
+                ole.objSize = rad;
                 ole.color   = body->getColor();
 
-                // ole.spos    = spos;
                 ole.vpos    = vpos;
                 ole.vdist   = vdist;
                 ole.vSize   = vSize;
-                ole.pxSize  = vSize * pixelSize;
+                ole.pxSize  = pxSize;
                 ole.appMag  = appMag;
-                ole.orot    = orot;
+                ole.orot    = body->getgRotation();
 
                 ole.zCenter = 0.0;
                 ole.zFar    = 1e24;
                 ole.zNear   = 0.0001;
                 ole.camClip = glm::vec2(ole.zNear, ole.zFar);
-
-                // logger->debug("{}: Adding to rendering list\n", body->getsName());
-                // glLogger->debug("{}: P({:.6f},{:.6f},{:.6f}))\n",
-                //     body->getsName(), ole.vpos.x, ole.vpos.y, ole.vpos.z);
-
-                addRenderList(ole);
-                // renderCelestialBody(ole);
-            // }
-
-            secondaries_t &secondaries = body->getSecondaries();
-            if (secondaries.size() > 0)
-                buildSystems(secondaries, obs, vpnorm);
+            }
         }
+
+        secondaries_t &secondaries = body->getSecondaries();
+        if (secondaries.size() > 0)
+            buildSystems(secondaries, obs, vpnorm);
     }
 }
 
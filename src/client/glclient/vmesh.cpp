@@ -7,63 +7,277 @@
 #include "engine/mesh.h"
 #include "client.h"
 #include "renderer.h"
+#include "shader.h"
+#include "texmgr.h"
 #include "vmesh.h"
 
-
-vMesh::vMesh(Mesh *mesh)
+vMesh::vMesh(const Mesh *mesh, GLuint idBuffer)
+: mesh(mesh)
 {
-
     int ngrps = mesh->getGroupSize();
     groups.reserve(ngrps);
     for (int idx = 0; idx < ngrps; idx++)
-        copyGroup(groups[idx], mesh->getGroup(idx));
-
+    {
+        vMeshGroup *grp = new vMeshGroup;
+        copyGroup(grp, const_cast<Mesh *>(mesh)->getGroup(idx), idBuffer);
+        groups.push_back(grp);
+    }
 }
 
 vMesh::~vMesh()
 {
-
+    for (auto grp : groups)
+        delete grp;
+    groups.clear();
 }
 
-void vMesh::copyGroup(vMeshGroup *dst, MeshGroup *src)
+// Upload group to GPU. Instance index attribute (location 4)
+// steps once per instance so that baseInstance of each draw
+// selects its first instance in instance buffer.
+void vMesh::copyGroup(vMeshGroup *dst, const MeshGroup *src, GLuint idBuffer)
 {
-
-    // dstv->vertices.reserve(src->nvtx);
+    std::vector<mvtx_t> vertices(src->nvtx);
     for (int vidx = 0; vidx < src->nvtx; vidx++)
     {
         MeshVertex  &srcv = src->vtx[vidx];
-        vMeshVertex &dstv = dst->vertices[vidx];
+        vMeshVertex &dstv = vertices[vidx];
 
         dstv.vtx = srcv.vtx;
         dstv.nml = srcv.nml;
+        dstv.tgt = srcv.tgt;
         dstv.tc  = srcv.tc;
     }
 
-    dst->indices.reserve(src->nidx);
-    for (int iidx = 0; iidx < src->nidx; iidx++)
-        dst->indices[iidx] = src->idx[iidx];
+    dst->nidx = src->nidx;
+    dst->mtrlIndex = src->mtrlIndex;
+    dst->texIndex = src->texIndex;
+
+    dst->vao.bind();
+    dst->vbo.allocate(vertices.size() * sizeof(mvtx_t), vertices.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(mvtx_t), (void *)offsetof(mvtx_t, vtx));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(mvtx_t), (void *)offsetof(mvtx_t, nml));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(mvtx_t), (void *)offsetof(mvtx_t, tgt));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(mvtx_t), (void *)offsetof(mvtx_t, tc));
+    glEnableVertexAttribArray(3);
+
+    glBindBuffer(GL_ARRAY_BUFFER, idBuffer);
+    glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void *)0);
+    glVertexAttribDivisor(4, 1);
+    glEnableVertexAttribArray(4);
+
+    dst->ibo.allocate(src->idx, src->nidx, GL_STATIC_DRAW);
+    dst->vao.unbind();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    checkErrors();
+}
+
+// ******** Visual Mesh Manager ********
+
+static ShaderPackage glslMesh[] = {
+    { "vmesh.vs.glsl", true, shrVertexProcessor },
+    { "vmesh.fs.glsl", true, shrFragmentProcessor }
+};
+
+static ShaderPackage glslImpostor[] = {
+    { "impostor.vs.glsl", true, shrVertexProcessor },
+    { "impostor.fs.glsl", true, shrFragmentProcessor }
+};
+
+vMeshManager::~vMeshManager()
+{
+    for (auto &[mesh, vmesh] : meshList)
+        delete vmesh;
+    meshList.clear();
+
+    if (idBuffer != 0)
+    {
+        glDeleteBuffers(1, &idBuffer);
+        glDeleteBuffers(1, &ssbo);
+        glDeleteBuffers(1, &ssboImpostor);
+        glDeleteVertexArrays(1, &vaoImpostor);
+    }
+}
+
+void vMeshManager::init(ShaderManager &shmgr)
+{
+    pgmMesh = shmgr.createShader("vmesh", glslMesh, ARRAY_SIZE(glslMesh));
+    pgmImpostor = shmgr.createShader("impostor", glslImpostor, ARRAY_SIZE(glslImpostor));
+    if (pgmMesh != nullptr)
+    {
+        pgmMesh->use();
+        uDiffuse = vec4Uniform(pgmMesh->getID(), "uDiffuse");
+        uTextured = boolUniform(pgmMesh->getID(), "uTextured");
+        pgmMesh->release();
+    }
+
+    glGenBuffers(1, &idBuffer);
+    glGenBuffers(1, &ssbo);
+    glGenBuffers(1, &ssboImpostor);
+
+    // Impostors are fetched from buffer by gl_VertexID
+    // but core profile requires bound VAO to draw.
+    glGenVertexArrays(1, &vaoImpostor);
+    resize(256);
+}
+
+void vMeshManager::resize(int nInstances)
+{
+    if (nInstances <= nCapacity)
+        return;
+    nCapacity = std::max(nInstances, nCapacity*2);
+
+    std::vector<uint32_t> ids(nCapacity);
+    for (int idx = 0; idx < nCapacity; idx++)
+        ids[idx] = idx;
 
+    // Mesh VAOs refer to buffer by name, so
+    // re-specifying data keeps them valid.
+    glBindBuffer(GL_ARRAY_BUFFER, idBuffer);
+    glBufferData(GL_ARRAY_BUFFER, nCapacity * sizeof(uint32_t), ids.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, nCapacity * sizeof(MeshInstance), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    checkErrors();
 }
 
-void vMesh::computeTangets()
+vMesh *vMeshManager::acquire(const Mesh *mesh)
 {
-    
+    if (mesh == nullptr || idBuffer == 0)
+        return nullptr;
+
+    vMesh *&vmesh = meshList[mesh];
+    if (vmesh == nullptr)
+        vmesh = new vMesh(mesh, idBuffer);
+    vmesh->refs++;
+    return vmesh;
 }
 
-void vMesh::renderGroup(const vMeshGroup &grp)
+void vMeshManager::release(vMesh *vmesh)
 {
-    if (grp.ibo.getCount() == 0 || grp.vbo.getCount() == 0)
+    if (vmesh == nullptr || --vmesh->refs > 0)
         return;
-    grp.vao.bind();
-    glDrawElements(GL_TRIANGLES, grp.ibo.getCount(), GL_UNSIGNED_SHORT, 0);
-    grp.vao.unbind();
+
+    std::erase(batches, vmesh);
+    meshList.erase(vmesh->mesh);
+    delete vmesh;
+}
+
+void vMeshManager::begin()
+{
+    for (auto vmesh : batches)
+        vmesh->instances.clear();
+    batches.clear();
+    impostors.clear();
 }
 
-void vMesh::render(const glm::mat4 &model)
+void vMeshManager::addInstance(vMesh *vmesh, const MeshInstance &inst)
 {
+    if (vmesh->instances.empty())
+        batches.push_back(vmesh);
+    vmesh->instances.push_back(inst);
+}
+
+void vMeshManager::addImpostor(const ImpostorInstance &inst)
+{
+    impostors.push_back(inst);
+}
+
+// Draw all queued instances. Instances are packed mesh by mesh
+// into one buffer, then each mesh group goes out with a single
+// instanced draw call.
+void vMeshManager::render(ShaderManager &shmgr, const glm::vec2 &clip)
+{
+    nDraws = 0;
+    nInstances = impostors.size();
+    int nGroups = 0;
+
+    // Camera clip for logarithmic depth (transforms are per instance)
+    shmgr.setObjectParameters(glm::dmat4(1.0), glm::dmat4(1.0), clip);
 
-    for (auto &grp : groups) {
+    if (!batches.empty() && pgmMesh != nullptr)
+    {
+        instances.clear();
+        for (auto vmesh : batches)
+            instances.insert(instances.end(), vmesh->instances.begin(), vmesh->instances.end());
+        resize(instances.size());
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, instances.size() * sizeof(MeshInstance), instances.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssbo);
+
+        pgmMesh->use();
+        glEnable(GL_CULL_FACE);
+
+        uint32_t base = 0;
+        for (auto vmesh : batches)
+        {
+            uint32_t count = vmesh->instances.size();
+            nInstances += count;
+            nGroups += vmesh->groups.size();
+            for (auto grp : vmesh->groups)
+            {
+                if (grp->nidx == 0)
+                    continue;
+                const MeshMaterial *mtrl = vmesh->mesh->getMaterial(grp->mtrlIndex);
+                glTexture *tx = dynamic_cast<glTexture *>(vmesh->mesh->getTexture(grp->texIndex));
 
-        renderGroup(*grp);
+                uDiffuse = mtrl != nullptr ? mtrl->diffuse : glm::vec4(1.0f);
+                uTextured = (tx != nullptr);
+                if (tx != nullptr)
+                    tx->bind();
+
+                grp->vao.bind();
+                glDrawElementsInstancedBaseInstance(GL_TRIANGLES, grp->nidx, grp->ibo.getType(),
+                    nullptr, count, base);
+                nDraws++;
+            }
+            base += count;
+        }
+
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_CULL_FACE);
+        pgmMesh->release();
     }
-}
\ No newline at end of file
+
+    if (!impostors.empty() && pgmImpostor != nullptr)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssboImpostor);
+        if (impostors.size() > nImpostorCapacity)
+        {
+            nImpostorCapacity = std::max<int>(impostors.size(), nImpostorCapacity*2);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, nImpostorCapacity * sizeof(ImpostorInstance), nullptr, GL_STREAM_DRAW);
+        }
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, impostors.size() * sizeof(ImpostorInstance), impostors.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssboImpostor);
+
+        pgmImpostor->use();
+        glEnable(GL_PROGRAM_POINT_SIZE);
+        glBindVertexArray(vaoImpostor);
+        glDrawArrays(GL_POINTS, 0, impostors.size());
+        glBindVertexArray(0);
+        glDisable(GL_PROGRAM_POINT_SIZE);
+        pgmImpostor->release();
+        nDraws++;
+    }
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+
+    // Draw calls must stay flat as fleet grows - at most
+    // one per mesh group and one for all impostors.
+    if (nDraws > nGroups + 1 && !bDrawWarned)
+    {
+        glLogger->warn(Logger::catGraphics, "Mesh instancing: {} draw calls for {} groups ({} instances)\n",
+            nDraws, nGroups, nInstances);
+        bDrawWarned = true;
+    }
+}
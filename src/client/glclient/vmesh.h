@@ -9,6 +9,11 @@
 
 class Mesh;
 struct MeshGroup;
+class ShaderManager;
+class ShaderProgram;
+
+#define MESH_IMPOSTOR_SIZE  6.0     // Impostor below this size [pixels]
+#define MESH_MINIMUM_SIZE   0.5     // Not drawn below this size [pixels]
 
 struct vMeshVertex
 {
@@ -27,36 +32,98 @@ using mvtx_t = vMeshVertex;
 
 struct vMeshGroup
 {
-    std::vector<mvtx_t> vertices;
-    std::vector<uint16_t> indices;
+    uint32_t nidx = 0;
+    int mtrlIndex = -1;
+    int texIndex = -1;
 
     VertexArray  vao;
-    VertexBuffer vbo;
-    IndexBuffer  ibo;
+    VertexBuffer vbo{1};
+    IndexBuffer  ibo{1};
+};
+
+// Per-instance data (std430) - must match vmesh.vs.glsl
+struct MeshInstance
+{
+    glm::mat4 mWorld;       // projection * view * model
+    glm::mat4 mModel;       // camera-relative model matrix
+    glm::vec4 anim;         // animation states (first four)
+};
+
+// Far-away vehicle drawn as point sprite (std430)
+struct ImpostorInstance
+{
+    glm::vec4 pos;          // camera-relative position, w = size [pixels]
+    glm::vec4 color;
 };
 
 class vMesh
 {
+    friend class vMeshManager;
+
 public:
-    vMesh(Mesh *mesh);
+    vMesh(const Mesh *mesh, GLuint idBuffer);
     ~vMesh();
 
-    void copyGroup(vMeshGroup *glgrp, MeshGroup *mgrp);
-
-    void computeTangets();
-
-    void renderGroup(const vMeshGroup &grp);
-    void render(const glm::mat4 &model);
+    inline const Mesh *getSource() const    { return mesh; }
+    inline int getGroupSize() const         { return groups.size(); }
 
 private:
+    void copyGroup(vMeshGroup *glgrp, const MeshGroup *mgrp, GLuint idBuffer);
+
+    const Mesh *mesh;
     std::vector<vMeshGroup *> groups;
 
+    int refs = 0;
+    std::vector<MeshInstance> instances;    // instances in current frame
 };
 
+// Shared visual meshes and instanced mesh rendering
+//
+// Vehicles sharing same mesh share one vMesh. Each frame, vehicles
+// queue their instances and render() submits one instanced draw
+// per mesh group and one draw for all impostors, regardless of
+// number of vehicles.
 class vMeshManager
 {
 public:
+    vMeshManager() = default;
+    ~vMeshManager();
+
+    inline int getDrawCount() const         { return nDraws; }
+    inline int getInstanceCount() const     { return nInstances; }
+
+    void init(ShaderManager &shmgr);
+
+    vMesh *acquire(const Mesh *mesh);
+    void release(vMesh *vmesh);
+
+    void begin();
+    void addInstance(vMesh *vmesh, const MeshInstance &inst);
+    void addImpostor(const ImpostorInstance &inst);
+    void render(ShaderManager &shmgr, const glm::vec2 &clip);
 
 private:
-    std::vector<vMesh *> meshList;
-};
\ No newline at end of file
+    void resize(int nInstances);
+
+    std::map<const Mesh *, vMesh *> meshList;
+
+    ShaderProgram *pgmMesh = nullptr;
+    ShaderProgram *pgmImpostor = nullptr;
+    vec4Uniform uDiffuse;
+    boolUniform uTextured;
+
+    GLuint idBuffer = 0;        // per-instance index (divisor 1)
+    GLuint ssbo = 0;            // mesh instance buffer
+    GLuint ssboImpostor = 0;    // impostor buffer
+    GLuint vaoImpostor = 0;
+    int    nCapacity = 0;
+    int    nImpostorCapacity = 0;
+
+    std::vector<vMesh *> batches;
+    std::vector<MeshInstance> instances;
+    std::vector<ImpostorInstance> impostors;
+
+    int nDraws = 0;             // draw calls in last frame
+    int nInstances = 0;         // vehicles and impostors in last frame
+    bool bDrawWarned = false;
+};
@@ -161,15 +161,16 @@ vObject *Scene::addVisualObject(const Object *object)
 
     vobj = vObject::create(object, *this);
     vobjList.push_back(vobj);
+    vobjMap[object] = vobj;
 
     return vobj;
 }
 
 vObject *Scene::getVisualObject(const Object *object, bool bCreate)
 {
-    for (int idx = 0; idx < vobjList.size(); idx++)
-        if (vobjList[idx]->getObject() == object)
-            return vobjList[idx];
+    auto it = vobjMap.find(object);
+    if (it != vobjMap.end())
+        return it->second;
 
     if (bCreate == true)
         return addVisualObject(object);
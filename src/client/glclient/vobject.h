@@ -38,13 +38,6 @@ struct ObjectProperties
     double   dTime;
 };
 
-struct objVertex
-{
-    glm::vec3   posObject;
-    color_t     color;
-    float       size;
-};
-
 class vObject
 {
 public:
@@ -31,14 +31,54 @@ vVehicle::~vVehicle()
 
 void vVehicle::loadMeshes()
 {
+    MeshManager &meshmgr = scene.getMeshManager();
+    fs::path meshPath = fs::path(OFS_HOME_DIR) / "meshes";
 
+    // Request shared meshes in background - same mesh file is
+    // parsed once for all vehicles using it.
+    for (int idx = 0; idx < vehicle->getMeshCount(); idx++)
+    {
+        const MeshEntry *mesh = vehicle->getMesh(idx);
+        vMeshEntry entry;
+
+        entry.trans = glm::translate(glm::mat4(1.0f), glm::vec3(mesh->meshofs));
+        entry.isVisible = true;
+        if (!mesh->meshName.empty())
+        {
+            fs::path fname = meshPath / mesh->meshName;
+            if (!fname.has_extension())
+                fname.replace_extension(".msh");
+            entry.handle = meshmgr.loadMeshAsync(fname.string());
+        }
+        meshList.push_back(entry);
+    }
+}
+
+void vVehicle::updateMeshes()
+{
+    for (auto &entry : meshList)
+    {
+        if (entry.mesh != nullptr || !isMeshReady(entry.handle))
+            continue;
+        Mesh *mesh = entry.handle.get();
+        if (mesh == nullptr)
+            continue;
+        mesh->setup();
+        entry.mesh = scene.getVisualMeshManager().acquire(mesh);
+    }
 }
 
 void vVehicle::clearMeshes()
 {
+    MeshManager &meshmgr = scene.getMeshManager();
+
     for (auto &entry : meshList)
+    {
         if (entry.mesh != nullptr)
-            delete entry.mesh;
+            scene.getVisualMeshManager().release(entry.mesh);
+        if (entry.handle.valid())
+            meshmgr.releaseMesh(entry.handle.get());
+    }
     meshList.clear();
 }
 
@@ -46,7 +86,7 @@ void vVehicle::initAnimations()
 {
     canlist_t &animList = vehicle->getAnimationList();
     animpState.clear();
-    animpState.reserve(animList.size());
+    animpState.resize(animList.size());
     for (int idx = 0; idx < animList.size(); idx++)
         animpState[idx] = animList[idx]->state;
 }
@@ -104,18 +144,50 @@ void vVehicle::animate(anim_t *an, double state, int midx)
 void vVehicle::update(int now)
 {
     vObject::update(now);
+    updateMeshes();
     // updateAnimate(now);
 }
 
+// Queue vehicle for instanced rendering - see vMeshManager.
+// Vehicles smaller than a few pixels are drawn as impostor.
 void vVehicle::render(const ObjectListEntry &ole)
 {
-    for (auto mesh : meshList)
+    vMeshManager &vmeshmgr = scene.getVisualMeshManager();
+
+    updateMeshes();
+
+    if (ole.pxSize < MESH_MINIMUM_SIZE)
+        return;
+    if (ole.pxSize < MESH_IMPOSTOR_SIZE)
+    {
+        ImpostorInstance inst;
+        inst.pos = glm::vec4(glm::vec3(ole.vpos), float(ole.pxSize * 2.0));
+        inst.color = glm::vec4(ole.color.vec3(), 1.0f);
+        vmeshmgr.addImpostor(inst);
+        return;
+    }
+
+    Camera *camera = scene.getCamera();
+    glm::dmat4 dmViewProj = camera->getProjMatrix() * camera->getViewMatrix();
+    glm::dmat4 dmModel = { ole.orot[0][0], ole.orot[1][0], ole.orot[2][0], 0,
+                           ole.orot[0][1], ole.orot[1][1], ole.orot[2][1], 0,
+                           ole.orot[0][2], ole.orot[1][2], ole.orot[2][2], 0,
+                           ole.vpos.x,     ole.vpos.y,     ole.vpos.z,     1 };
+
+    MeshInstance inst;
+    for (int idx = 0; idx < 4; idx++)
+        inst.anim[idx] = idx < animpState.size() ? float(animpState[idx]) : 0.0f;
+
+    for (auto &entry : meshList)
     {
-        if (mesh.isVisible == false)
+        if (entry.isVisible == false || entry.mesh == nullptr)
             continue;
-        
+
         // Render external mesh
-        // mesh.render();
+        glm::dmat4 dmMesh = dmModel * glm::dmat4(entry.trans);
+        inst.mModel = glm::mat4(dmMesh);
+        inst.mWorld = glm::mat4(dmViewProj * dmMesh);
+        vmeshmgr.addInstance(entry.mesh, inst);
 
         // Render HUD/MFD panels
     }
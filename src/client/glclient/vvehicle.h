@@ -14,6 +14,7 @@ struct ancomp_t;
 struct vMeshEntry
 {
     vMesh *mesh = nullptr;
+    MeshHandle handle;          // shared mesh from mesh manager
     glm::mat4 trans;
     bool isVisible;
 };
@@ -24,6 +25,7 @@ public:
     ~vVehicle();
 
     void loadMeshes();
+    void updateMeshes();
     void initAnimations();
     void clearMeshes();
     void clearAnimations();
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "vulkan/vulkan.h"
+#include <GLFW/glfw3.h>
 
 #include "api/logger.h"
 #include "api/module.h"
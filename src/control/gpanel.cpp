@@ -9,6 +9,7 @@
 #include "engine/vehicle/vehicle.h"
 #include "control/mfd/panel.h"
 #include "control/panel.h"
+#include "control/layer.h"
 #include "control/gpanel.h"
 #include "hud/panel.h"
 
@@ -20,6 +21,7 @@ GenericPanel::GenericPanel(Panel *panel)
 
 GenericPanel::~GenericPanel()
 {
+    cleanResources();
 }
 
 void GenericPanel::initResources()
@@ -37,6 +39,20 @@ void GenericPanel::initResources()
     hudBarPen = gc->createPen({0, 0, 0, .5}, 4, 1);
     hudOnPen = gc->createPen({0, 0, 0, .5}, 4, 1);
     hudOffPen = gc->createPen({0, 0, 0, .25}, 4, 1);
+
+    // Both layers are redrawn on demand only
+    lFrames = new PanelLayer(gc, GPANEL_WIDTH, GPANEL_HEIGHT);
+    lEngines = new PanelLayer(gc, GPANEL_WIDTH, GPANEL_HEIGHT);
+}
+
+void GenericPanel::cleanResources()
+{
+    if (lFrames != nullptr)
+        delete lFrames;
+    if (lEngines != nullptr)
+        delete lEngines;
+    lFrames = nullptr;
+    lEngines = nullptr;
 }
 
 void GenericPanel::render()
@@ -49,7 +65,57 @@ void GenericPanel::draw(Player &player, Sketchpad *pad)
     // drawButton(pad, cx/4, cy+64, cx/4+90, cy+124, false);
 
     Vehicle *veh = player.getVehicleTarget();
-    drawEngines(pad, veh);
+    double syst = panel->getSysTime();
+
+    if (checkEngines(veh))
+        lEngines->invalidate();
+
+    if (lFrames->isDue(syst))
+    {
+        if (Sketchpad *skp = lFrames->beginDraw(syst))
+        {
+            drawFrames(skp);
+            lFrames->endDraw();
+        }
+    }
+
+    if (lEngines->isDue(syst))
+    {
+        if (Sketchpad *skp = lEngines->beginDraw(syst))
+        {
+            drawEngines(skp);
+            lEngines->endDraw();
+        }
+    }
+
+    pad->beginDraw();
+    lEngines->render(pad, 0, 0);
+    lFrames->render(pad, 0, 0);
+    pad->endDraw();
+}
+
+// Check engine state against last drawn state. Levels are
+// compared as bar lengths so that sub-pixel changes do not
+// trigger redraw.
+bool GenericPanel::checkEngines(Vehicle *veh)
+{
+    tank_t *ts = veh->getDefaultPropellant();
+    int fuel = int(veh->getPropellantLevel(ts) * 350);
+    int thMain = int(veh->getThrustGroupLevel(thgMain) * 350);
+    int thRetro = int(veh->getThrustGroupLevel(thgRetro) * 350);
+    int thHover = int(veh->getThrustGroupLevel(thgHover) * 350);
+    int rcs = veh->getRCSMode();
+
+    if (fuel == barFuel && thMain == barMain && thRetro == barRetro &&
+        thHover == barHover && rcs == rcsMode)
+        return false;
+
+    barFuel = fuel;
+    barMain = thMain;
+    barRetro = thRetro;
+    barHover = thHover;
+    rcsMode = rcs;
+    return true;
 }
 
 void GenericPanel::drawButton(Sketchpad *pad, int x0, int y0, int x1, int y1, bool on)
@@ -62,24 +128,9 @@ void GenericPanel::drawButton(Sketchpad *pad, int x0, int y0, int x1, int y1, bo
     pad->drawRectangle(x0, y0, x1, y1);
 }
 
-void GenericPanel::drawEngines(Sketchpad *pad, Vehicle *veh)
+void GenericPanel::drawFrames(Sketchpad *pad)
 {
-    tank_t *ts = veh->getDefaultPropellant();
-    double fuelLevel = veh->getPropellantLevel(ts);
-
-    double thMain = veh->getThrustGroupLevel(thgMain);
-    double thRetro = veh->getThrustGroupLevel(thgRetro);
-    double thHover = veh->getThrustGroupLevel(thgHover);
-    int rcsMode = veh->getRCSMode();
-
-    // display engine control bar
-    pad->setPen(hudBarPen);
-    pad->setBrush(brushOn);
-    pad->drawRectangle(150, 50, 150+(fuelLevel*350), 100);
-    pad->drawRectangle(150, 120, 150+(thMain*350), 170);
-    pad->drawRectangle(150, 190, 150+(thRetro*350), 240);
-    pad->drawRectangle(150, 260, 150+(thHover*350), 310);
-
+    // Engine control bar frames
     pad->setPen(hudPen);
     pad->setBrush(nullptr);
     pad->drawRectangle(150, 50, 500, 100);
@@ -87,6 +138,21 @@ void GenericPanel::drawEngines(Sketchpad *pad, Vehicle *veh)
     pad->drawRectangle(150, 190, 500, 240);
     pad->drawRectangle(150, 260, 500, 310);
 
+    // Engine RCS button frames
+    pad->drawRectangle(150, 330, 250, 380);
+    pad->drawRectangle(270, 330, 370, 380);
+}
+
+void GenericPanel::drawEngines(Sketchpad *pad)
+{
+    // display engine control bar
+    pad->setPen(hudBarPen);
+    pad->setBrush(brushOn);
+    pad->drawRectangle(150, 50, 150+barFuel, 100);
+    pad->drawRectangle(150, 120, 150+barMain, 170);
+    pad->drawRectangle(150, 190, 150+barRetro, 240);
+    pad->drawRectangle(150, 260, 150+barHover, 310);
+
     // Engine RCS buttons
     if (rcsMode & 1) {
         pad->setPen(hudOnPen);
@@ -107,9 +173,5 @@ void GenericPanel::drawEngines(Sketchpad *pad, Vehicle *veh)
         // pad->setBrush(brushOn);
         // pad->drawRectangle(270, 330, 370, 380);
     }
-    
-    pad->setPen(hudPen);
     pad->setBrush(nullptr);
-    pad->drawRectangle(150, 330, 250, 380);
-    pad->drawRectangle(270, 330, 370, 380);
 }
\ No newline at end of file
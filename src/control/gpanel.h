@@ -6,8 +6,13 @@
 #pragma once
 
 class Panel;
+class PanelLayer;
 class Player; 
 
+// Engine display area (upper-left corner of screen)
+#define GPANEL_WIDTH    512
+#define GPANEL_HEIGHT   400
+
 class GenericPanel : public PanelEx
 {
     friend class Panel;
@@ -16,12 +21,16 @@ public:
     ~GenericPanel();
 
     void initResources();
+    void cleanResources();
 
     void render();
     void draw(Player &player, Sketchpad *pad) override;
 
     void drawButton(Sketchpad *pad, int x0, int y0, int x1, int y1, bool on);
-    void drawEngines(Sketchpad *pad, Vehicle *veh);
+    void drawFrames(Sketchpad *pad);
+    void drawEngines(Sketchpad *pad);
+
+    bool checkEngines(Vehicle *veh);
 
 protected:
     GraphicsClient *gc = nullptr;
@@ -39,4 +48,14 @@ protected:
     color_t pwrColor = { 1, 0, 0, .75 };
     color_t btnTextOn = { 1, 1, 1, .75 };
     color_t btnTextOff = { 1, 1, 1, .50 };
+
+    PanelLayer *lFrames = nullptr;      // bar frames and buttons (static)
+    PanelLayer *lEngines = nullptr;     // engine levels (redrawn on change)
+
+    // Engine state at last redraw (bar lengths in pixels)
+    int barFuel = -1;
+    int barMain = -1;
+    int barRetro = -1;
+    int barHover = -1;
+    int rcsMode = -1;
 };
\ No newline at end of file
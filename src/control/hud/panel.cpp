@@ -10,6 +10,7 @@
 #include "engine/celestial.h"
 #include "engine/vehicle/vehicle.h"
 #include "control/panel.h"
+#include "control/layer.h"
 #include "utils/json.h"
 
 HUDPanel::HUDPanel(Panel *panel)
@@ -22,6 +23,12 @@ HUDPanel::HUDPanel(Panel *panel)
     panel->setHUDColor({0, 1, 0});
 }
 
+HUDPanel::~HUDPanel()
+{
+    if (layer != nullptr)
+        delete layer;
+}
+
 HUDPanel *HUDPanel::create(cjson &config, GraphicsClient *gc, Panel *panel)
 {
     str_t hudName = myjson::getString<str_t>(config, "type");
@@ -37,7 +44,10 @@ HUDPanel *HUDPanel::create(cjson &config, GraphicsClient *gc, Panel *panel)
     }
 
     if (hud != nullptr)
+    {
+        hud->setRefreshRate(myjson::getFloat<double>(config, "refresh", 0.0));
         hud->configure(config);
+    }
 
     return hud;
 }
@@ -58,12 +68,54 @@ void HUDPanel::resize(int w, int h)
     markerSize = std::max(20, height/28);
 
     // hudofs = { 0, 0, cam->getScale() };
+
+    if (layer != nullptr)
+        layer->resize(width, height);
+    else if (refreshRate > 0.0)
+    {
+        layer = new PanelLayer(gc, width, height);
+        layer->setRefreshRate(refreshRate);
+    }
+}
+
+void HUDPanel::setRefreshRate(double hz)
+{
+    refreshRate = hz;
+    if (layer != nullptr)
+        layer->setRefreshRate(hz);
+}
+
+void HUDPanel::invalidate()
+{
+    if (layer != nullptr)
+        layer->invalidate();
 }
 
 void HUDPanel::draw(Player &player, Sketchpad *pad)
 {
+    if (layer == nullptr || !layer->isValid())
+    {
+        // Uncached - redraw HUD every frame
+        pad->beginDraw();
+        display(player, pad);
+        pad->endDraw();
+        return;
+    }
+
+    // Redraw HUD into its layer at refresh rate
+    // and composite cached image every frame.
+    double syst = panel->getSysTime();
+    if (layer->isDue(syst))
+    {
+        if (Sketchpad *skp = layer->beginDraw(syst))
+        {
+            display(player, skp);
+            layer->endDraw();
+        }
+    }
+
     pad->beginDraw();
-    display(player, pad);
+    layer->render(pad, 0, 0);
     pad->endDraw();
 }
 
@@ -19,15 +19,19 @@ class Celestial;
 class Vehicle;
 class Player;
 class Camera;
+class PanelLayer;
 
 class HUDPanel
 {
 public:
     HUDPanel(Panel *panel);
+    virtual ~HUDPanel();
 
     static HUDPanel *create(cjson &config, GraphicsClient *gc, Panel *panel);
 
     void resize(int w, int h);
+    void setRefreshRate(double hz);
+    void invalidate();
 
     inline virtual int getMode() const = 0;
 
@@ -71,6 +75,9 @@ protected:
     int markerSize;
 
     Font *hudFont = nullptr;
+
+    double refreshRate = 0.0;       // cached HUD refresh rate [Hz] (0 = draw every frame)
+    PanelLayer *layer = nullptr;
 };
 
 class HUDSurfacePanel : public HUDPanel
@@ -0,0 +1,89 @@
+// layer.cpp - Cached panel layer package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#include "main/core.h"
+#include "api/graphics.h"
+#include "api/draw.h"
+#include "control/layer.h"
+
+PanelLayer::PanelLayer(GraphicsClient *gc, int w, int h)
+: gc(gc), width(w), height(h)
+{
+    create();
+}
+
+PanelLayer::~PanelLayer()
+{
+    release();
+}
+
+void PanelLayer::create()
+{
+    if (gc == nullptr || width <= 0 || height <= 0)
+        return;
+
+    surf = gc->createSurface(width, height, SURF_ALPHA);
+    if (surf != nullptr)
+        pad = gc->createSketchpad(surf, true);
+    if (pad == nullptr)
+        ofsLogger->error("Panel layer: can't create {}x{} surface\n", width, height);
+    bDirty = true;
+}
+
+void PanelLayer::release()
+{
+    if (pad != nullptr)
+        delete pad;
+    if (surf != nullptr)
+        gc->releaseSurface(surf);
+    pad = nullptr;
+    surf = nullptr;
+}
+
+void PanelLayer::resize(int w, int h)
+{
+    if (w == width && h == height)
+        return;
+    release();
+    width = w;
+    height = h;
+    create();
+}
+
+bool PanelLayer::isDue(double syst) const
+{
+    if (bDirty)
+        return true;
+    return interval > 0.0 && syst >= tNext;
+}
+
+Sketchpad *PanelLayer::beginDraw(double syst)
+{
+    if (!isValid())
+        return nullptr;
+
+    // Keep fixed cadence but do not try to catch up
+    // after a long stall (pause, window drag, etc.)
+    tNext += interval;
+    if (tNext < syst)
+        tNext = syst + interval;
+    bDirty = false;
+
+    gc->clearSurface(surf, color_t(0, 0, 0, 0));
+    pad->beginDraw();
+    return pad;
+}
+
+void PanelLayer::endDraw()
+{
+    if (pad != nullptr)
+        pad->endDraw();
+}
+
+void PanelLayer::render(Sketchpad *skpad, int x, int y)
+{
+    if (skpad != nullptr && surf != nullptr)
+        skpad->drawSurface(surf, x, y);
+}
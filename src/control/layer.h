@@ -0,0 +1,51 @@
+// layer.h - Cached panel layer package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+class GraphicsClient;
+class Sketchpad;
+class Texture;
+
+// Offscreen layer for 2D panel overlays
+//
+// Layer content is drawn into its own surface only when it is
+// marked dirty or its refresh interval has elapsed. Cached surface
+// is composited onto the screen every frame instead.
+class PanelLayer
+{
+public:
+    PanelLayer(GraphicsClient *gc, int w, int h);
+    ~PanelLayer();
+
+    inline bool isValid() const             { return surf != nullptr && pad != nullptr; }
+    inline Texture *getSurface() const      { return surf; }
+    inline int getWidth() const             { return width; }
+    inline int getHeight() const            { return height; }
+
+    inline void invalidate()                { bDirty = true; }
+    inline void setRefreshRate(double hz)   { interval = (hz > 0.0) ? 1.0 / hz : 0.0; }
+
+    void resize(int w, int h);
+    bool isDue(double syst) const;
+
+    Sketchpad *beginDraw(double syst);
+    void endDraw();
+
+    void render(Sketchpad *skpad, int x, int y);
+
+private:
+    void create();
+    void release();
+
+    GraphicsClient *gc = nullptr;
+    Texture *surf = nullptr;
+    Sketchpad *pad = nullptr;
+
+    int width, height;
+    bool bDirty = true;
+    double interval = 0.0;  // refresh interval [s] (0 = redraw on demand only)
+    double tNext = 0.0;     // next scheduled redraw [s]
+};
@@ -53,6 +53,40 @@ cchar_t *MFDOrbit::mfdGetButtonLabel(int idx)
     return nullptr;
 }
 
+// Reference, target and projection are drawn into static
+// layer, so any change of them redraws both layers.
+void MFDOrbit::setReference(const Celestial *ref)
+{
+    if (ref == refOrbit)
+        return;
+    refOrbit = ref;
+    invalidate();
+}
+
+void MFDOrbit::setTarget(const Object *tgt)
+{
+    if (tgt == tgtVessel)
+        return;
+    tgtVessel = tgt;
+    invalidate();
+}
+
+void MFDOrbit::setProjection(bool ecliptic)
+{
+    if (ecliptic == bEcliptic)
+        return;
+    bEcliptic = ecliptic;
+    invalidate();
+}
+
+bool MFDOrbit::update(double syst)
+{
+    // Follow vehicle's orbit reference (SOI transitions)
+    if (vehicle != nullptr)
+        setReference(vehicle->getOrbitalReference());
+    return MFDInstrument::update(syst);
+}
+
 void MFDOrbit::drawOrbitPath(Sketchpad *skpad, int which, const glm::dvec2 *path)
 {
     // Draw orbital path line
@@ -77,9 +111,43 @@ void MFDOrbit::drawOrbitPath(Sketchpad *skpad, int which, const glm::dvec2 *path
     skpad->drawLine(an.x, an.y, dn.x, dn.y);
 }
 
+static cchar_t *elementLabels[] = {
+    "SMa", "SMi", "PeR", "ApR", "Rad", "Ecc", "T", "Vel", "Inc", "LAN", "LPe"
+};
+
+// Element values next to labels drawn by drawStatic
 void MFDOrbit::drawElements(Sketchpad *skpad, int x, int y, const OrbitalElements &orbit)
 {
+    double values[] = {
+        orbit.getSemiMajorAxis(), orbit.getSemiMinorAxis(),
+        orbit.getPeriapsisDistance(), orbit.getApoapsisDistance(),
+        orbit.getRadius(), orbit.getEccentricity(), orbit.getOrbitalPeriod(),
+        orbit.getVelocity(), ofs::degrees(orbit.getInclination()),
+        ofs::degrees(orbit.getLongitudeOfAcendingNode()),
+        ofs::degrees(orbit.getLongitudeOfPerapsis())
+    };
+
+    x += cw * 4;
+    for (int idx = 0; idx < std::size(values); idx++, y += ch)
+        skpad->text(x, y, std::format("{:.4g}", values[idx]));
+}
 
+void MFDOrbit::drawStatic(Sketchpad *skpad)
+{
+    str_t title = "Orbit";
+    if (refOrbit != nullptr)
+        title += " " + refOrbit->getsName();
+    skpad->text(cw/2, 0, title);
+    skpad->text(iWidth - cw*12, 0, bEcliptic ? "Ecliptic" : "Orbit plane");
+    if (tgtVessel != nullptr)
+        skpad->text(cw/2, iHeight - ch, "Tgt " + tgtVessel->getsName());
+
+    if (refOrbit == nullptr)
+        return;
+
+    int y = (ch*2)/2;
+    for (int idx = 0; idx < std::size(elementLabels); idx++, y += ch)
+        skpad->text(cw/2, y, elementLabels[idx]);
 }
 
 void MFDOrbit::draw(Sketchpad *skpad)
@@ -90,7 +158,6 @@ void MFDOrbit::draw(Sketchpad *skpad)
     bool instable;
     glm::dmat3 rot, irot;
 
-    bool bEcliptic    = false;
     bool bValidShip   = (refOrbit != nullptr);
     bool bValidTarget = (refOrbit != nullptr && tgtVessel != nullptr);
 
@@ -17,16 +17,24 @@ public:
 
     cchar_t *mfdGetButtonLabel(int idx) override;
 
+    void setReference(const Celestial *ref);
+    void setTarget(const Object *tgt);
+    void setProjection(bool ecliptic);
+
+    bool update(double syst) override;
+
     void drawOrbitPath(Sketchpad *skpad, int which, const glm::dvec2 *path);
     void drawElements(Sketchpad *skpad, int x, int y, const OrbitalElements &orbit);
+    void drawStatic(Sketchpad *skpad) override;
     void draw(Sketchpad *skpad) override;
 
 private:
     int xCenter, yCenter;
     float pixRadius;
 
-    const CelestialBody *refOrbit = nullptr;
+    const Celestial *refOrbit = nullptr;
     const Object *tgtVessel = nullptr;
+    bool bEcliptic = false;         // ecliptic or orbit plane projection
 
     OrbitalElements *shpOrbit = nullptr;
     OrbitalElements *tgtOrbit = nullptr;
@@ -9,19 +9,42 @@
 #include "api/draw.h"
 #include "engine/vehicle/vehicle.h"
 #include "control/panel.h"
+#include "control/layer.h"
 #include "control/mfd/panel.h"
 
 DrawColor MFDInstrument::drawColors[3][2];
 
+// Quarter-ellipse sample angles are fixed, so sine/cosine
+// values are tabulated once instead of per vertex and update.
+static const struct EllipseTable
+{
+    double sphi[NOREL4];
+    double cphi[NOREL4];
+
+    EllipseTable()
+    {
+        double fac = (pi/2)/NOREL4;
+        for (int idx = 0; idx < NOREL4; idx++)
+        {
+            sphi[idx] = sin((idx+0.5)*fac);
+            cphi[idx] = cos((idx+0.5)*fac);
+        }
+    }
+} ellipseTable;
+
 MFDInstrument::MFDInstrument(Panel *panel, const MFDSpec &spec, Vehicle *vehicle)
 : panel(panel), flags(spec.flags), vehicle(vehicle)
 {
     init(spec);
 }
 
-// MFDInstrument::~MFDInstrument()
-// {
-// }
+MFDInstrument::~MFDInstrument()
+{
+    if (lStatic != nullptr)
+        delete lStatic;
+    if (lDisplay != nullptr)
+        delete lDisplay;
+}
 
 void MFDInstrument::ginit(GraphicsClient *gc)
 {
@@ -47,11 +70,6 @@ void MFDInstrument::gexit(GraphicsClient *gc)
 
 }
 
-MFDInstrument *MFDInstrument::create(Panel *panel, const MFDSpec &spec)
-{
-    return nullptr;
-}
-
 void MFDInstrument::init(const MFDSpec &spec)
 {
     iWidth = spec.w;
@@ -64,41 +82,81 @@ void MFDInstrument::init(const MFDSpec &spec)
 
     if (gc = ofsAppCore->getClient())
     {
-        skpad = gc->getSketchpad();
-        if (skpad != nullptr)
-        {
-
-        }
+        if (lStatic == nullptr)
+            lStatic = new PanelLayer(gc, iWidth, iHeight);
+        else
+            lStatic->resize(iWidth, iHeight);
+        if (lDisplay == nullptr)
+            lDisplay = new PanelLayer(gc, iWidth, iHeight);
+        else
+            lDisplay->resize(iWidth, iHeight);
+        lDisplay->setRefreshRate(MFD_REFRESH_RATE);
     }
 }
 
-Sketchpad *MFDInstrument::beginDraw()
+void MFDInstrument::setRefreshRate(double hz)
 {
-    if (gc && skpad)
-    {
-        skpad->beginDraw();
+    if (lDisplay != nullptr)
+        lDisplay->setRefreshRate(hz);
+}
 
-        return skpad;
-    }
-    return nullptr;
+// Mode, scale or reference changed - redraw all layers
+void MFDInstrument::invalidate()
+{
+    if (lStatic != nullptr)
+        lStatic->invalidate();
+    if (lDisplay != nullptr)
+        lDisplay->invalidate();
 }
 
-void MFDInstrument::endDraw(Sketchpad *skpad)
+// Displayed data changed - redraw at next update
+void MFDInstrument::invalidateDisplay()
 {
-    if (gc && skpad)
-        skpad->endDraw();
+    if (lDisplay != nullptr)
+        lDisplay->invalidate();
 }
 
-bool MFDInstrument::update()
+// Redraw layers that are dirty or due for refresh.
+// Returns true if anything was redrawn.
+bool MFDInstrument::update(double syst)
 {
+    bool redrawn = false;
 
-    if (Sketchpad *skp = beginDraw())
+    if (lStatic != nullptr && lStatic->isDue(syst))
     {
-        draw(skp);
-        endDraw(skp);
+        if (Sketchpad *skp = lStatic->beginDraw(syst))
+        {
+            // Character size of current display font
+            ch = skp->getCharSize();
+            cw = skp->getTextWidth("0");
+            if (ch <= 0 || cw <= 0)
+                ch = std::max(iHeight / 28, 1), cw = std::max(ch / 2, 1);
+            drawStatic(skp);
+            lStatic->endDraw();
+            redrawn = true;
+        }
     }
 
-    return false;
+    if (lDisplay != nullptr && lDisplay->isDue(syst))
+    {
+        if (Sketchpad *skp = lDisplay->beginDraw(syst))
+        {
+            draw(skp);
+            lDisplay->endDraw();
+            redrawn = true;
+        }
+    }
+
+    return redrawn;
+}
+
+// Composite cached layers onto panel every frame
+void MFDInstrument::render(Sketchpad *skpad, int x, int y)
+{
+    if (lStatic != nullptr)
+        lStatic->render(skpad, x, y);
+    if (lDisplay != nullptr)
+        lDisplay->render(skpad, x, y);
 }
 
 glm::dmat3 MFDInstrument::getRotMatrix(double coso, double sino, double cosp, double sinp, double cosi, double sini)
@@ -125,27 +183,28 @@ void MFDInstrument::updateEllipse(int xCenter, int yCenter, double scale, const
     const glm::dmat3 &rot, const glm::dmat3 &irot,  glm::dvec2 *pt)
 {
     glm::dvec3 vtx[NOREL];
-    double phi, sphi, cphi;
+    double sphi, cphi;
     double r, x, y;
-    double fac = (pi/2)/NOREL;
     double e2 = orbit.e * orbit.e;
+    double b = orbit.getSemiMinorAxis();
+    double le = orbit.getLinearEccentricity();
     glm::dvec3 an, dn;
 
     int idx1 = NOREL-1;
     int idx2 = NOREL4*2;
     int idx3 = idx2-1;
 
+    // Polar form about ellipse center, mirrored into four quadrants
     for (int idx = 0; idx < NOREL4; idx++)
     {
-        phi = (idx+0.5)*fac;
-        sphi = sin(phi), cphi = cos(phi);
-        r = orbit.getSemiMinorAxis() / sqrt(1.0 - e2*sphi*cphi);
+        sphi = ellipseTable.sphi[idx], cphi = ellipseTable.cphi[idx];
+        r = b / sqrt(1.0 - e2*cphi*cphi);
         x = r*cphi, y = r*sphi;
 
-        vtx[idx].x = vtx[idx1-idx].x = x - orbit.getLinearEccentricity();
-        vtx[idx].z = vtx[idx3-idx].z = y;
-        vtx[idx3-idx].x = vtx[idx2+idx].x = -x - orbit.getLinearEccentricity();
-        vtx[idx2+idx].z = vtx[idx1-idx].z = -y;
+        vtx[idx]       = {  x - le, 0.0,  y };
+        vtx[idx3-idx]  = { -x - le, 0.0,  y };
+        vtx[idx2+idx]  = { -x - le, 0.0, -y };
+        vtx[idx1-idx]  = {  x - le, 0.0, -y };
     }
 
     // Set orbital path line
@@ -175,25 +234,30 @@ void MFDInstrument::updateHyperboa(int xCenter, int yCenter, int iWidth, int iHe
     int idxh = NOREL2-1;
     glm::dvec3 vtx[NOREL-1];
     glm::dvec3 an, dn;
-    double phi, cphi, sphi;
+    double cphi, sphi, t;
     double r, x, y, len;
     double p = orbit.getPeriapsisDistance() * (1.0 + orbit.e);
     double radMax = 1.5 * xCenter / scale;
     double phiMax = acos((p / radMax - 1.0) / orbit.e);
     double fac = phiMax / (double)(NOREL2-1);
+    double cfac = cos(fac), sfac = sin(fac);
     bool anok, dnok;
 
-    vtx[idxh].x = orbit.getPeriapsisDistance();
-    vtx[idxh].y = 0.0;
+    vtx[idxh] = { orbit.getPeriapsisDistance(), 0.0, 0.0 };
 
+    // Step true anomaly by fixed angle - rotate (cos, sin)
+    // pair instead of evaluating trig functions per vertex.
+    cphi = 1.0, sphi = 0.0;
     for (int idx = 1; idx < NOREL2; idx++)
     {
-        phi = idx*fac;
-        sphi = sin(phi), cphi = cos(phi);
+        t = cphi*cfac - sphi*sfac;
+        sphi = sphi*cfac + cphi*sfac;
+        cphi = t;
+
         r = p / (1.0 + orbit.e * cphi);
         x = r * cphi, y = r * sphi;
-        vtx[idxh-idx].x = vtx[idxh+idx].x = x;
-        vtx[idxh-idx].z = -(vtx[idxh+idx].z = y);
+        vtx[idxh+idx] = { x, 0.0,  y };
+        vtx[idxh-idx] = { x, 0.0, -y };
     }
 
     for (int idx = 0; idx < NOREL-1; idx++)
@@ -8,6 +8,7 @@
 class OrbitalElements;
 class Vehicle;
 class Panel;
+class PanelLayer;
 class Pen;
 
 struct MFDSpec
@@ -30,24 +31,30 @@ struct DrawColor
 #define NOREL2  (NOREL/2)
 #define NOREL4  (NOREL/4)
 
+// Default display refresh rate [Hz]
+#define MFD_REFRESH_RATE    10.0
+
 class MFDInstrument
 {
 public:
 
     MFDInstrument(Panel *panel, const MFDSpec &spec, Vehicle *vehicle);
-    virtual ~MFDInstrument() = default;
+    virtual ~MFDInstrument();
 
-    static MFDInstrument *create(Panel *panel, const MFDSpec &spec);
     static void ginit(GraphicsClient *gc);
     static void gexit(GraphicsClient *gc);
 
     void init(const MFDSpec &spec);
-    Sketchpad *beginDraw();
-    void endDraw(Sketchpad *skpad);
     cchar_t *getButtonLabel(int idx);
 
+    void setRefreshRate(double hz);
+    void invalidate();
+    void invalidateDisplay();
+    void render(Sketchpad *skpad, int x, int y);
+
     // Virtual function calls
-    virtual bool update();
+    virtual bool update(double syst);
+    virtual void drawStatic(Sketchpad *skpad) { }
     virtual void draw(Sketchpad *skpad) = 0;
 
     virtual cchar_t *mfdGetButtonLabel(int idx) { return nullptr; }
@@ -67,7 +74,9 @@ protected:
     Panel *panel = nullptr;
     Vehicle *vehicle = nullptr;
     GraphicsClient *gc = nullptr;
-    Sketchpad *skpad = nullptr;
+
+    PanelLayer *lStatic = nullptr;      // grids, labels (redrawn on demand)
+    PanelLayer *lDisplay = nullptr;     // dynamic display (redrawn at refresh rate)
 
     int iWidth, iHeight;        // MFD instrument display size
     int cw, ch;                 // Character width/height of spedific font
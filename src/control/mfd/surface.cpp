@@ -34,6 +34,55 @@ cchar_t *MFDSurface::mfdGetButtonLabel(int idx)
     return nullptr;
 }
 
+bool MFDSurface::update(double syst)
+{
+    // Body name is part of static layer
+    const Celestial *ref = (vehicle != nullptr) ? vehicle->getOrbitalReference() : nullptr;
+    if (ref != refBody)
+    {
+        refBody = ref;
+        invalidate();
+    }
+
+    // Show touchdown or liftoff without waiting for refresh
+    int fs = (vehicle != nullptr) ? vehicle->getFlightStatus() : -1;
+    if (fs != fsLast)
+    {
+        fsLast = fs;
+        invalidateDisplay();
+    }
+
+    return MFDInstrument::update(syst);
+}
+
+static cchar_t *surfaceLabels[] = {
+    "Alt", "AGL", "GS", "AS", "Hdg", "Pch", "Bnk"
+};
+
+void MFDSurface::drawStatic(Sketchpad *skpad)
+{
+    str_t title = "Surface";
+    if (refBody != nullptr)
+        title += " " + refBody->getsName();
+    skpad->text(cw/2, 0, title);
+
+    int y = ch*2;
+    for (int idx = 0; idx < std::size(surfaceLabels); idx++, y += ch)
+        skpad->text(cw/2, y, surfaceLabels[idx]);
+}
+
 void MFDSurface::draw(Sketchpad *skpad)
 {
+    if (vehicle == nullptr || refBody == nullptr)
+        return;
+
+    csurface_t *sp = vehicle->getSurfaceParameters();
+    double values[] = {
+        sp->alt0, sp->alt, sp->groundSpeed, sp->airSpeed,
+        ofs::degrees(sp->heading), ofs::degrees(sp->pitch), ofs::degrees(sp->bank)
+    };
+
+    int x = cw * 5, y = ch*2;
+    for (int idx = 0; idx < std::size(values); idx++, y += ch)
+        skpad->text(x, y, std::format("{:.4g}", values[idx]));
 }
\ No newline at end of file
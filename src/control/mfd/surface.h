@@ -17,9 +17,14 @@ public:
 
     cchar_t *mfdGetButtonLabel(int idx) override;
 
+    bool update(double syst) override;
+
+    void drawStatic(Sketchpad *skpad) override;
     void draw(Sketchpad *skpad) override;
 
 private:
+    const Celestial *refBody = nullptr;
+    int fsLast = -1;                // flight status at last update
 
     int spdx0;
     int hrzx, hrzx0, hrzx1, hrzc;
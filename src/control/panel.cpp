@@ -12,6 +12,7 @@
 #include "control/ppanel.h"
 #include "control/gpanel.h"
 #include "hud/panel.h"
+#include "main/profiler.h"
 
 Panel::Panel(GraphicsClient *gclient, int w, int h, int d)
 : gc(gclient), width(w), height(h), depth(d)
@@ -21,6 +22,8 @@ Panel::Panel(GraphicsClient *gclient, int w, int h, int d)
     hud = nullptr;
     for (int idx = 0; idx < HUD_MAX; idx++)
         huds[idx] = nullptr;
+    for (int idx = 0; idx < PANEL_MAX; idx++)
+        panels[idx] = nullptr;
 
     if (gc != nullptr)
         bar = new TaskBar(this);
@@ -37,6 +40,11 @@ Panel::~Panel()
 
 void Panel::init(cjson &config)
 {
+    if (config.contains("panel")) {
+        cjson &pconfig = config["panel"];
+        refreshRate = myjson::getFloat<double>(pconfig, "refresh", PANEL_REFRESH_RATE);
+    }
+
     if (config.contains("huds")) {
         cjson &hconfig = config["huds"];
         assert(hconfig.is_array());
@@ -85,6 +93,9 @@ void Panel::resize(int w, int h)
     for (int idx = 0; idx < HUD_MAX; idx++)
         if (huds[idx] != nullptr)
             huds[idx]->resize(w, h);
+    for (int idx = 0; idx < PANEL_MAX; idx++)
+        if (panels[idx] != nullptr)
+            panels[idx]->resize(w, h);
 }
 
 void Panel::createPanel(int mode)
@@ -145,6 +156,7 @@ void Panel::setHUDMode(int mode)
     if (mode < HUD_MAX && huds[mode] != nullptr) {
         hud = huds[mode];
         hudMode = mode;
+        hud->invalidate();
     } else {
         hud = nullptr;
         hudMode = 0;
@@ -166,6 +178,8 @@ void Panel::switchHUDMode()
             break;
     }
     hud = huds[hudMode];
+    if (hud != nullptr)
+        hud->invalidate();
 }
 
 void Panel::setHUDColor(color_t penColor)
@@ -173,23 +187,31 @@ void Panel::setHUDColor(color_t penColor)
     if (hudPen != nullptr)
         delete hudPen;
     hudPen = gc->createPen(penColor, 4, 1);
+
+    for (auto hud : hudList)
+        if (hud != nullptr)
+            hud->invalidate();
 }
 
 
 void Panel::update(const Player &player, double simt, double syst)
 {
+    this->syst = syst;
     if (bar != nullptr)
         bar->update(player, simt);
 }
 
 void Panel::render(const Player &player)
 {
+    FrameScope scope(prfPanel);
     if (bar != nullptr)
         bar->render(player);
 }
 
 void Panel::drawHUD(Player &player)
 {
+    FrameScope scope(prfPanel);
+
     if (player.isExternal() && panelMode != PANEL_PLANET)
         return;
 
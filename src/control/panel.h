@@ -13,8 +13,12 @@
 #define PANEL_GENERIC   2
 #define PANEL_MAX       3
 
+// Default refresh rate of cached panel displays [Hz]
+#define PANEL_REFRESH_RATE  10.0
+
 class GraphicsClient;
 class Player;
+class PanelLayer;
 
 class TaskBar;
 class Panel;
@@ -40,6 +44,8 @@ public:
     // inline void switchHUDMode()     { setHUDMode(hudMode++ < HUD_MAX ? hudMode : HUD_NONE); }
     inline int getHUDMode() const   { return (hud != nullptr) ? hud->getMode() : HUD_NONE; }
     inline Pen *getHUDPen() const   { return hudPen; }
+    inline double getSysTime() const        { return syst; }
+    inline double getRefreshRate() const    { return refreshRate; }
 
     void togglePanelMode();
     void togglePlanetariumPanelMode();
@@ -61,6 +67,9 @@ private:
     int width, height;  // screen size
     int depth;          // color depth
 
+    double syst = 0.0;                          // system time at last update [s]
+    double refreshRate = PANEL_REFRESH_RATE;    // panel display refresh rate [Hz]
+
     GraphicsClient *gc = nullptr;
     Sketchpad *pad = nullptr;
     // Camera *camera = nullptr;
@@ -91,6 +100,7 @@ public:
         gc = panel->gc;
     }
 
+    virtual void resize(int w, int h) {};
     virtual void draw(Player &player, Sketchpad *pad) {};
 
 protected:
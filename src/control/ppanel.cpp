@@ -7,6 +7,7 @@
 #include "api/graphics.h"
 #include "api/draw.h"
 #include "control/panel.h"
+#include "control/layer.h"
 #include "control/ppanel.h"
 #include "ephem/elements.h"
 #include "engine/player.h"
@@ -20,13 +21,23 @@ PlanetPanel::PlanetPanel(Panel *panel)
 
 PlanetPanel::~PlanetPanel()
 {
-
+    if (layer != nullptr)
+        delete layer;
 }
 
 void PlanetPanel::initResources()
 {
     titleFont = gc->createFont("Arial", 80, false, Font::Bold);
     textFont = gc->createFont("Arial", 30, false);
+
+    layer = new PanelLayer(gc, panel->width, panel->height);
+    layer->setRefreshRate(panel->getRefreshRate());
+}
+
+void PlanetPanel::resize(int w, int h)
+{
+    if (layer != nullptr)
+        layer->resize(w, h);
 }
 
 void PlanetPanel::displayPlanetocentric(Sketchpad *pad, double lat, double lng, double alt)
@@ -68,11 +79,29 @@ void PlanetPanel::displayOrbitalElements(Sketchpad *pad, const OrbitalElements &
     pad->print("--------------------------");
 }
 
+// Text formatting and glyph layout are costly, so text
+// is drawn into cached layer at panel refresh rate only.
 void PlanetPanel::draw(Player &player, Sketchpad *pad)
 {
-    color_t col = { 0.40, 0.60, 1.0, 1.0 };
+    double syst = panel->getSysTime();
+    if (layer->isDue(syst))
+    {
+        if (Sketchpad *skp = layer->beginDraw(syst))
+        {
+            display(player, skp);
+            layer->endDraw();
+        }
+    }
 
     pad->beginDraw();
+    layer->render(pad, 0, 0);
+    pad->endDraw();
+}
+
+void PlanetPanel::display(Player &player, Sketchpad *pad)
+{
+    color_t col = { 0.40, 0.60, 1.0, 1.0 };
+
     pad->setFont(titleFont);
     pad->setTextColor(col);
     pad->setTextPos(5, 3);
@@ -110,6 +139,4 @@ void PlanetPanel::draw(Player &player, Sketchpad *pad)
     glm::dvec3 lpos = focus->convertGlobalToLocal(player.getPosition());
     glm::dvec3 loc = focus->convertLocalToEquatorial(lpos);
     displayPlanetocentric(pad, loc.x, loc.y, loc.z);
-
-    pad->endDraw();
 }
\ No newline at end of file
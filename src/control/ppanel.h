@@ -6,6 +6,7 @@
 #pragma once
 
 class OrbitalElements;
+class PanelLayer;
 class Font;
 
 class PlanetPanel : public PanelEx
@@ -14,14 +15,18 @@ public:
     PlanetPanel(Panel *panel);
     ~PlanetPanel();
 
+    void resize(int w, int h) override;
     void draw(Player &player, Sketchpad *pad) override;
 
 protected:
     void initResources();
+    void display(Player &player, Sketchpad *pad);
 
     void displayPlanetocentric(Sketchpad *pad, double lat, double lng, double alt);
     void displayOrbitalElements(Sketchpad *pad, const OrbitalElements &oel, double rad);
 
     Font *titleFont = nullptr;
     Font *textFont = nullptr;
+
+    PanelLayer *layer = nullptr;    // cached text display
 };
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "engine/celestial.h"
 #include "universe/astro.h"
 #include "utils/json.h"
+#include "main/checkpoint.h"
 
 Celestial::Celestial(cjson &config, ObjectType type, celType ctype)
 : Object(config, type), cbType(ctype)
@@ -129,6 +130,17 @@ void Celestial::attach(Celestial *parent, frameType type)
     }
 }
 
+// Laplace sphere of influence radius [km] with respect to
+// parent body. Uses current distance rather than semi-major
+// axis as ephemeris-driven bodies have no osculating elements.
+double Celestial::getSOIRadius() const
+{
+    if (cbody == nullptr || mass <= 0.0 || cbody->getMass() <= 0.0)
+        return 0.0;
+    double d = glm::length(s0->pos - cbody->s0->pos);
+    return d * pow(mass / cbody->getMass(), 0.4);
+}
+
 StateVectors Celestial::interpolateState(double step)
 {
     if (step == 0.0)
@@ -464,3 +476,38 @@ void Celestial::updatePostEphemeris()
     for (auto body : secondaries)
         body->updatePostEphemeris();
 }
+
+void Celestial::saveState(Checkpoint &cp) const
+{
+    Object::saveState(cp);
+
+    cp.write(oel);
+    cp.write(bOrbitalValid);
+    cp.write(brpos), cp.write(irpos);
+    cp.write(brvel), cp.write(irvel);
+    cp.write(cpos), cp.write(cvel);
+    cp.write(bpos), cp.write(bvel);
+    cp.write(bposofs), cp.write(bvelofs);
+    cp.write(crot), cp.write(rotofs);
+    cp.write(Recl), cp.write(Qecl);
+    cp.write(Lrel), cp.write(Dphi);
+}
+
+bool Celestial::restoreState(Checkpoint &cp)
+{
+    if (!Object::restoreState(cp))
+        return false;
+
+    cp.read(oel);
+    cp.read(bOrbitalValid);
+    cp.read(brpos), cp.read(irpos);
+    cp.read(brvel), cp.read(irvel);
+    cp.read(cpos), cp.read(cvel);
+    cp.read(bpos), cp.read(bvel);
+    cp.read(bposofs), cp.read(bvelofs);
+    cp.read(crot), cp.read(rotofs);
+    cp.read(Recl), cp.read(Qecl);
+    cp.read(Lrel), cp.read(Dphi);
+
+    return cp.isValid();
+}
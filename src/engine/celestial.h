@@ -91,9 +91,14 @@ public:
 
     void attach(Celestial *parent, frameType type = rfUniversal);
 
+    double getSOIRadius() const;
+
     StateVectors interpolateState(double step);
     glm::dvec3 interpolatePosition(double step) const;
 
+    void saveState(Checkpoint &cp) const override;
+    bool restoreState(Checkpoint &cp) override;
+
     void convertPolarToXYZ(double *pol, double *xyz, bool hpos, bool hvel);
     uint32_t getEphemerisState(double *res);
     bool updateEphemeris();
@@ -3,6 +3,8 @@
 // Author:  Tim Stark
 // Date:    Nov 5, 2023
 
+#define OFSAPI_SERVER_BUILD
+
 #include "main/core.h"
 #include "main/app.h"
 #include "api/graphics.h"
@@ -25,17 +27,30 @@ void Mesh::clear()
         delete group;
     }
     groups.clear();
+
+    for (auto mtrl : materials)
+        delete mtrl;
+    materials.clear();
+    txNames.clear();
 }
 
 void Mesh::setup()
 {
-
+    // Textures must be loaded by graphics thread, so defer
+    // them until mesh is first used.
+    std::call_once(txLoaded, [this] {
+        GraphicsClient *gclient = ofsAppCore != nullptr ? ofsAppCore->getClient() : nullptr;
+        if (gclient == nullptr)
+            return;
+        for (auto &tex : txNames)
+            txImages.push_back(gclient->loadTexture(tex.name, tex.flags | 8));
+    });
 }
 
 void Mesh::calculateNormals(MeshGroup *group, bool missing)
 {
     const float eps = 1e-8f;
-    uint16_t *idx = group->idx;
+    uint32_t *idx = group->idx;
     MeshVertex *vtx = group->vtx;
 
     for (int i = 0; i < group->nvtx; i++)
@@ -73,6 +88,47 @@ void Mesh::calculateNormals(MeshGroup *group, bool missing)
         vtx[i].nml /= glm::length(vtx[i].nml);
 }
 
+void Mesh::calculateTangents(MeshGroup *group)
+{
+    const float eps = 1e-12f;
+    uint32_t *idx = group->idx;
+    MeshVertex *vtx = group->vtx;
+
+    for (int i = 0; i < group->nvtx; i++)
+        vtx[i].tgt = glm::vec3(0.0f);
+
+    for (int i = 0; i < group->nidx; i += 3)
+    {
+        int i0 = idx[i+0], i1 = idx[i+1], i2 = idx[i+2];
+        glm::vec3 e1 = vtx[i1].vtx - vtx[i0].vtx;
+        glm::vec3 e2 = vtx[i2].vtx - vtx[i0].vtx;
+        glm::vec2 d1 = vtx[i1].tc - vtx[i0].tc;
+        glm::vec2 d2 = vtx[i2].tc - vtx[i0].tc;
+
+        float det = d1.x * d2.y - d2.x * d1.y;
+        if (fabs(det) < eps)
+            continue;
+        glm::vec3 tgt = (e1 * d2.y - e2 * d1.y) / det;
+        vtx[i0].tgt += tgt, vtx[i1].tgt += tgt, vtx[i2].tgt += tgt;
+    }
+
+    // Gram-Schmidt orthogonalize against normal
+    for (int i = 0; i < group->nvtx; i++)
+    {
+        glm::vec3 &n = vtx[i].nml;
+        glm::vec3 t = vtx[i].tgt - n * glm::dot(n, vtx[i].tgt);
+        float len = glm::length(t);
+        if (len > 0.0f)
+            vtx[i].tgt = t / len;
+        else
+        {
+            // Degenerate texture mapping - pick any perpendicular vector
+            glm::vec3 a = fabs(n.x) < 0.9f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+            vtx[i].tgt = glm::normalize(glm::cross(n, a));
+        }
+    }
+}
+
 void Mesh::addGroup(MeshGroup *group)
 {
     groups.push_back(group);
@@ -83,12 +139,19 @@ void Mesh::addMaterial(MeshMaterial *mtrl)
     materials.push_back(mtrl);
 }
 
+// Check that all indices refer to vertices of group
+static bool checkIndices(const uint32_t *idx, int nidx, int nvtx)
+{
+    return std::all_of(idx, idx + nidx, [nvtx](uint32_t i) { return i < uint32_t(nvtx); });
+}
+
 void Mesh::load(json &config, Mesh &mesh)
 {
     int nGroups;
     bool bStaticMesh;
 
     bStaticMesh = myjson::getBoolean<bool>(config, "StaticMesh", false);
+    mesh.bStaticMesh = bStaticMesh;
 
     if (!config["MeshData"].is_object())
         return;
@@ -105,7 +168,7 @@ void Mesh::load(json &config, Mesh &mesh)
         int texIndex = -1;
         int nvtx, nidx, ntri;
         MeshVertex *vtx = nullptr;
-        uint16_t *idx = nullptr;
+        uint32_t *idx = nullptr;
 
         uint32_t flags = bStaticMesh ? 4 : 0;
         uint32_t userFlags = 0;
@@ -148,7 +211,7 @@ void Mesh::load(json &config, Mesh &mesh)
         if (!entry["indices"].is_array())
             return;
         ntri = entry["indices"].size(), nidx = ntri * 3;
-        idx = new uint16_t[nidx];
+        idx = new uint32_t[nidx];
         memset(vtx, 0, sizeof(MeshVertex)*nvtx);
         for (int eidx = 0, jidx = 0; eidx < ntri; eidx++, jidx += 3)
         {
@@ -160,6 +223,14 @@ void Mesh::load(json &config, Mesh &mesh)
             idx[jidx+2] = value[2].get<double>();
         }
 
+        if (nvtx > 0 && nidx > 0 && !checkIndices(idx, nidx, nvtx))
+        {
+            ofsLogger->error("Mesh group {}: Vertex index out of range - skipped\n", gidx);
+            delete [] vtx;
+            delete [] idx;
+            nvtx = nidx = 0;
+        }
+
         if (nvtx > 0 && nidx > 0)
         {
             MeshGroup *group = new MeshGroup;
@@ -178,6 +249,7 @@ void Mesh::load(json &config, Mesh &mesh)
 
             if (bCalcNormals)
                 mesh.calculateNormals(group, true);
+            mesh.calculateTangents(group);
             mesh.addGroup(group);
         }
     }
@@ -203,22 +275,13 @@ void Mesh::load(json &config, Mesh &mesh)
     if (!config["Textures"].is_array())
         return;
     json tlist = config["Textures"];
-    GraphicsClient *gclient = ofsAppCore->getClient();
     for (int tidx = 0; tidx < tlist.size(); tidx++)
     {
         json entry = tlist[tidx];
-        Texture *txImage;
         str_t texName = myjson::getString<str_t>(entry, "texname");
         bool uncompress = myjson::getBoolean<bool>(entry, "uncompress", false);
-        int flags = uncompress ? 2 : 0;
-        if (gclient != nullptr)
-        {
-            txImage = gclient->loadTexture(texName, flags | 8);
-            txImages.push_back(txImage);
-        }
+        mesh.txNames.push_back({ texName, uint32_t(uncompress ? 2 : 0) });
     }
-
-    mesh.setup();
 }
 
 std::istream &operator >> (std::istream &is, Mesh &mesh)
@@ -249,7 +312,7 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
             break;
         }
         if (!strncmp(cbuf, "STATICMESH", 10))
-            bStaticMesh = true;
+            mesh.bStaticMesh = bStaticMesh = true;
     }
 
     // Read group list from file
@@ -268,7 +331,7 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
         int nidx = 0;
         int ntri = 0;
         MeshVertex *vtx = nullptr;
-        uint16_t *idx = nullptr;
+        uint32_t *idx = nullptr;
 
         for (;;)
         {
@@ -354,8 +417,8 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
                     }
                 }
 
-                idx = new uint16_t[nidx];
-                memset(idx, 0, sizeof(uint16_t)*nidx);
+                idx = new uint32_t[nidx];
+                memset(idx, 0, sizeof(uint32_t)*nidx);
                 int jidx = 0;
                 for (int iidx = 0; iidx < nidx; iidx++)
                 {
@@ -367,7 +430,7 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
                         nidx = 0;
                         break;
                     }
-                    int j = sscanf(cbuf, "%hd%hd%hd",
+                    int j = sscanf(cbuf, "%u%u%u",
                         idx+jidx+0, idx+jidx+1, idx+jidx+2);
                     jidx += 3;
                 }
@@ -376,7 +439,7 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
                 {
                     for (int i = 0; i < ntri; i++)
                     {
-                        uint16_t tmp = idx[i*3+1];
+                        uint32_t tmp = idx[i*3+1];
                         idx[i*3+1] = idx[i*3+2];
                         idx[i*3+2] = tmp;
                     }
@@ -386,6 +449,14 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
             }
         }
 
+        if (nvtx > 0 && nidx > 0 && !checkIndices(idx, nidx, nvtx))
+        {
+            ofsLogger->error("Mesh group {}: Vertex index out of range - skipped\n", gidx);
+            delete [] vtx;
+            delete [] idx;
+            nvtx = nidx = 0;
+        }
+
         if (nvtx > 0 && nidx > 0)
         {
             MeshGroup *group = new MeshGroup;
@@ -404,6 +475,7 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
 
             if (bCalcNormal)
                 mesh.calculateNormals(group, true);
+            mesh.calculateTangents(group);
             mesh.addGroup(group);
         }
     }
@@ -423,10 +495,11 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
         }
         for (int idx = 0; idx < nMaterials; idx++)
         {
-            mtrl = new MeshMaterial;
-            memset((void *)mtrl, 0, sizeof(MeshMaterial));
+            char name[256] = "";
+            mtrl = new MeshMaterial();
             is.getline(cbuf, sizeof(cbuf));
-            sscanf(cbuf+8, "%s", mtrl->name.data());
+            sscanf(cbuf+8, "%255s", name);
+            mtrl->name = name;
             is.getline(cbuf, sizeof(cbuf));
             sscanf(cbuf, "%f%f%f%f", &mtrl->diffuse.r, &mtrl->diffuse.g, &mtrl->diffuse.b, &mtrl->diffuse.a);
             is.getline(cbuf, sizeof(cbuf));
@@ -448,7 +521,6 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
     {
         std::string texName(256, '\0'), flagStr;
         bool uncompress = false;
-        GraphicsClient *gclient = ofsAppCore->getClient();
 
         for (int idx = 0; idx < nTextures; idx++)
         {
@@ -456,21 +528,169 @@ std::istream &operator >> (std::istream &is, Mesh &mesh)
             sscanf(cbuf, "%s%s", texName.data(), flagStr.data());
             if (!texName.empty())
                 uncompress = toupper(flagStr[0]) == 'D';
-            int flags = uncompress ? 2 : 0;
-            if (gclient != nullptr)
-            {
-                Texture *txImage = gclient->loadTexture(texName, flags | 8);
-                mesh.txImages.push_back(txImage);
-            }
+            mesh.txNames.push_back({ texName.c_str(), uint32_t(uncompress ? 2 : 0) });
         }
     }
 
-    mesh.setup();
-
     is.clear();
     return is;
 }
 
+// ******** Compiled mesh ********
+
+template <typename T>
+static inline void writeValue(std::ostream &os, const T &val)
+{
+    os.write((const char *)&val, sizeof(T));
+}
+
+template <typename T>
+static inline bool readValue(std::istream &is, T &val)
+{
+    return bool(is.read((char *)&val, sizeof(T)));
+}
+
+static void writeString(std::ostream &os, cstr_t &str)
+{
+    writeValue<uint32_t>(os, str.size());
+    os.write(str.data(), str.size());
+}
+
+static bool readString(std::istream &is, str_t &str)
+{
+    uint32_t len;
+    if (!readValue(is, len) || len > 4096)
+        return false;
+    str.resize(len);
+    return bool(is.read(str.data(), len));
+}
+
+bool Mesh::writeBinary(std::ostream &os) const
+{
+    MeshFileHeader hdr = { MESH_MAGIC, MESH_VERSION, sizeof(MeshFileHeader),
+        uint32_t(bStaticMesh ? MESH_STATIC : 0),
+        uint32_t(groups.size()), uint32_t(materials.size()), uint32_t(txNames.size()) };
+    writeValue(os, hdr);
+
+    for (auto group : groups)
+    {
+        // Store 16-bit indices when vertex count allows it
+        bool idx32 = group->nvtx > 0xFFFF;
+        MeshGroupHeader ghdr = { uint32_t(group->nvtx), uint32_t(group->nidx),
+            uint32_t(idx32 ? MESH_IDX32 : 0), group->Flags, group->userFlags,
+            group->texIndex, group->mtrlIndex };
+        writeValue(os, ghdr);
+
+        os.write((const char *)group->vtx, sizeof(MeshVertex) * group->nvtx);
+        if (idx32)
+            os.write((const char *)group->idx, sizeof(uint32_t) * group->nidx);
+        else
+        {
+            std::vector<uint16_t> idx(group->idx, group->idx + group->nidx);
+            os.write((const char *)idx.data(), sizeof(uint16_t) * idx.size());
+        }
+    }
+
+    for (auto mtrl : materials)
+    {
+        writeString(os, mtrl->name);
+        writeValue(os, mtrl->diffuse);
+        writeValue(os, mtrl->ambient);
+        writeValue(os, mtrl->specular);
+        writeValue(os, mtrl->emissive);
+        writeValue(os, mtrl->power);
+    }
+
+    for (auto &tex : txNames)
+    {
+        writeString(os, tex.name);
+        writeValue(os, tex.flags);
+    }
+
+    return !os.fail();
+}
+
+bool Mesh::readBinary(std::istream &is)
+{
+    MeshFileHeader hdr;
+
+    clear();
+
+    // Size of remaining stream for checking counts
+    // in file before allocating anything.
+    std::streamoff start = is.tellg();
+    is.seekg(0, std::ios::end);
+    uint64_t remain = uint64_t(is.tellg() - start);
+    is.seekg(start, std::ios::beg);
+    if (start < 0 || is.fail())
+        return false;
+
+    if (!readValue(is, hdr) || hdr.magic != MESH_MAGIC)
+        return false;
+    if (hdr.version != MESH_VERSION || hdr.size != sizeof(MeshFileHeader))
+        return false;
+    bStaticMesh = (hdr.flags & MESH_STATIC) != 0;
+    remain -= sizeof(hdr);
+
+    for (int gidx = 0; gidx < hdr.nGroups; gidx++)
+    {
+        MeshGroupHeader ghdr;
+        if (remain < sizeof(ghdr) || !readValue(is, ghdr))
+            return false;
+        remain -= sizeof(ghdr);
+
+        size_t szIndex = (ghdr.flags & MESH_IDX32) ? sizeof(uint32_t) : sizeof(uint16_t);
+        uint64_t size = uint64_t(ghdr.nvtx) * sizeof(MeshVertex) + uint64_t(ghdr.nidx) * szIndex;
+        if (size > remain || ghdr.nvtx > INT_MAX || ghdr.nidx > INT_MAX)
+            return false;
+        remain -= size;
+
+        MeshGroup *group = new MeshGroup;
+        group->nvtx = ghdr.nvtx;
+        group->nidx = ghdr.nidx;
+        group->vtx = new MeshVertex[ghdr.nvtx];
+        group->idx = new uint32_t[ghdr.nidx];
+        group->Flags = ghdr.Flags;
+        group->userFlags = ghdr.userFlags;
+        group->texIndex = ghdr.texIndex;
+        group->mtrlIndex = ghdr.mtrlIndex;
+        addGroup(group);
+
+        is.read((char *)group->vtx, sizeof(MeshVertex) * ghdr.nvtx);
+        if (ghdr.flags & MESH_IDX32)
+            is.read((char *)group->idx, sizeof(uint32_t) * ghdr.nidx);
+        else
+        {
+            std::vector<uint16_t> idx(ghdr.nidx);
+            is.read((char *)idx.data(), sizeof(uint16_t) * ghdr.nidx);
+            std::copy(idx.begin(), idx.end(), group->idx);
+        }
+        if (is.fail() || !checkIndices(group->idx, group->nidx, group->nvtx))
+            return false;
+    }
+
+    for (int midx = 0; midx < hdr.nMaterials; midx++)
+    {
+        MeshMaterial *mtrl = new MeshMaterial;
+        addMaterial(mtrl);
+        if (!readString(is, mtrl->name) ||
+            !readValue(is, mtrl->diffuse) || !readValue(is, mtrl->ambient) ||
+            !readValue(is, mtrl->specular) || !readValue(is, mtrl->emissive) ||
+            !readValue(is, mtrl->power))
+            return false;
+    }
+
+    for (int tidx = 0; tidx < hdr.nTextures; tidx++)
+    {
+        MeshTexture tex;
+        if (!readString(is, tex.name) || !readValue(is, tex.flags))
+            return false;
+        txNames.push_back(tex);
+    }
+
+    return true;
+}
+
 // ******** MeshManager ********
 
 MeshManager::~MeshManager()
@@ -480,21 +700,108 @@ MeshManager::~MeshManager()
 
 void MeshManager::cleanup()
 {
-    for (auto &mesh : meshList)
-        if (mesh != nullptr)
-            delete mesh;
-    meshList.clear();
+    std::unique_lock<std::mutex> lock(muCache);
+    for (auto &[path, entry] : meshCache)
+        delete entry.handle.get();
+    meshCache.clear();
 }
 
-const Mesh *MeshManager::loadMesh(cstr_t &fname)
+Mesh *MeshManager::readMesh(const fs::path &fname)
 {
-    using namespace std;
+    fs::path bname = fname;
+    std::error_code ec;
+
+    // Prefer compiled mesh when it is up to date
+    if (fname.extension() != ".mshb")
+    {
+        bname.replace_extension(".mshb");
+        if (!fs::exists(bname, ec) || fs::last_write_time(bname, ec) < fs::last_write_time(fname, ec))
+            bname.clear();
+    }
 
-    ifstream ifs(fname, ios::in);
     Mesh *mesh = new Mesh;
+    if (!bname.empty())
+    {
+        std::ifstream ifs(bname, std::ios::in|std::ios::binary);
+        if (ifs.is_open() && mesh->readBinary(ifs))
+            return mesh;
+        ofsLogger->warn("File '{}': Invalid compiled mesh - using source\n", bname.string());
+    }
+
+    std::ifstream ifs(fname, std::ios::in);
+    if (!ifs.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), strerror(errno));
+        delete mesh;
+        return nullptr;
+    }
     ifs >> *mesh;
 
-    meshList.push_back(mesh);
+    return mesh;
+}
+
+bool MeshManager::compileMesh(const fs::path &src, const fs::path &dst)
+{
+    Mesh *mesh = readMesh(src);
+    if (mesh == nullptr)
+        return false;
+
+    std::ofstream ofs(dst, std::ios::out|std::ios::binary);
+    if (!ofs.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", dst.string(), strerror(errno));
+        delete mesh;
+        return false;
+    }
+    bool ok = mesh->writeBinary(ofs);
+    delete mesh;
+
+    return ok;
+}
+
+MeshHandle MeshManager::loadMeshAsync(cstr_t &fname)
+{
+    std::error_code ec;
+    fs::path path = fs::weakly_canonical(fname, ec);
+    if (ec)
+        path = fname;
+
+    std::unique_lock<std::mutex> lock(muCache);
+    CacheEntry &entry = meshCache[path.string()];
+
+    // Failed load is not kept - users got no mesh to release,
+    // so drop their references and try again.
+    if (isMeshReady(entry.handle) && entry.handle.get() == nullptr)
+        entry.refs = 0;
+    if (entry.refs++ == 0)
+        entry.handle = std::async(std::launch::async, [path] { return readMesh(path); }).share();
+
+    return entry.handle;
+}
 
+const Mesh *MeshManager::loadMesh(cstr_t &fname)
+{
+    Mesh *mesh = loadMeshAsync(fname).get();
+    if (mesh != nullptr)
+        mesh->setup();
     return mesh;
-}
\ No newline at end of file
+}
+
+void MeshManager::releaseMesh(const Mesh *mesh)
+{
+    if (mesh == nullptr)
+        return;
+
+    std::unique_lock<std::mutex> lock(muCache);
+    for (auto it = meshCache.begin(); it != meshCache.end(); it++)
+    {
+        if (!isMeshReady(it->second.handle) || it->second.handle.get() != mesh)
+            continue;
+        if (--it->second.refs == 0)
+        {
+            delete mesh;
+            meshCache.erase(it);
+        }
+        return;
+    }
+}
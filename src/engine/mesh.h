@@ -5,10 +5,41 @@
 
 #pragma once
 
+#include <future>
+
+#define MESH_MAGIC          0x4248534d  // 'MSHB'
+#define MESH_VERSION        1
+
+#define MESH_STATIC         0x0001      // Static mesh
+#define MESH_IDX32          0x0001      // Group uses 32-bit indices in file
+
+// Compiled (binary) mesh file header
+struct MeshFileHeader
+{
+    uint32_t magic;         // mesh magic code
+    uint32_t version;       // mesh format version
+    uint32_t size;          // header size
+    uint32_t flags;         // mesh flags
+    uint32_t nGroups;       // number of groups
+    uint32_t nMaterials;    // number of materials
+    uint32_t nTextures;     // number of textures
+};
+
+struct MeshGroupHeader
+{
+    uint32_t nvtx, nidx;    // number of vertices/indices
+    uint32_t flags;         // index format flags
+    uint32_t Flags;         // group flags
+    uint32_t userFlags;     // user flags
+    int32_t  texIndex;      // texture index (-1 = none)
+    int32_t  mtrlIndex;     // material index (-1 = none)
+};
+
 struct MeshVertex
 {
     glm::vec3 vtx;
     glm::vec3 nml;
+    glm::vec3 tgt;
     glm::vec2 tc;
 };
 
@@ -16,7 +47,7 @@ struct MeshGroup
 {
     int nvtx, nidx;
     MeshVertex *vtx;
-    uint16_t *idx;
+    uint32_t *idx;
 
     uint32_t Flags;
     uint32_t userFlags;
@@ -34,9 +65,15 @@ struct MeshMaterial
     float       power;
 };
 
+struct MeshTexture
+{
+    str_t    name;
+    uint32_t flags;
+};
+
 class Texture;
 
-class Mesh
+class OFSAPI Mesh
 {
     friend std::istream &operator >> (std::istream &is, Mesh &mesh);
 
@@ -47,13 +84,21 @@ public:
     void setup();
     void clear();
 
+    bool readBinary(std::istream &is);
+    bool writeBinary(std::ostream &os) const;
+
     void addGroup(MeshGroup *group);
     void addMaterial(MeshMaterial *mtrl);
 
     inline int getGroupSize() const             { return groups.size(); }
     inline MeshGroup *getGroup(int idx)         { return idx < groups.size() ? groups[idx] : nullptr; }
+    inline const MeshMaterial *getMaterial(int idx) const
+        { return idx >= 0 && idx < materials.size() ? materials[idx] : nullptr; }
+    inline Texture *getTexture(int idx) const
+        { return idx >= 0 && idx < txImages.size() ? txImages[idx] : nullptr; }
 
     void calculateNormals(MeshGroup *group, bool missing);
+    void calculateTangents(MeshGroup *group);
 
     void load(json &config, Mesh &mesh);
 
@@ -62,10 +107,27 @@ public:
 private:
     std::vector<MeshGroup *> groups;
     std::vector<MeshMaterial *> materials;
+    std::vector<MeshTexture> txNames;
     std::vector<Texture *> txImages;
+    std::once_flag txLoaded;
+    bool bStaticMesh = false;
 };
 
-class MeshManager
+using MeshHandle = std::shared_future<Mesh *>;
+
+inline bool isMeshReady(const MeshHandle &handle)
+{
+    return handle.valid() &&
+        handle.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+// Shared mesh cache
+//
+// Meshes are keyed by canonical path and reference counted, so
+// many vehicles using same mesh file parse it only once. Parsing
+// runs in background - textures are loaded later by setup() on
+// caller (render) thread.
+class OFSAPI MeshManager
 {
 public:
     MeshManager() = default;
@@ -74,7 +136,19 @@ public:
     void cleanup();
 
     const Mesh *loadMesh(cstr_t &fname);
+    MeshHandle loadMeshAsync(cstr_t &fname);
+    void releaseMesh(const Mesh *mesh);
+
+    static Mesh *readMesh(const fs::path &fname);
+    static bool compileMesh(const fs::path &src, const fs::path &dst);
 
 private:
-    std::vector<Mesh *> meshList;
+    struct CacheEntry
+    {
+        MeshHandle handle;
+        int refs = 0;
+    };
+
+    std::mutex muCache;
+    std::map<str_t, CacheEntry> meshCache;
 };
\ No newline at end of file
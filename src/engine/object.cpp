@@ -8,6 +8,7 @@
 #include "main/core.h"
 #include "engine/object.h"
 #include "utils/json.h"
+#include "main/checkpoint.h"
 
 Object::Object(const cstr_t &name, ObjectType type)
 : objType(type)
@@ -96,6 +97,39 @@ void Object::flipStateVectors()
         s0 = sv, s1 = sv+1;
 }
 
+void Object::saveState(Checkpoint &cp) const
+{
+    cp.write(sv[0]);
+    cp.write(sv[1]);
+    cp.write<int>(s0 - sv);
+    cp.write(mass);
+    cp.write(baryPosition);
+    cp.write(baryVelocity);
+    cp.write(rposBase), cp.write(rposAdd);
+    cp.write(rvelBase), cp.write(rvelAdd);
+    cp.write(rrotBase), cp.write(rrotAdd);
+}
+
+bool Object::restoreState(Checkpoint &cp)
+{
+    int idx = 0;
+    cp.read(sv[0]);
+    cp.read(sv[1]);
+    cp.read(idx);
+    cp.read(mass);
+    cp.read(baryPosition);
+    cp.read(baryVelocity);
+    cp.read(rposBase), cp.read(rposAdd);
+    cp.read(rvelBase), cp.read(rvelAdd);
+    cp.read(rrotBase), cp.read(rrotAdd);
+
+    // Checkpoints are taken between time steps (s1 disabled)
+    s0 = sv + (idx & 1);
+    s1 = nullptr;
+
+    return cp.isValid();
+}
+
 void Object::updateCullingRadius()
 {
     cullingRadius = getBoundingRadius();
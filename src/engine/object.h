@@ -10,6 +10,7 @@
 class Orbit;
 class Rotation;
 class Frame;
+class Checkpoint;
 
 class OFSAPI StateVectors
 {
@@ -99,6 +100,10 @@ public:
     void initStateVectors();
     void flipStateVectors();
 
+    // Checkpoint save/restore
+    virtual void saveState(Checkpoint &cp) const;
+    virtual bool restoreState(Checkpoint &cp);
+
 private:
     ObjectType objType = objUnknown;
     std::vector<str_t> objNames{1};
@@ -9,6 +9,7 @@
 #include "ephem/rotation.h"
 #include "universe/psystem.h"
 #include "universe/frame.h"
+#include "main/checkpoint.h"
 
 RigidBody::RigidBody(cjson &config, ObjectType type, celType celtype)
 : Celestial(config, type, celtype)
@@ -160,7 +161,7 @@ void RigidBody::update(bool force)
         getIntermediateMoments(acc, tau, *s1, 1, dt);
         bOrbitNotInitialized = false;
 
-        arot = computeEulerInverseFull(tau, s1->omega);
+        arot = computeEulerInverse(tau, s1->omega);
         // arot = computeEulerInverseSimple(tau, s1->omega);
         cpos += acc;
         s1->omega += arot;
@@ -193,4 +194,31 @@ void RigidBody::update(bool force)
         cpos = s1->pos - cbody->s1->pos;
         cvel = s1->vel - cbody->s1->vel;
     }
-}
\ No newline at end of file
+}
+
+void RigidBody::saveState(Checkpoint &cp) const
+{
+    Celestial::saveState(cp);
+
+    cp.write(bDynamicForce);
+    cp.write(bOrbitNotInitialized);
+    cp.write(bIgnoreGravTorque);
+    cp.write(cpos), cp.write(cvel);
+    cp.write(acc), cp.write(arot);
+    cp.write(pmi), cp.write(torque);
+}
+
+bool RigidBody::restoreState(Checkpoint &cp)
+{
+    if (!Celestial::restoreState(cp))
+        return false;
+
+    cp.read(bDynamicForce);
+    cp.read(bOrbitNotInitialized);
+    cp.read(bIgnoreGravTorque);
+    cp.read(cpos), cp.read(cvel);
+    cp.read(acc), cp.read(arot);
+    cp.read(pmi), cp.read(torque);
+
+    return cp.isValid();
+}
@@ -43,9 +43,14 @@ public:
     glm::dvec3 computeEulerInverseZero(const glm::dvec3 &tau, const glm::dvec3 &omega);
     glm::dvec3 computeEulerInverseSimple(const glm::dvec3 &tau, const glm::dvec3 &omega);
     glm::dvec3 computeEulerInverseFull(const glm::dvec3 &tau, const glm::dvec3 &omega);
+    virtual glm::dvec3 computeEulerInverse(const glm::dvec3 &tau, const glm::dvec3 &omega)
+        { return computeEulerInverseFull(tau, omega); }
 
     virtual void update(bool force) override;
 
+    void saveState(Checkpoint &cp) const override;
+    bool restoreState(Checkpoint &cp) override;
+
     virtual void getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt);
  
 protected:
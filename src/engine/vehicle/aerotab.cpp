@@ -0,0 +1,143 @@
+// aerotab.cpp - Vehicle package - aerodynamic coefficient tables
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "engine/vehicle/aerotab.h"
+
+AeroTable::AeroTable(const std::vector<double> &aoa, const std::vector<double> &mach,
+    const std::vector<double> &re, const std::vector<double> &defl)
+{
+    axes[axAOA].nodes = aoa;
+    axes[axMach].nodes = mach;
+    axes[axDefl].nodes = defl;
+    for (auto r : re)
+        axes[axRe].nodes.push_back(log10(std::max(r, 1.0)));
+
+    // Angle of attack is innermost - neighbors
+    // in that direction share cache lines.
+    int size = 1;
+    for (auto &axis : axes)
+    {
+        if (axis.nodes.empty())
+            axis.nodes.push_back(0.0);
+        axis.stride = size;
+        size *= axis.nodes.size();
+    }
+    coeffs.resize(size, { 0, 0, 0 });
+}
+
+// Find lower node and fraction, clamped to axis range
+int AeroTable::axis_t::find(double x, double &f) const
+{
+    int n = nodes.size();
+    if (n < 2)
+    {
+        f = 0.0;
+        return 0;
+    }
+
+    int idx = std::upper_bound(nodes.begin(), nodes.end(), x) - nodes.begin() - 1;
+    idx = std::clamp(idx, 0, n - 2);
+    f = std::clamp((x - nodes[idx]) / (nodes[idx+1] - nodes[idx]), 0.0, 1.0);
+    return idx;
+}
+
+void AeroTable::setCoeffs(int iaoa, int imach, int ire, int idefl,
+    double cl, double cm, double cd)
+{
+    coeffs[index(iaoa, imach, ire, idefl)] = { float(cl), float(cm), float(cd) };
+}
+
+// Fill table from module callback. Callbacks have no
+// deflection input, so results are the same along that axis.
+void AeroTable::sample(affuncx_t cf, Vehicle *vehicle, void *ctx)
+{
+    for (int ire = 0; ire < axes[axRe].nodes.size(); ire++)
+    {
+        double Re = pow(10.0, axes[axRe].nodes[ire]);
+        for (int imach = 0; imach < axes[axMach].nodes.size(); imach++)
+            for (int iaoa = 0; iaoa < axes[axAOA].nodes.size(); iaoa++)
+            {
+                double cl = 0, cm = 0, cd = 0;
+                cf(vehicle, axes[axAOA].nodes[iaoa], axes[axMach].nodes[imach], Re, ctx, cl, cm, cd);
+                for (int idefl = 0; idefl < axes[axDefl].nodes.size(); idefl++)
+                    setCoeffs(iaoa, imach, ire, idefl, cl, cm, cd);
+            }
+    }
+}
+
+void AeroTable::getCoeffs(double aoa, double M, double Re, double defl,
+    double &cl, double &cm, double &cd) const
+{
+    double x[axMax] = { aoa, M, log10(std::max(Re, 1.0)), defl };
+    double f[axMax];
+    int base = 0, step[axMax];
+
+    for (int ax = 0; ax < axMax; ax++)
+    {
+        base += axes[ax].find(x[ax], f[ax]) * axes[ax].stride;
+        step[ax] = (axes[ax].nodes.size() > 1) ? axes[ax].stride : 0;
+    }
+
+    // Blend 16 corners of enclosing cell
+    float scl = 0, scm = 0, scd = 0;
+    for (int corner = 0; corner < (1 << axMax); corner++)
+    {
+        double w = 1.0;
+        int idx = base;
+        for (int ax = 0; ax < axMax; ax++)
+        {
+            if (corner & (1 << ax))
+                w *= f[ax], idx += step[ax];
+            else
+                w *= 1.0 - f[ax];
+        }
+        if (w == 0.0)
+            continue;
+
+        const coeff_t &c = coeffs[idx];
+        scl += w * c.cl, scm += w * c.cm, scd += w * c.cd;
+    }
+
+    cl = scl, cm = scm, cd = scd;
+}
+
+const AeroTable *AeroTable::getSampled(affuncx_t cf, Vehicle *vehicle, void *ctx)
+{
+    static std::map<std::pair<affuncx_t, void *>, std::unique_ptr<AeroTable>> tables;
+    static std::mutex muTables;
+
+    // Default grid - finer around stall, Mach 1 and
+    // one node per decade of Reynolds number.
+    static std::vector<double> aoaNodes, machNodes = {
+        0.0, 0.3, 0.6, 0.8, 0.9, 0.95, 1.0, 1.05,
+        1.1, 1.2, 1.5, 2.0, 3.0, 5.0, 10.0, 25.0
+    };
+    static const std::vector<double> reNodes = { 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+
+    std::unique_lock<std::mutex> lock(muTables);
+
+    // Tables are shared between vehicles using same
+    // callback and context (same vehicle class).
+    std::unique_ptr<AeroTable> &table = tables[{ cf, ctx }];
+    if (table != nullptr)
+        return table.get();
+
+    if (aoaNodes.empty())
+    {
+        for (int deg = -180; deg < -30; deg += 10)
+            aoaNodes.push_back(ofs::radians(double(deg)));
+        for (int deg = -30; deg < 30; deg += 2)
+            aoaNodes.push_back(ofs::radians(double(deg)));
+        for (int deg = 30; deg <= 180; deg += 10)
+            aoaNodes.push_back(ofs::radians(double(deg)));
+    }
+
+    table = std::make_unique<AeroTable>(aoaNodes, machNodes, reNodes);
+    table->sample(cf, vehicle, ctx);
+    return table.get();
+}
@@ -0,0 +1,57 @@
+// aerotab.h - Vehicle package - aerodynamic coefficient tables
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#include "engine/vehicle/vehicle.h"
+
+// Airfoil coefficient table over angle of attack, Mach number,
+// Reynolds number and control surface deflection. Lookups are
+// multilinear with no callbacks, so tables can be evaluated from
+// any thread once filled. Reynolds axis is interpolated in log10.
+// Axes with a single node are constant along that dimension.
+class AeroTable
+{
+public:
+    AeroTable(const std::vector<double> &aoa, const std::vector<double> &mach,
+        const std::vector<double> &re, const std::vector<double> &defl = { 0.0 });
+
+    inline int getSize() const      { return coeffs.size(); }
+
+    void setCoeffs(int iaoa, int imach, int ire, int idefl,
+        double cl, double cm, double cd);
+    void sample(affuncx_t cf, Vehicle *vehicle, void *ctx);
+
+    void getCoeffs(double aoa, double M, double Re, double defl,
+        double &cl, double &cm, double &cd) const;
+
+    // Shared table sampled from module callback on default grid
+    static const AeroTable *getSampled(affuncx_t cf, Vehicle *vehicle, void *ctx);
+
+private:
+    enum { axAOA, axMach, axRe, axDefl, axMax };
+
+    struct coeff_t
+    {
+        float cl, cm, cd;
+    };
+
+    struct axis_t
+    {
+        std::vector<double> nodes;
+        int stride;
+
+        int find(double x, double &f) const;
+    };
+
+    inline int index(int iaoa, int imach, int ire, int idefl) const
+    {
+        return iaoa * axes[axAOA].stride + imach * axes[axMach].stride +
+            ire * axes[axRe].stride + idefl * axes[axDefl].stride;
+    }
+
+    axis_t axes[axMax];
+    std::vector<coeff_t> coeffs;
+};
@@ -45,6 +45,9 @@ void Vehicle::configure(cjson &config, Celestial *object)
     loadModule(modName);
 
     setClassCaps();
+    if (myjson::getBoolean<bool>(config, "aero-tables", false))
+        tabulateAirfoils();
+    bEnableCoast = myjson::getBoolean<bool>(config, "coast", true);
     
     // Setup flight status
     str_t stName = myjson::getString<str_t>(config, "status");
@@ -0,0 +1,191 @@
+// contact.cpp - Vehicle package - touchdown contact solver
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "engine/vehicle/vehicle.h"
+#include "engine/vehicle/contact.h"
+#include "universe/elevmgr.h"
+
+void ContactSolver::setup(const tdVertex_t *tdvtx, int ntd)
+{
+    px.resize(ntd), py.resize(ntd), pz.resize(ntd);
+    stiffness.resize(ntd), damping.resize(ntd);
+    mulat.resize(ntd), mulng.resize(ntd);
+    pe.resize(ntd), pn.resize(ntd);
+    elev.resize(ntd), fn.resize(ntd);
+    flat.resize(ntd), flng.resize(ntd);
+    locs.resize(ntd);
+
+    kTotal = 0.0;
+    for (int idx = 0; idx < ntd; idx++)
+    {
+        px[idx] = tdvtx[idx].pos.x;
+        py[idx] = tdvtx[idx].pos.y;
+        pz[idx] = tdvtx[idx].pos.z;
+        stiffness[idx] = tdvtx[idx].stiffness;
+        damping[idx] = tdvtx[idx].damping;
+        mulat[idx] = tdvtx[idx].mulat;
+        mulng[idx] = tdvtx[idx].mulng;
+        kTotal += stiffness[idx];
+    }
+    nContacts = 0;
+}
+
+void ContactSolver::setFriction(double lat, double lng)
+{
+    std::fill(mulat.begin(), mulat.end(), lat);
+    std::fill(mulng.begin(), mulng.end(), lng);
+}
+
+// Horizontal offsets of touchdown points from CG for heading
+void ContactSolver::rotatePoints(double c, double s)
+{
+    int n = px.size();
+    for (int idx = 0; idx < n; idx++)
+    {
+        pe[idx] = px[idx]*c + pz[idx]*s;
+        pn[idx] = pz[idx]*c - px[idx]*s;
+    }
+}
+
+void ContactSolver::queryElevation(const groundState_t &gs, double rad, const ElevationManager *emgr,
+    int rlod, elevTileList_t *tiles)
+{
+    int n = px.size();
+    rotatePoints(cos(gs.heading), sin(gs.heading));
+
+    if (emgr == nullptr)
+    {
+        std::fill(elev.begin(), elev.end(), 0.0);
+        return;
+    }
+
+    double rlng = 1.0 / (rad * std::max(cos(gs.lat), 1e-6));
+    for (int idx = 0; idx < n; idx++)
+        locs[idx] = { gs.lat + pn[idx]/rad, gs.lng + pe[idx]*rlng, 0.0 };
+    emgr->getElevationData(locs.data(), elev.data(), n, rlod, tiles);
+}
+
+// CG altitude at which lowest touchdown point rests on ground
+double ContactSolver::getRestAltitude(const groundState_t &gs, double rad, const ElevationManager *emgr,
+    int rlod, elevTileList_t *tiles)
+{
+    int n = px.size();
+    if (n == 0)
+        return gs.alt;
+
+    queryElevation(gs, rad, emgr, rlod, tiles);
+    double alt = -std::numeric_limits<double>::infinity();
+    for (int idx = 0; idx < n; idx++)
+        alt = std::max(alt, elev[idx] - py[idx]);
+    return alt;
+}
+
+// Advance ground state by dt with external force F (vessel frame) and
+// yaw torque. Returns true if any touchdown point is in contact.
+bool ContactSolver::update(double dt, groundState_t &gs, double mass, double iyaw,
+    const glm::dvec3 &F, double tyaw, double g, double rad, const ElevationManager *emgr,
+    int rlod, elevTileList_t *tiles)
+{
+    int n = px.size();
+    nContacts = 0;
+    if (n == 0 || dt <= 0.0 || mass <= 0.0)
+        return false;
+
+    // One elevation batch per step - ground under
+    // points barely moves within sub-steps.
+    queryElevation(gs, rad, emgr, rlod, tiles);
+
+    // Sub-steps resolve gear oscillation for friction, heave is
+    // implicit and needs no sub-steps for stability.
+    int nsub = std::clamp(int(ceil(2.0 * dt * sqrt(kTotal / mass))), 1, CONTACT_MAX_SUBSTEPS);
+    double h = dt / nsub;
+    if (iyaw <= 0.0)
+        iyaw = mass;
+
+    for (int step = 0; step < nsub; step++)
+    {
+        double c = cos(gs.heading), s = sin(gs.heading);
+
+        // External force in horizon frame
+        glm::dvec3 Fh = { F.x*c + F.z*s, F.y - mass*g, F.z*c - F.x*s };
+
+        // Spring deflection (kept in fn) and contact stiffness/damping
+        double K = 0.0, C = 0.0, Fs = 0.0;
+        for (int idx = 0; idx < n; idx++)
+        {
+            double d = std::max(elev[idx] - py[idx] - gs.alt, 0.0);
+            double on = d > 0.0 ? 1.0 : 0.0;
+            fn[idx] = d;
+            K  += on * stiffness[idx];
+            C  += on * damping[idx];
+            Fs += stiffness[idx] * d;
+        }
+
+        // Heave - linearly implicit Euler on spring-damper
+        // m (v1 - v0)/h = Fy + Fs - K h v1 - C v1
+        double vy = (mass*gs.vel.y + h*(Fh.y + Fs)) / (mass + h*C + h*h*K);
+
+        // Normal loads after heave update, never pulling
+        for (int idx = 0; idx < n; idx++)
+        {
+            double on = fn[idx] > 0.0 ? 1.0 : 0.0;
+            fn[idx] = on * std::max(stiffness[idx]*(fn[idx] - h*vy) - damping[idx]*vy, 0.0);
+        }
+
+        // Regularized Coulomb friction in lateral and longitudinal
+        // direction of vessel frame. Slip is taken from velocity
+        // external forces alone would give, so friction also holds
+        // vehicle at rest below breakaway force.
+        double w = gs.yawRate;
+        double vlat = gs.vel.x*c - gs.vel.z*s;
+        double vlng = gs.vel.x*s + gs.vel.z*c;
+        double vplat = vlat + h*F.x/mass;
+        double vplng = vlng + h*F.z/mass;
+        double wp = w + h*tyaw/iyaw;
+        for (int idx = 0; idx < n; idx++)
+        {
+            flat[idx] = -mulat[idx] * fn[idx] *
+                std::clamp((vplat + wp*pz[idx]) / CONTACT_SLIP_SPEED, -1.0, 1.0);
+            flng[idx] = -mulng[idx] * fn[idx] *
+                std::clamp((vplng - wp*px[idx]) / CONTACT_SLIP_SPEED, -1.0, 1.0);
+        }
+
+        double FLAT = 0.0, FLNG = 0.0, TQ = 0.0;
+        for (int idx = 0; idx < n; idx++)
+        {
+            FLAT += flat[idx];
+            FLNG += flng[idx];
+            TQ   += pz[idx]*flat[idx] - px[idx]*flng[idx];
+        }
+
+        // Friction can at most stop motion within sub-step
+        double mlat = -(vlat*mass/h + F.x);
+        double mlng = -(vlng*mass/h + F.z);
+        double mtq  = -(w*iyaw/h + tyaw);
+        FLAT = std::clamp(FLAT, std::min(mlat, 0.0), std::max(mlat, 0.0));
+        FLNG = std::clamp(FLNG, std::min(mlng, 0.0), std::max(mlng, 0.0));
+        TQ   = std::clamp(TQ, std::min(mtq, 0.0), std::max(mtq, 0.0));
+
+        double FE = FLAT*c + FLNG*s;
+        double FN = FLNG*c - FLAT*s;
+
+        gs.vel.x += h * (Fh.x + FE) / mass;
+        gs.vel.z += h * (Fh.z + FN) / mass;
+        gs.vel.y  = vy;
+        gs.yawRate += h * (tyaw + TQ) / iyaw;
+
+        gs.alt += h * vy;
+        gs.lat += h * gs.vel.z / rad;
+        gs.lng += h * gs.vel.x / (rad * std::max(cos(gs.lat), 1e-6));
+        gs.heading = fmod(gs.heading + h * gs.yawRate + pi2, pi2);
+    }
+
+    for (int idx = 0; idx < n; idx++)
+        nContacts += fn[idx] > 0.0;
+    return nContacts > 0;
+}
@@ -0,0 +1,70 @@
+// contact.h - Vehicle package - touchdown contact solver
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+class ElevationManager;
+struct tdVertex_t;
+
+#define CONTACT_MAX_SUBSTEPS    16      // Sub-step limit per time step
+#define CONTACT_SLIP_SPEED      0.05    // Friction regularization speed [m/s]
+#define CONTACT_REST_SPEED      0.01    // Ground speed to come to rest [m/s]
+
+// Vehicle state on ground in local horizon frame at CG
+// (x = east, y = up, z = north). Pitch and bank follow horizon.
+struct groundState_t
+{
+    double lat = 0.0, lng = 0.0;    // position [rad]
+    double alt = 0.0;               // CG altitude above mean radius [m]
+    double heading = 0.0;           // compass heading [rad]
+    glm::dvec3 vel = {};            // ground velocity in horizon frame [m/s]
+    double yawRate = 0.0;           // heading rate [rad/s]
+};
+
+// Touchdown points of one vehicle stored as structure of arrays.
+// All points are transformed and sent to elevation manager as one
+// batch per time step. Spring-damper and friction forces are then
+// evaluated in branch-free loops over contiguous arrays. Heave is
+// integrated linearly implicit so that stiff gear stays stable at
+// any step size, and step is split into sub-steps for friction.
+class ContactSolver
+{
+public:
+    ContactSolver() = default;
+    ~ContactSolver() = default;
+
+    void setup(const tdVertex_t *tdvtx, int ntd);
+    void setFriction(double mulat, double mulng);
+
+    inline int getSize() const          { return px.size(); }
+    inline int getContactCount() const  { return nContacts; }
+
+    double getRestAltitude(const groundState_t &gs, double rad, const ElevationManager *emgr,
+        int rlod, elevTileList_t *tiles);
+    bool update(double dt, groundState_t &gs, double mass, double iyaw, const glm::dvec3 &F,
+        double tyaw, double g, double rad, const ElevationManager *emgr, int rlod,
+        elevTileList_t *tiles);
+
+private:
+    void rotatePoints(double c, double s);
+    void queryElevation(const groundState_t &gs, double rad, const ElevationManager *emgr,
+        int rlod, elevTileList_t *tiles);
+
+    // Touchdown points (vessel frame) [m]
+    std::vector<double> px, py, pz;
+    std::vector<double> stiffness;      // spring stiffness [N/m]
+    std::vector<double> damping;        // damping [N s/m]
+    std::vector<double> mulat, mulng;   // lateral/longitudinal friction
+
+    // Per step scratch arrays
+    std::vector<double> pe, pn;         // east/north offsets from CG [m]
+    std::vector<double> elev;           // ground elevation [m]
+    std::vector<double> fn;             // normal force [N]
+    std::vector<double> flat, flng;     // lateral/longitudinal friction [N]
+    std::vector<glm::dvec3> locs;       // elevation query locations
+
+    double kTotal = 0.0;                // sum of stiffness [N/m]
+    int nContacts = 0;                  // points in contact last step
+};
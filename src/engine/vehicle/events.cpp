@@ -0,0 +1,253 @@
+// events.cpp - Vehicle package - trajectory event detection
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "engine/celestial.h"
+#include "engine/vehicle/vehicle.h"
+#include "ephem/elements.h"
+#include "universe/astro.h"
+#include "universe/body.h"
+#include "universe/psystem.h"
+
+#define EVT_MAX_DEPTH   12      // Bracketing subdivision limit
+#define EVT_SAFETY      1.5     // Safety factor of rate bounds
+#define EVT_TOLERANCE   1e-3    // Event time tolerance [s]
+
+static const char *evtNames[] = {
+    "none", "SOI exit", "SOI entry", "atmosphere entry",
+    "atmosphere exit", "impact", "periapsis", "apoapsis"
+};
+
+// Time span of current step. Remote systems skipping
+// time steps span several frames.
+static double getStepTime(const pSystem *psys)
+{
+    return (psys != nullptr) ? psys->getStepTime() : ofsDate->getSimDeltaTime1();
+}
+
+// Cubic Hermite state between s0 and s1 at step fraction n
+static void interpolateHermite(const StateVectors &s0, const StateVectors &s1,
+    double dt, double n, glm::dvec3 &pos, glm::dvec3 &vel)
+{
+    double n2 = n*n, n3 = n2*n;
+    pos = s0.pos*(2*n3 - 3*n2 + 1) + s0.vel*(dt*(n3 - 2*n2 + n)) +
+          s1.pos*(3*n2 - 2*n3) + s1.vel*(dt*(n3 - n2));
+    vel = (s1.pos - s0.pos)*((6*n - 6*n2) / dt) +
+          s0.vel*(3*n2 - 4*n + 1) + s1.vel*(3*n2 - 2*n);
+}
+
+// Event function over step fraction n. Radial events are
+// distance to body minus radius, apsis events are r.v with
+// respect to body. Rate is upper bound of |dg/dn| over step.
+struct evtFunc_t
+{
+    const StateVectors &vs0, &vs1;  // vehicle at step start/end
+    const Celestial *body;          // body event is measured from
+    double dt;                      // step length [s]
+    double radius;                  // crossing radius [km] (0 = apsis)
+    double rate;                    // bound of |dg/dn|
+    vehEventType_t up, down;        // events on rising/falling crossing
+
+    evtFunc_t(const StateVectors &s0, const StateVectors &s1, const Celestial *body,
+        double dt, double radius, vehEventType_t up, vehEventType_t down)
+    : vs0(s0), vs1(s1), body(body), dt(dt), radius(radius), up(up), down(down)
+    {
+        double v = std::max(glm::length(s0.vel - body->s0->vel),
+                            glm::length(s1.vel - body->s1->vel));
+        if (radius > 0.0)
+            rate = v * dt * EVT_SAFETY;
+        else
+        {
+            // d(r.v)/dt = v^2 + r.a with |r.a| = mu/r
+            double mu = astro::G * body->getMass() / (M_PER_KM*M_PER_KM*M_PER_KM);
+            double r = std::max(body->getRadius(), std::min(
+                glm::length(s0.pos - body->s0->pos), glm::length(s1.pos - body->s1->pos)));
+            rate = (v*v + mu/r) * dt * EVT_SAFETY;
+        }
+    }
+
+    double eval(double n) const
+    {
+        glm::dvec3 pv, vv, pb, vb;
+        interpolateHermite(vs0, vs1, dt, n, pv, vv);
+        interpolateHermite(*body->s0, *body->s1, dt, n, pb, vb);
+        if (radius > 0.0)
+            return glm::length(pv - pb) - radius;
+        return glm::dot(pv - pb, vv - vb);
+    }
+};
+
+// Illinois regula falsi on sign change in [a,b]. Returns end
+// past crossing so that state lands on far side of event.
+static double refineCrossing(const evtFunc_t &f, double a, double ga, double b, double gb)
+{
+    double tol = EVT_TOLERANCE / f.dt;
+    int side = 0;
+
+    for (int iter = 0; iter < 50 && (b - a) > tol; iter++)
+    {
+        double n = (a*gb - b*ga) / (gb - ga);
+        double gn = f.eval(n);
+        if (gn == 0.0)
+            return n;
+        if ((gn < 0.0) == (ga < 0.0))
+        {
+            a = n, ga = gn;
+            if (side == -1)
+                gb *= 0.5;
+            side = -1;
+        }
+        else
+        {
+            b = n, gb = gn;
+            if (side == 1)
+                ga *= 0.5;
+            side = 1;
+        }
+    }
+    return b;
+}
+
+// Quick distance bound - sphere of given radius about body
+// cannot be reached within step from start distance.
+static bool isReachable(const StateVectors &s0, const StateVectors &s1, const Celestial *body,
+    double dt, double radius)
+{
+    double v = std::max(glm::length(s0.vel - body->s0->vel),
+                        glm::length(s1.vel - body->s1->vel));
+    return glm::length(s0.pos - body->s0->pos) - radius <= v * dt * EVT_SAFETY;
+}
+
+// Earliest crossing in [a,b]. Same-sign intervals are split
+// while rate bound cannot rule out a double crossing, so short
+// encounters inside one step are still caught.
+static bool findCrossing(const evtFunc_t &f, double a, double ga, double b, double gb,
+    int depth, double &n)
+{
+    if (ga != 0.0 && (ga < 0.0) != (gb < 0.0))
+    {
+        n = refineCrossing(f, a, ga, b, gb);
+        return true;
+    }
+    if (fabs(ga) + fabs(gb) > f.rate * (b - a) || depth >= EVT_MAX_DEPTH)
+        return false;
+
+    double m = (a + b) * 0.5, gm = f.eval(m);
+    return findCrossing(f, a, ga, m, gm, depth+1, n) ||
+           findCrossing(f, m, gm, b, gb, depth+1, n);
+}
+
+// Scan current step (s0 to s1) for entry interface, impact, apsis
+// and sphere of influence crossings with respect to reference body
+// and its secondaries. Returns earliest event of step.
+bool Vehicle::detectEvents(vehEvent_t &ev) const
+{
+    double dt = getStepTime(system);
+    if (cbody == nullptr || dt <= 0.0)
+        return false;
+
+    double t0 = ofsDate->getSimTime1() - dt;
+    double nev = 1.0;
+    ev = {};
+
+    auto record = [&](vehEventType_t type, double n, Celestial *target)
+    {
+        if (type == evtNone || (ev.type != evtNone && n >= nev))
+            return;
+        nev = n;
+        ev = { type, t0 + n*dt, target };
+    };
+
+    auto check = [&](const evtFunc_t &f, Celestial *target)
+    {
+        double n, ga = f.eval(0.0);
+        if (findCrossing(f, 0.0, ga, 1.0, f.eval(1.0), 0, n))
+            record((ga < 0.0) ? f.up : f.down, n, target);
+    };
+
+    double rsoi;
+    if (bCoasting)
+    {
+        // Coast mode ends before any radius crossing of reference
+        // body (predictCoastEvent), so only apsis passages remain
+        // and those follow from orbital elements.
+        double tp = oel.getTimeToApsis(t0, false);
+        double ta = oel.getTimeToApsis(t0, true);
+        if (tp >= 0.0 && tp <= dt)
+            record(evtPeriapsis, tp / dt, cbody);
+        if (ta >= 0.0 && ta <= dt)
+            record(evtApoapsis, ta / dt, cbody);
+    }
+    else
+    {
+        double R = cbody->getRadius();
+        const CelestialPlanet *planet = dynamic_cast<const CelestialPlanet *>(cbody);
+        if (planet != nullptr && planet->hasAtmosphere())
+            check(evtFunc_t(*s0, *s1, cbody, dt, R + std::min(planet->getAtmConstants().altLimit,
+                COAST_ENTRY_ALT), evtAtmExit, evtAtmEntry), cbody);
+        check(evtFunc_t(*s0, *s1, cbody, dt, R + surfParam.elev, evtNone, evtImpact), cbody);
+
+        // r.v has no sign change on circular orbits but its
+        // rate bound forces full subdivision - skip them.
+        glm::dvec3 r = s1->pos - cbody->s1->pos;
+        glm::dvec3 v = s1->vel - cbody->s1->vel;
+        double mu = astro::G * cbody->getMass() / (M_PER_KM*M_PER_KM*M_PER_KM);
+        double e = glm::length((glm::dot(v, v) - mu/glm::length(r))*r - glm::dot(r, v)*v) / mu;
+        if (e >= E_CIRCLE_LIMIT)
+            check(evtFunc_t(*s0, *s1, cbody, dt, 0.0, evtPeriapsis, evtApoapsis), cbody);
+
+        if ((rsoi = cbody->getSOIRadius()) > 0.0)
+            check(evtFunc_t(*s0, *s1, cbody, dt, rsoi, evtSOIExit, evtNone), cbody->getParent());
+    }
+
+    for (auto sec : cbody->getSecondaries())
+    {
+        if (sec->getCelestialType() < cbPlanet || (rsoi = sec->getSOIRadius()) <= 0.0)
+            continue;
+        if (!isReachable(*s0, *s1, sec, dt, rsoi))
+            continue;
+        check(evtFunc_t(*s0, *s1, sec, dt, rsoi, evtNone, evtSOIEntry), sec);
+    }
+
+    return ev.type != evtNone;
+}
+
+// Sphere of influence transitions re-reference orbit at event
+// time and propagate rest of step about new body, so state lands
+// on event without shortening global time step. Impact stops free
+// flight at event time and hands state over to ground contact.
+// Other events are only recorded for vehicle modules.
+void Vehicle::processEvent(const vehEvent_t &ev)
+{
+    lastEvent = ev;
+    ofsLogger->debug("{}: {} ({}) at {:.3f}\n", getsName(),
+        evtNames[ev.type], ev.body->getsName(), ev.t);
+
+    if (ev.type != evtSOIExit && ev.type != evtSOIEntry && ev.type != evtImpact)
+        return;
+
+    double dt = getStepTime(system);
+    double n = (ev.t - (ofsDate->getSimTime1() - dt)) / dt;
+    glm::dvec3 pv, vv, pb, vb;
+    interpolateHermite(*s0, *s1, dt, n, pv, vv);
+    interpolateHermite(*ev.body->s0, *ev.body->s1, dt, n, pb, vb);
+
+    if (ev.type == evtImpact)
+    {
+        touchdown(pv - pb, vv - vb);
+        return;
+    }
+
+    setOrbitReference(ev.body);
+    oel.determine(pv - pb, vv - vb, ev.t);
+    bOrbitalValid = true;
+    bCoasting = false;
+
+    oel.update(ofsDate->getSimTime1(), cpos, cvel);
+    s1->pos = cbody->s1->pos + cpos;
+    s1->vel = cbody->s1->vel + cvel;
+}
@@ -0,0 +1,171 @@
+// proximity.cpp - Vehicle package - broad-phase proximity index
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "engine/vehicle/vehicle.h"
+#include "engine/vehicle/proximity.h"
+
+// Docked members of one assembly never collide with each other
+static inline bool isSameAssembly(const Vehicle *veh1, const Vehicle *veh2)
+{
+    return veh1->getSuperVehicle() != nullptr &&
+        veh1->getSuperVehicle() == veh2->getSuperVehicle();
+}
+
+// New state during update, current state otherwise
+static inline const StateVectors &getState(const Vehicle *veh)
+{
+    return veh->s1 != nullptr ? *veh->s1 : *veh->s0;
+}
+
+void ProximityIndex::refresh(entry_t &e) const
+{
+    e.pos = getState(e.vehicle).pos;
+    e.radius = e.vehicle->getRadius();
+    e.lo = e.pos[axis] - e.radius;
+    e.hi = e.pos[axis] + e.radius;
+}
+
+void ProximityIndex::add(Vehicle *vehicle)
+{
+    entry_t e;
+    e.vehicle = vehicle;
+    refresh(e);
+    maxRadius = std::max(maxRadius, e.radius);
+
+    auto it = std::upper_bound(entries.begin(), entries.end(), e.lo,
+        [](double lo, const entry_t &e) { return lo < e.lo; });
+    entries.insert(it, e);
+}
+
+bool ProximityIndex::remove(Vehicle *vehicle)
+{
+    return std::erase_if(entries, [vehicle](const entry_t &e) { return e.vehicle == vehicle; }) > 0;
+}
+
+void ProximityIndex::update()
+{
+    if (entries.empty())
+        return;
+
+    // Choose axis with largest spread so that
+    // fewest entries overlap along sweep axis.
+    glm::dvec3 pmin = getState(entries[0].vehicle).pos, pmax = pmin;
+    for (auto &e : entries)
+    {
+        pmin = glm::min(pmin, getState(e.vehicle).pos);
+        pmax = glm::max(pmax, getState(e.vehicle).pos);
+    }
+    glm::dvec3 ext = pmax - pmin;
+    int naxis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : (ext.y >= ext.z) ? 1 : 2;
+    bool resort = naxis != axis;
+    axis = naxis;
+
+    maxRadius = 0.0;
+    for (auto &e : entries)
+    {
+        refresh(e);
+        maxRadius = std::max(maxRadius, e.radius);
+    }
+
+    if (resort)
+    {
+        std::sort(entries.begin(), entries.end(),
+            [](const entry_t &a, const entry_t &b) { return a.lo < b.lo; });
+        return;
+    }
+
+    // Nearly sorted from last step - insertion sort
+    for (int idx = 1; idx < entries.size(); idx++)
+    {
+        entry_t e = entries[idx];
+        int jdx = idx - 1;
+        for (; jdx >= 0 && entries[jdx].lo > e.lo; jdx--)
+            entries[jdx+1] = entries[jdx];
+        entries[jdx+1] = e;
+    }
+}
+
+// All vehicles whose bounding sphere is within range of position
+void ProximityIndex::findInRange(const glm::dvec3 &pos, double range,
+    std::vector<Vehicle *> &list, const Vehicle *exclude) const
+{
+    // Entries overlapping [p-range, p+range] start no lower
+    // than p-range-2*maxRadius along sweep axis.
+    double p = pos[axis];
+    auto it = std::lower_bound(entries.begin(), entries.end(), p - range - 2.0*maxRadius,
+        [](const entry_t &e, double lo) { return e.lo < lo; });
+
+    for (; it != entries.end() && it->lo <= p + range; it++)
+    {
+        if (it->vehicle == exclude || it->hi < p - range)
+            continue;
+        if (glm::length(it->pos - pos) <= range + it->radius)
+            list.push_back(it->vehicle);
+    }
+}
+
+void ProximityIndex::findInRange(const Vehicle *vehicle, double range, std::vector<Vehicle *> &list) const
+{
+    findInRange(getState(vehicle).pos, range + vehicle->getRadius(), list, vehicle);
+}
+
+// Vehicle pairs with overlapping bounding spheres
+void ProximityIndex::findContactPairs(std::vector<vehPair_t> &pairs) const
+{
+    for (int idx = 0; idx < entries.size(); idx++)
+    {
+        const entry_t &a = entries[idx];
+        for (int jdx = idx + 1; jdx < entries.size() && entries[jdx].lo <= a.hi; jdx++)
+        {
+            const entry_t &b = entries[jdx];
+            if (isSameAssembly(a.vehicle, b.vehicle))
+                continue;
+            if (glm::length(b.pos - a.pos) <= a.radius + b.radius)
+                pairs.push_back({ a.vehicle, b.vehicle });
+        }
+    }
+}
+
+// Docking port pairs within range of each other, nearest first
+void ProximityIndex::findDockingPairs(double range, std::vector<dockPair_t> &pairs) const
+{
+    size_t first = pairs.size();
+
+    for (int idx = 0; idx < entries.size(); idx++)
+    {
+        const entry_t &a = entries[idx];
+        if (a.vehicle->getPortCount() == 0)
+            continue;
+
+        for (int jdx = idx + 1; jdx < entries.size() && entries[jdx].lo <= a.hi + range; jdx++)
+        {
+            const entry_t &b = entries[jdx];
+            if (b.vehicle->getPortCount() == 0 || isSameAssembly(a.vehicle, b.vehicle))
+                continue;
+            if (glm::length(b.pos - a.pos) > a.radius + b.radius + range)
+                continue;
+
+            // Port positions are in vessel frame [m]
+            const StateVectors &sa = getState(a.vehicle), &sb = getState(b.vehicle);
+            for (int pa = 0; pa < a.vehicle->getPortCount(); pa++)
+            {
+                glm::dvec3 gpa = sa.pos + (sa.R * a.vehicle->getPort(pa)->port) / M_PER_KM;
+                for (int pb = 0; pb < b.vehicle->getPortCount(); pb++)
+                {
+                    glm::dvec3 gpb = sb.pos + (sb.R * b.vehicle->getPort(pb)->port) / M_PER_KM;
+                    double dist = glm::length(gpb - gpa);
+                    if (dist <= range)
+                        pairs.push_back({ a.vehicle, pa, b.vehicle, pb, dist });
+                }
+            }
+        }
+    }
+
+    std::sort(pairs.begin() + first, pairs.end(),
+        [](const dockPair_t &a, const dockPair_t &b) { return a.dist < b.dist; });
+}
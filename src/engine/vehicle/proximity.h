@@ -0,0 +1,59 @@
+// proximity.h - Vehicle package - broad-phase proximity index
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+class Vehicle;
+
+struct dockPair_t
+{
+    Vehicle *vehicle1;      // first vehicle
+    int port1;              // docking port on first vehicle
+    Vehicle *vehicle2;      // second vehicle
+    int port2;              // docking port on second vehicle
+    double dist;            // port distance [km]
+};
+
+using vehPair_t = std::pair<Vehicle *, Vehicle *>;
+
+// Sweep and prune over vehicle bounding spheres. Entries are kept
+// sorted by lower bound along axis of largest spread. Vehicles move
+// little per step, so insertion sort restores order in near linear
+// time. Range queries binary search sweep axis, pair queries sweep
+// sorted list once. Bounds are refreshed from s1 state vectors.
+class ProximityIndex
+{
+public:
+    ProximityIndex() = default;
+    ~ProximityIndex() = default;
+
+    void add(Vehicle *vehicle);
+    bool remove(Vehicle *vehicle);
+
+    inline int getSize() const          { return entries.size(); }
+
+    void update();
+
+    void findInRange(const glm::dvec3 &pos, double range, std::vector<Vehicle *> &list,
+        const Vehicle *exclude = nullptr) const;
+    void findInRange(const Vehicle *vehicle, double range, std::vector<Vehicle *> &list) const;
+    void findContactPairs(std::vector<vehPair_t> &pairs) const;
+    void findDockingPairs(double range, std::vector<dockPair_t> &pairs) const;
+
+private:
+    struct entry_t
+    {
+        double lo, hi;          // bounds along sweep axis [km]
+        glm::dvec3 pos;         // center (global frame) [km]
+        double radius;          // bounding radius [km]
+        Vehicle *vehicle;
+    };
+
+    void refresh(entry_t &e) const;
+
+    std::vector<entry_t> entries;   // sorted by lo
+    int axis = 0;                   // sweep axis
+    double maxRadius = 0.0;         // largest bounding radius [km]
+};
@@ -11,6 +11,19 @@
 #include "engine/rigidbody.h"
 #include "engine/vehicle/vehicle.h"
 #include "engine/vehicle/svehicle.h"
+#include "universe/psystem.h"
+#include "main/checkpoint.h"
+
+SuperVehicle::SuperVehicle(Vehicle *vehicle)
+: RigidBody(vehicle->getsName(), objVehicle, cbVehicle)
+{
+    attach(vehicle);
+}
+
+SuperVehicle::SuperVehicle(cstr_t &name)
+: RigidBody(name, objVehicle, cbVehicle)
+{
+}
 
 SuperVehicle::SuperVehicle(json &config)
 : RigidBody(config, objVehicle, cbVehicle)
@@ -18,18 +31,25 @@ SuperVehicle::SuperVehicle(json &config)
     
 }
 
-bool SuperVehicle::addVehicle(Vehicle *vehicle1, int port1, Vehicle *vehicle2, int port2)
+int SuperVehicle::findVehicle(const Vehicle *vehicle) const
 {
-    int vidx;
-    for (vidx = 0; vidx < vehicles.size(); vidx++)
-        if (vehicles[vidx] == vehicle1)
-            break;
-    if (vidx == vehicles.size())
-        return false;
+    for (int vidx = 0; vidx < vlist.size(); vidx++)
+        if (vlist[vidx].vehicle == vehicle)
+            return vidx;
+    return -1;
+}
 
-    VehicleList entry;
-    
-    entry.vehicle = vehicle2;
+// Relative position/orientation of vehicle2 in assembly
+// frame when its port2 is mated with port1 of vehicle1
+bool SuperVehicle::getDockTransform(Vehicle *vehicle1, int port1, Vehicle *vehicle2, int port2,
+    glm::dvec3 &rpos, glm::dmat3 &rrot) const
+{
+    int vidx = findVehicle(vehicle1);
+    if (vidx < 0)
+        return false;
+    if (port1 < 0 || port1 >= vehicle1->ports.size() ||
+        port2 < 0 || port2 >= vehicle2->ports.size())
+        return false;
 
     glm::dvec3 as = vehicle2->ports[port2]->dir;
     glm::dvec3 bs = vehicle2->ports[port2]->rot;
@@ -75,71 +95,314 @@ bool SuperVehicle::addVehicle(Vehicle *vehicle1, int port1, Vehicle *vehicle2, i
                bt.z * (as.y*cs.x - as.x*cs.y) +
                at.z * (bs.x*cs.y - bs.y*cs.x)) / den;
 
-    entry.rrot = R * vlist[vidx].rrot;
+    rrot = R * vlist[vidx].rrot;
+    rpos = vlist[vidx].rpos + (vlist[vidx].rrot * vehicle1->ports[port1]->port) -
+        (rrot * vehicle2->ports[port2]->port);
+
+    return true;
+}
+
+bool SuperVehicle::addVehicle(Vehicle *vehicle1, int port1, Vehicle *vehicle2, int port2)
+{
+    if (vehicle2->superVehicle != nullptr)
+        return false;
+
+    VehicleList entry;
+
+    entry.vehicle = vehicle2;
+    if (!getDockTransform(vehicle1, port1, vehicle2, port2, entry.rpos, entry.rrot))
+        return false;
     entry.rq = entry.rrot;
-    entry.rpos = vlist[vidx].rpos + (vlist[vidx].rrot * vehicle1->ports[port1]->port) -
-        (entry.rrot * vehicle2->ports[port2]->port);
 
-    // Vehicle2->setSuperVehicle(this);
+    // Docked vehicle momentum goes into assembly
+    double vmass = vehicle2->getMass();
+    if (mass + vmass > 0.0)
+    {
+        glm::dvec3 vel = (s0->vel * mass + vehicle2->s0->vel * vmass) / (mass + vmass);
+        cvel = vel - cbody->s0->vel;
+        bOrbitNotInitialized = true;
+    }
+
+    vlist.push_back(entry);
+    vehicle2->superVehicle = this;
+
+    return true;
+}
+
+// Merge other assembly through vehicle2 (member of other) docking
+// with vehicle1 (member of this). Other assembly is left empty.
+bool SuperVehicle::merge(Vehicle *vehicle1, int port1, SuperVehicle *other, Vehicle *vehicle2, int port2)
+{
+    if (other == this)
+        return false;
+    int oidx = other->findVehicle(vehicle2);
+    if (oidx < 0)
+        return false;
+
+    glm::dvec3 rpos;
+    glm::dmat3 rrot;
+    if (!getDockTransform(vehicle1, port1, vehicle2, port2, rpos, rrot))
+        return false;
+
+    double omass = other->getMass();
+    if (mass + omass > 0.0)
+    {
+        glm::dvec3 vel = (s0->vel * mass + other->s0->vel * omass) / (mass + omass);
+        cvel = vel - cbody->s0->vel;
+        bOrbitNotInitialized = true;
+    }
+
+    // Re-express other members relative to vehicle2
+    const VehicleList &odata = other->vlist[oidx];
+    glm::dmat3 orot = rrot * glm::transpose(odata.rrot);
+    for (auto &vdata : other->vlist)
+    {
+        VehicleList entry;
+        entry.vehicle = vdata.vehicle;
+        entry.rrot = orot * vdata.rrot;
+        entry.rq = entry.rrot;
+        entry.rpos = rpos + orot * (vdata.rpos - odata.rpos);
+        vlist.push_back(entry);
+        vdata.vehicle->superVehicle = this;
+    }
+    other->vlist.clear();
 
     return true;
 }
 
+// Attach root vehicle - assembly takes over its state vectors
 void SuperVehicle::attach(Vehicle *vehicle)
 {
-    // if (Vehicle->superVehicle == nullptr)
-    //     addVehicle(Vehicle);
+    if (!vlist.empty() || vehicle->superVehicle != nullptr)
+        return;
+
+    s0->set(*vehicle->s0);
+    s1->set(vehicle->s1 != nullptr ? *vehicle->s1 : *vehicle->s0);
+    setOrbitReference(vehicle->cbody);
+    cpos = vehicle->cpos;
+    cvel = vehicle->cvel;
+    mass = vehicle->getMass();
+    cg = {};
+    bOrbitNotInitialized = true;
+
+    vlist.push_back({ vehicle, {}, glm::dmat3(1.0), glm::dquat(1, 0, 0, 0) });
+    vehicle->superVehicle = this;
 }
 
 void SuperVehicle::detach(Vehicle *vehicle)
 {
-    for (std::vector<Vehicle *>::iterator p = vehicles.begin(); p != vehicles.end(); ++p)
-        if (*p == vehicle) {
-            vehicles.erase(p);
-            break;
-        }
+    int vidx = findVehicle(vehicle);
+    if (vidx < 0)
+        return;
+
+    // Detached vehicle continues on its own orbit
+    // from last state derived from assembly.
+    vehicle->cpos = vehicle->s0->pos - vehicle->cbody->s0->pos;
+    vehicle->cvel = vehicle->s0->vel - vehicle->cbody->s0->vel;
+    vehicle->bOrbitNotInitialized = true;
+    vehicle->bCoasting = false;
+    vehicle->superVehicle = nullptr;
+
+    vlist.erase(vlist.begin() + vidx);
+}
+
+void SuperVehicle::detachAll()
+{
+    while (!vlist.empty())
+        detach(vlist.back().vehicle);
 }
 
-void SuperVehicle::getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double dt)
+void SuperVehicle::getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt)
 {
+    acc = {};
+    am = {};
+
+    // Gravity torque with full inertia tensor
+    if (cbody != nullptr && !bIgnoreGravTorque) {
+        glm::dvec3 R0 = glm::transpose(state.R) * ((cbody->s1->pos - state.pos) * M_PER_KM);
+        double r0 = glm::length(R0);
+        glm::dvec3 Re = R0/r0;
+        double mag = 3.0 * (astro::G * cbody->getMass()) / (r0*r0*r0);
+        am = glm::cross(inertia*Re, Re) * mag;
+    }
 
+    // Collected forces from all docked vehicles
+    acc += state.Q * F/mass;
+    am  += L/mass;
+}
+
+glm::dvec3 SuperVehicle::computeEulerInverse(const glm::dvec3 &tau, const glm::dvec3 &omega)
+{
+    // Tensor form of computeEulerInverseFull - docked
+    // assemblies are not aligned with principal axes.
+    return inertiaInv * (tau + glm::cross(omega, inertia*omega));
 }
 
 void SuperVehicle::updateGlobal(const glm::dvec3 &rpos, const glm::dvec3 &rvel)
 {
+    RigidBody::updateGlobal(rpos, rvel);
+    cpos = s0->pos - cbody->s0->pos;
+    cvel = s0->vel - cbody->s0->vel;
+    bOrbitNotInitialized = true;
+
+    for (auto &vdata : vlist)
+        updateVehicleState(vdata.vehicle);
+}
+
+// Derive docked vehicle state vectors from assembly
+void SuperVehicle::updateVehicleState(Vehicle *vehicle)
+{
+    int vidx = findVehicle(vehicle);
+    if (vidx < 0)
+        return;
+
+    const VehicleList &vdata = vlist[vidx];
+    const StateVectors &s = getStateVector();
+    StateVectors &vs = vehicle->getStateVector();
+    glm::dvec3 d = (vdata.rpos - cg) / M_PER_KM;
 
+    vs.R = s.R * vdata.rrot;
+    vs.Q = s.Q * vdata.rq;
+    vs.pos = s.pos + s.R * d;
+    vs.vel = s.vel + s.R * glm::cross(s.omega, d);
+    vs.omega = glm::transpose(vdata.rrot) * s.omega;
 }
 
 void SuperVehicle::updateMassCG()
 {
-    mass = 0.0;
+    double nmass = 0.0;
     glm::dvec3 ncg = { 0, 0, 0};
-    for(auto vdata : vlist)
+    for(auto &vdata : vlist)
     {
         double vmass = vdata.vehicle->getMass();
-        mass += vmass;
-        ncg  += vdata.rpos * vmass;
+        nmass += vmass;
+        ncg   += vdata.rpos * vmass;
     }
-    ncg /= mass;
+    if (nmass <= 0.0)
+        return;
+    ncg /= nmass;
 
     // Shift center gravity for superVehicle position
-    // glm::dvec3 dp = s0->R * (cg - ncg);
-    // s0->pos += dp;
-    // rposAdd += dp;
-    // cpos += dp;
+    glm::dvec3 dp = s0->R * (ncg - cg) / M_PER_KM;
+    if (dp.x || dp.y || dp.z) {
+        s0->pos += dp;
+        cpos += dp;
+        bOrbitNotInitialized = true;
+    }
 
     // Update center gravity
+    mass = nmass;
     cg = ncg;
 }
 
+// Combined inertia tensor at assembly CG from member
+// principal moments and port transforms (parallel axis)
+void SuperVehicle::updateInertia()
+{
+    glm::dmat3 I(0.0);
+    for (auto &vdata : vlist)
+    {
+        Vehicle *veh = vdata.vehicle;
+        glm::dvec3 d = vdata.rpos - cg;
+
+        glm::dmat3 Ip(0.0);
+        Ip[0][0] = veh->pmi.x;
+        Ip[1][1] = veh->pmi.y;
+        Ip[2][2] = veh->pmi.z;
+
+        glm::dmat3 Iv = vdata.rrot * Ip * glm::transpose(vdata.rrot);
+        glm::dmat3 Id = glm::dmat3(glm::dot(d, d)) - glm::outerProduct(d, d);
+        I += (Iv + Id) * veh->getMass();
+    }
+
+    inertia = I / mass;
+    inertiaInv = (glm::determinant(inertia) != 0.0)
+        ? glm::inverse(inertia) : glm::dmat3(0.0);
+    pmi = { inertia[0][0], inertia[1][1], inertia[2][2] };
+}
+
 void SuperVehicle::update(bool force)
 {
+    if (vlist.empty())
+        return;
 
     updateMassCG();
+    updateInertia();
+
+    // Collect forces and torques from docked vehicles
+    // in assembly frame. Vehicle forces are reset later
+    // in their own update calls.
+    F = {};
+    L = {};
+    for (auto &vdata : vlist)
+    {
+        Vehicle *veh = vdata.vehicle;
+        glm::dvec3 f = vdata.rrot * veh->cflin;
+        F += f;
+        L += vdata.rrot * veh->camom + glm::cross(f, (vdata.rpos - cg) / M_PER_KM);
+    }
 
+    // One integration step for whole assembly
+    RigidBody::update(force);
 }
 
 void SuperVehicle::updatePost()
 {
     
-}
\ No newline at end of file
+}
+
+void SuperVehicle::saveState(Checkpoint &cp) const
+{
+    RigidBody::saveState(cp);
+
+    cp.write(cg);
+    cp.write<uint32_t>(vlist.size());
+    for (auto &vdata : vlist)
+    {
+        cp.writeString(vdata.vehicle->getsName());
+        cp.write(vdata.rpos);
+        cp.write(vdata.rrot);
+        cp.write(vdata.rq);
+    }
+}
+
+// Members are looked up by name in planetary system - assembly
+// must be registered with its system before restoring.
+bool SuperVehicle::restoreState(Checkpoint &cp)
+{
+    if (!RigidBody::restoreState(cp) || system == nullptr)
+        return false;
+
+    uint32_t count = 0;
+    cp.read(cg);
+    cp.read(count);
+
+    for (int idx = 0; idx < count; idx++)
+    {
+        VehicleList entry;
+        str_t name;
+
+        cp.readString(name);
+        cp.read(entry.rpos);
+        cp.read(entry.rrot);
+        cp.read(entry.rq);
+        if (!cp.isValid())
+            return false;
+
+        entry.vehicle = system->findVehicle(name);
+        if (entry.vehicle == nullptr || entry.vehicle->superVehicle != nullptr)
+        {
+            ofsLogger->error("{}: Checkpoint has unknown or docked member {}\n",
+                getsName(), name);
+            return false;
+        }
+        vlist.push_back(entry);
+        entry.vehicle->superVehicle = this;
+    }
+
+    if (vlist.empty())
+        return false;
+    setOrbitReference(vlist[0].vehicle->cbody);
+
+    return true;
+}
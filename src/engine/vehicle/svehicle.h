@@ -11,32 +11,56 @@
 struct VehicleList
 {
     Vehicle *vehicle;   // Attached/docked vessel
-    glm::dvec3 rpos;    // relative position in supervessel coords
+    glm::dvec3 rpos;    // relative position in supervessel coords [m]
     glm::dmat3 rrot;    // relative orientation (rotation matrix)
     glm::dquat rq;      // relative orientation (quaternion)
 };
 
+// Docked vehicles propagated as one rigid body. Assembly frame
+// is root vehicle frame, state vectors refer to assembly CG.
+// Member forces are collected into assembly frame before one
+// integration step and member states are derived from it.
 class OFSAPI SuperVehicle : public RigidBody
 {
 public:
-    SuperVehicle();
+    SuperVehicle(Vehicle *vehicle);
+    SuperVehicle(cstr_t &name);
     SuperVehicle(json &config);
     virtual ~SuperVehicle() = default;
 
+    inline int getVehicleCount() const      { return vlist.size(); }
+    inline Vehicle *getVehicle(int idx) const { return idx < vlist.size() ? vlist[idx].vehicle : nullptr; }
+
     bool addVehicle(Vehicle *vehicle1, int port1, Vehicle *vehicle2, int port2);
+    bool merge(Vehicle *vehicle1, int port1, SuperVehicle *other, Vehicle *vehicle2, int port2);
     void attach(Vehicle *vehicle);
     void detach(Vehicle *vehicle);
+    void detachAll();
     
-    void getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double dt);
+    void getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt) override;
+    glm::dvec3 computeEulerInverse(const glm::dvec3 &tau, const glm::dvec3 &omega) override;
 
     void updateMassCG();
+    void updateInertia();
 
     void updateGlobal(const glm::dvec3 &rpos, const glm::dvec3 &rvel);
+    void updateVehicleState(Vehicle *vehicle);
 
-    void update(bool force);
+    void update(bool force) override;
     void updatePost();
 
+    void saveState(Checkpoint &cp) const override;
+    bool restoreState(Checkpoint &cp) override;
+
 private:
-    std::vector<Vehicle *> vehicles;
+    int findVehicle(const Vehicle *vehicle) const;
+    bool getDockTransform(Vehicle *vehicle1, int port1, Vehicle *vehicle2, int port2,
+        glm::dvec3 &rpos, glm::dmat3 &rrot) const;
+
     std::vector<VehicleList> vlist;
-};
\ No newline at end of file
+
+    glm::dvec3 F = {};          // collected linear force (assembly frame)
+    glm::dvec3 L = {};          // collected torque (assembly frame)
+    glm::dmat3 inertia;         // inertia tensor per mass at CG [m^2]
+    glm::dmat3 inertiaInv;      // inverse inertia tensor
+};
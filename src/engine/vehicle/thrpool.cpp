@@ -0,0 +1,208 @@
+// thrpool.cpp - Vehicle package - thruster/propellant pools
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "main/checkpoint.h"
+#include "engine/vehicle/thrpool.h"
+
+tank_t *ThrusterPool::addTank(double maxMass, double mass, double efficiency)
+{
+    tkMaxMass.push_back(maxMass);
+    tkMass.push_back(mass);
+    tkPMass.push_back(mass);
+    tkEff.push_back(efficiency);
+    tkFlow.push_back(0.0);
+
+    tanks.push_back({ int(tanks.size()) });
+    return &tanks.back();
+}
+
+double ThrusterPool::getPropellantMass() const
+{
+    double mass = 0.0;
+    for (auto m : tkMass)
+        mass += m;
+    return mass;
+}
+
+// Any thruster set to fire with propellant left
+bool ThrusterPool::isActive() const
+{
+    for (int idx = 0; idx < thLevel.size(); idx++)
+        if ((thLevel[idx] > 0.0 || thPerm[idx] + thOver[idx] > 0.0) && hasFuel(idx))
+            return true;
+    return false;
+}
+
+thrust_t *ThrusterPool::addThruster(const glm::dvec3 &pos, const glm::dvec3 &dir, double maxth,
+    tank_t *tank, double isp, double pfac)
+{
+    thPos.push_back(pos);
+    thDir.push_back(dir);
+    thMax.push_back(maxth);
+    thIsp.push_back(isp);
+    thPfac.push_back(pfac);
+    thLevel.push_back(0.0);
+    thPerm.push_back(0.0);
+    thOver.push_back(0.0);
+    thTank.push_back(tank != nullptr ? tank->idx : -1);
+
+    thrusters.push_back({ int(thrusters.size()) });
+    return &thrusters.back();
+}
+
+// Thruster slot stays in place so that indices in
+// groups and handles remain valid - it no longer fires.
+void ThrusterPool::disableThruster(thrust_t *th)
+{
+    thMax[th->idx] = 0.0;
+    thTank[th->idx] = -1;
+    thLevel[th->idx] = thPerm[th->idx] = thOver[th->idx] = 0.0;
+}
+
+thrustgrp_t *ThrusterPool::addGroup(thrust_t **th, int nThrusts)
+{
+    for (int idx = 0; idx < nThrusts; idx++)
+        grpMembers.push_back(th[idx]->idx);
+    grpFirst.push_back(grpMembers.size());
+
+    groups.push_back({ int(groups.size()) });
+    return &groups.back();
+}
+
+void ThrusterPool::setGroupLevel(const thrustgrp_t *tg, double level)
+{
+    for (int idx = grpFirst[tg->idx]; idx < grpFirst[tg->idx+1]; idx++)
+    {
+        int th = grpMembers[idx];
+        double dlevel = level - thPerm[th];
+        thPerm[th] = level;
+        if (hasFuel(th))
+            thLevel[th] = std::clamp(thLevel[th] + dlevel, 0.0, 1.0);
+    }
+}
+
+void ThrusterPool::throttleGroupLevel(const thrustgrp_t *tg, double dlevel)
+{
+    for (int idx = grpFirst[tg->idx]; idx < grpFirst[tg->idx+1]; idx++)
+    {
+        int th = grpMembers[idx];
+        thPerm[th] += dlevel;
+        if (hasFuel(th))
+            thLevel[th] = std::clamp(thLevel[th] + dlevel, 0.0, 1.0);
+    }
+}
+
+void ThrusterPool::setGroupOverride(const thrustgrp_t *tg, double level)
+{
+    for (int idx = grpFirst[tg->idx]; idx < grpFirst[tg->idx+1]; idx++)
+        thOver[grpMembers[idx]] = level;
+}
+
+void ThrusterPool::throttleGroupOverride(const thrustgrp_t *tg, double dlevel)
+{
+    for (int idx = grpFirst[tg->idx]; idx < grpFirst[tg->idx+1]; idx++)
+        thOver[grpMembers[idx]] += dlevel;
+}
+
+double ThrusterPool::getGroupLevel(const thrustgrp_t *tg) const
+{
+    int first = grpFirst[tg->idx], last = grpFirst[tg->idx+1];
+    double level = 0.0;
+    for (int idx = first; idx < last; idx++)
+        level += thLevel[grpMembers[idx]];
+    return (last > first) ? level / (last - first) : 0.0;
+}
+
+// Resolve thruster levels and accumulate thrust force and torque
+// in vessel frame. Returns true if any thruster has propellant.
+bool ThrusterPool::update(double dt, double p, bool burnFuel, glm::dvec3 &force, glm::dvec3 &torque)
+{
+    int nThrusts = thLevel.size();
+    bool bEngaged = false;
+
+    // Record previous propellant mass
+    std::copy(tkMass.begin(), tkMass.end(), tkPMass.begin());
+    std::fill(tkFlow.begin(), tkFlow.end(), 0.0);
+
+    for (int idx = 0; idx < nThrusts; idx++)
+    {
+        if (!hasFuel(idx))
+        {
+            // Run out of fuel so that
+            // reset levels to zero.
+            thLevel[idx] = thPerm[idx] = thOver[idx] = 0.0;
+            continue;
+        }
+
+        double level = std::clamp(thPerm[idx] + thOver[idx], 0.0, 1.0);
+        double th = thMax[idx] * level;
+        int tank = thTank[idx];
+
+        thLevel[idx] = level;
+        thOver[idx] = 0.0;
+        if (thIsp[idx] > 0.0)
+            tkFlow[tank] += th / (tkEff[tank] * thIsp[idx]);
+
+        // Atmospheric pressure dependency of thrust
+        if (thPfac[idx] != 0.0)
+            th *= std::max(0.0, 1.0 - p * thPfac[idx]);
+
+        glm::dvec3 flin = thDir[idx] * th;
+        force += flin;
+        torque += glm::cross(flin, thPos[idx]);
+        bEngaged = true;
+    }
+
+    if (burnFuel)
+    {
+        int nTanks = tkMass.size();
+        for (int idx = 0; idx < nTanks; idx++)
+            tkMass[idx] = std::max(0.0, tkMass[idx] - tkFlow[idx] * dt);
+    }
+
+    return bEngaged;
+}
+
+void ThrusterPool::saveState(Checkpoint &cp) const
+{
+    // Propellant tanks
+    cp.write<uint32_t>(tkMass.size());
+    for (int idx = 0; idx < tkMass.size(); idx++)
+        cp.write(tkMass[idx]), cp.write(tkPMass[idx]);
+
+    // Thruster levels
+    cp.write<uint32_t>(thLevel.size());
+    for (int idx = 0; idx < thLevel.size(); idx++)
+        cp.write(thLevel[idx]), cp.write(thPerm[idx]), cp.write(thOver[idx]);
+}
+
+bool ThrusterPool::restoreState(Checkpoint &cp, cstr_t &name)
+{
+    uint32_t count = 0;
+    cp.read(count);
+    if (count != tkMass.size())
+    {
+        ofsLogger->error("{}: Checkpoint has {} tanks, expected {}\n",
+            name, count, tkMass.size());
+        return false;
+    }
+    for (int idx = 0; idx < tkMass.size(); idx++)
+        cp.read(tkMass[idx]), cp.read(tkPMass[idx]);
+
+    cp.read(count);
+    if (count != thLevel.size())
+    {
+        ofsLogger->error("{}: Checkpoint has {} thrusters, expected {}\n",
+            name, count, thLevel.size());
+        return false;
+    }
+    for (int idx = 0; idx < thLevel.size(); idx++)
+        cp.read(thLevel[idx]), cp.read(thPerm[idx]), cp.read(thOver[idx]);
+
+    return true;
+}
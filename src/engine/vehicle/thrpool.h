@@ -0,0 +1,103 @@
+// thrpool.h - Vehicle package - thruster/propellant pools
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#include <deque>
+
+class Checkpoint;
+
+// Handles given out to vehicle modules. Each one
+// is an index into owning vehicle's thruster pool.
+struct tank_t
+{
+    int idx;
+};
+
+struct thrust_t
+{
+    int idx;
+};
+
+struct thrustgrp_t
+{
+    int idx;
+};
+
+// Thrusters, propellant tanks and thruster groups of one vehicle,
+// stored as structure of arrays. Forces, torques and propellant
+// flow are computed in one pass over contiguous arrays with no
+// allocation. Groups are flat index lists into thruster arrays.
+class ThrusterPool
+{
+public:
+    ThrusterPool() = default;
+    ~ThrusterPool() = default;
+
+    // Propellant tanks
+    tank_t *addTank(double maxMass, double mass, double efficiency);
+
+    inline int getTankCount() const                 { return tkMass.size(); }
+    inline double getTankMass(const tank_t *ts) const     { return tkMass[ts->idx]; }
+    inline double getTankMaxMass(const tank_t *ts) const  { return tkMaxMass[ts->idx]; }
+    inline double getTankLevel(const tank_t *ts) const
+        { return (ts != nullptr && tkMaxMass[ts->idx] > 0.0) ? tkMass[ts->idx] / tkMaxMass[ts->idx] : 0.0; }
+
+    double getPropellantMass() const;
+    bool isActive() const;
+
+    // Thrusters
+    thrust_t *addThruster(const glm::dvec3 &pos, const glm::dvec3 &dir, double maxth,
+        tank_t *tank, double isp, double pfac);
+    void disableThruster(thrust_t *th);
+
+    inline int getThrusterCount() const             { return thLevel.size(); }
+
+    // Thruster groups
+    thrustgrp_t *addGroup(thrust_t **th, int nThrusts);
+
+    void setGroupLevel(const thrustgrp_t *tg, double level);
+    void throttleGroupLevel(const thrustgrp_t *tg, double dlevel);
+    void setGroupOverride(const thrustgrp_t *tg, double level);
+    void throttleGroupOverride(const thrustgrp_t *tg, double dlevel);
+    double getGroupLevel(const thrustgrp_t *tg) const;
+
+    bool update(double dt, double p, bool burnFuel, glm::dvec3 &force, glm::dvec3 &torque);
+
+    void saveState(Checkpoint &cp) const;
+    bool restoreState(Checkpoint &cp, cstr_t &name);
+
+private:
+    inline bool hasFuel(int th) const
+        { return thTank[th] >= 0 && tkMass[thTank[th]] > 0.0; }
+
+    // Propellant tanks
+    std::vector<double> tkMaxMass;      // maximum propellant mass
+    std::vector<double> tkMass;         // current propellant mass
+    std::vector<double> tkPMass;        // previous propellant mass (last step)
+    std::vector<double> tkEff;          // fuel efficiency factor
+    std::vector<double> tkFlow;         // propellant flow this step (scratch)
+
+    // Thrusters
+    std::vector<glm::dvec3> thPos;      // position in vessel frame
+    std::vector<glm::dvec3> thDir;      // thrust direction
+    std::vector<double> thMax;          // maximum thrust force [N]
+    std::vector<double> thIsp;          // vacuum isp [m/s]
+    std::vector<double> thPfac;         // pressure dependency of thrust
+    std::vector<double> thLevel;        // level [0..1]
+    std::vector<double> thPerm;         // level permanent
+    std::vector<double> thOver;         // level override
+    std::vector<int>    thTank;         // tank index (-1 = none)
+
+    // Thruster groups - members of group g are
+    // grpMembers[grpFirst[g]] .. grpMembers[grpFirst[g+1]-1]
+    std::vector<int> grpFirst = { 0 };
+    std::vector<int> grpMembers;
+
+    // Module handles (stable addresses)
+    std::deque<tank_t> tanks;
+    std::deque<thrust_t> thrusters;
+    std::deque<thrustgrp_t> groups;
+};
@@ -12,15 +12,10 @@
 
 tank_t *Vehicle::createPropellant(double maxMass, double mass, double efficiency)
 {
-    tank_t *ts = new tank_t;
-    ts->maxMass = maxMass;
-    ts->mass = (mass >= 0.0 ? mass : maxMass);
-    ts->pmass = ts->mass;
-    ts->efficiency = efficiency;
+    tank_t *ts = thpool.addTank(maxMass, (mass >= 0.0 ? mass : maxMass), efficiency);
 
-    if (tankList.empty())
+    if (thpool.getTankCount() == 1)
         dTank = ts;
-    tankList.push_back(ts);
 
     return ts;
 }
@@ -28,35 +23,21 @@ tank_t *Vehicle::createPropellant(double maxMass, double mass, double efficiency
 thrust_t *Vehicle::createThruster(const glm::dvec3 &pos, const glm::dvec3 &dir, double maxth,
     tank_t *tank, double isp, double ispref, double pref)
 {
-    thrust_t *th = new thrust_t();
-
-    th->pos = pos / M_PER_KM;
-    th->dir = dir;
-    th->maxth = maxth;
-    th->tank = tank;
-
     // Atmospheric pressure dependency of thrust
-    th->isp = isp; // (isp > 0.0) ? isp : disp;
-    th->pfac = (ispref > 0.0) ? (isp-ispref)/(pref/isp) : 0.0;
+    double pfac = (ispref > 0.0) ? (isp-ispref)/(pref*isp) : 0.0;
 
-    thrustList.push_back(th);
-
-    return th;
+    return thpool.addThruster(pos / M_PER_KM, dir, maxth, tank, isp, pfac);
 }
 
 bool Vehicle::deleteThruster(thrust_t *th)
 {
-    
-    for (auto it = thrustList.begin(); it != thrustList.end(); it++)
-    {
-        if (*it == th)
-        {
-            it = thrustList.erase(it);
-            return true;
-        }
-    }
+    if (th == nullptr)
+        return false;
 
-    return false;
+    // Keep slot in pool so that group
+    // members and handles remain valid.
+    thpool.disableThruster(th);
+    return true;
 }
 
 // void Vehicle::setThrustLevel(thrust_t *th, double level)
@@ -88,10 +69,7 @@ bool Vehicle::deleteThruster(thrust_t *th)
 
 thrustgrp_t *Vehicle::createThrusterGroup(thrust_t **th, int nThrusts, thrustType_t type)
 {
-    thrustgrp_t *thg = new thrustgrp_t();
-
-    for (int idx = 0; idx < nThrusts; idx++)
-        thg->thrusters.push_back(th[idx]);
+    thrustgrp_t *thg = thpool.addGroup(th, nThrusts);
 
     thgrpList[type] = thg;
     return thg;
@@ -166,26 +144,22 @@ void Vehicle::createDefaultAttitudeSet(double maxth)
 
 void Vehicle::setThrustGroupLevel(thrustgrp_t *tg, double level)
 {
-    for (auto th : tg->thrusters)
-        th->setThrustLevel(level);
+    thpool.setGroupLevel(tg, level);
 }
 
 void Vehicle::throttleThrustGroupLevel(thrustgrp_t *tg, double dlevel)
 {
-    for (auto th : tg->thrusters)
-        th->adjustThrustLevel(dlevel);
+    thpool.throttleGroupLevel(tg, dlevel);
 }
 
 void Vehicle::setThrustGroupOverride(thrustgrp_t *tg, double level)
 {
-    for (auto th : tg->thrusters)
-        th->setThrustOverride(level);
+    thpool.setGroupOverride(tg, level);
 }
 
 void Vehicle::throttleThrustGroupOverride(thrustgrp_t *tg, double dlevel)
 {
-    for (auto th : tg->thrusters)
-        th->adjustThrustOverride(dlevel);
+    thpool.throttleGroupOverride(tg, dlevel);
 }
 
 
@@ -216,10 +190,7 @@ void Vehicle::throttleThrustGroupOverride(thrustType_t type, double dlevel)
 
 double Vehicle::getThrustGroupLevel(thrustgrp_t *tg)
 {
-    double level = 0.0;
-    for (auto th : tg->thrusters)
-        level += th->level;
-    return tg->thrusters.size() > 0 ? level / tg->thrusters.size() : 0.0;
+    return thpool.getGroupLevel(tg);
 }
 
 double Vehicle::getThrustGroupLevel(thrustType_t type)
@@ -413,38 +384,12 @@ void Vehicle::updateThrustForces()
         }
     }
 
-    // Record previous fuel mass
-    for (auto &ts : tankList)
-        ts->pmass = ts->mass;
-
     glm::dvec3 thrust = {};
     glm::dvec3 tamom = {};
 
     double dt = ofsDate->getSimDeltaTime1();
-    bool bThrustEngaged = false;
-    for (auto eng : thrustList) {
-        eng->level = std::max(0.0, std::min(1.0, eng->lvperm + eng->lvover));
-        tank_t *ts = eng->tank;
-        if (ts != nullptr && ts->mass > 0.0) {
-            double th = eng->maxth * eng->level;
-            if (bEnableBurnFuel) {
-                ts->mass -= th / (ts->efficiency * eng->isp) * dt;
-                if (ts->mass < 0.0)
-                    ts->mass = 0.0;
-            }
-            th *= computeAtmThrustScale(eng, surfParam.atmPressure);
-            glm::dvec3 flin = eng->dir * th;
-            thrust += flin;
-            tamom += glm::cross(flin, eng->pos);
-            bThrustEngaged = true;
-        } else {
-            // Run out of fuel so that
-            // reset levels to zero.
-            eng->level = 0.0;
-            eng->lvperm = 0.0;
-        }
-        eng->lvover = 0.0;
-    }
+    bool bThrustEngaged = thpool.update(dt, surfParam.atmPressure,
+        bEnableBurnFuel, thrust, tamom);
 
     if (bThrustEngaged)
         cflin += thrust;
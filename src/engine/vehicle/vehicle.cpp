@@ -16,6 +16,8 @@
 #include "engine/vehicle/vehicle.h"
 #include "universe/astro.h"
 #include "universe/body.h"
+#include "universe/psystem.h"
+#include "main/checkpoint.h"
 
 void surface_t::setLanded(double _lng, double _lat, double _alt, double dir,
     const glm::dvec3 &nml, const Celestial *object)
@@ -247,6 +249,7 @@ VehicleBase::VehicleBase(cjson &config)
 
 void VehicleBase::updateSurfaceParam()
 {
+    bSurfaceStale = false;
     surfParam.update(s1 != nullptr ? *s1 : *s0, cbody->s1 != nullptr ? *cbody->s1 : *cbody->s0, cbody, &elevTiles);
 }
 
@@ -418,7 +421,11 @@ void Vehicle::setTouchdownPoints(const tdVertex_t *tdvtx, int ntd)
         tpVertices[idx].pos = tdvtx[idx].pos / M_PER_KM;
         tpVertices[idx].stiffness = tdvtx[idx].stiffness;
         tpVertices[idx].damping = tdvtx[idx].damping;
+        tpVertices[idx].compression = tdvtx[idx].compression;
+        tpVertices[idx].mulat = tdvtx[idx].mulat;
+        tpVertices[idx].mulng = tdvtx[idx].mulng;
     }
+    contact.setup(tdvtx, ntd);
 
     glm::dvec3 tp[3] = { tpVertices[0].pos, tpVertices[1].pos, tpVertices[2].pos };
 
@@ -445,6 +452,7 @@ void Vehicle::setSurfaceFriction(double lat, double lng)
         tp.mulat = mulat;
         tp.mulng = mulng;
     }
+    contact.setFriction(mulat, mulng);
 }
 
 void Vehicle::initLanded(Object *object, double lat, double lng, double dir)
@@ -482,7 +490,15 @@ void Vehicle::initLanded(Object *object, double lat, double lng, double dir)
 
     }
 
-
+    // Rest touchdown points on terrain below
+    gstate = { lat, lng, 0.0, dir, {}, 0.0 };
+    const CelestialPlanet *planet = dynamic_cast<const CelestialPlanet *>(object);
+    if (planet != nullptr)
+    {
+        int rlod = int(21.0 - log(0.1)*(1.0 / log(2.0)));
+        gstate.alt = contact.getRestAltitude(gstate, planet->getRadius() * M_PER_KM,
+            planet->getElevationManager(), rlod, &elevTiles);
+    }
     fsType = fsLanded;
 }
 
@@ -548,6 +564,7 @@ void Vehicle::initLanded(Celestial *object, const glm::dvec3 &loc, double dir)
 
     updateSurfaceParam();
 
+    gstate = { sp.lat, sp.lng, (sp.rad - cbody->getRadius()) * M_PER_KM, dir, {}, 0.0 };
     fsType = fsLanded;
 }
 
@@ -628,6 +645,75 @@ void Vehicle::initDocked()
     
 }
 
+// Dock port of this vehicle with tport of target vehicle. New
+// assembly is created and registered with planetary system, or
+// vehicle joins target assembly (merging its own if docked).
+bool Vehicle::dock(int port, Vehicle *target, int tport)
+{
+    if (target == nullptr || target == this || system == nullptr)
+        return false;
+    if (fsType != fsFlight || target->fsType != fsFlight)
+        return false;
+    if (superVehicle != nullptr && superVehicle == target->superVehicle)
+        return false;
+
+    // Join our assembly from other side
+    if (target->superVehicle == nullptr && superVehicle != nullptr)
+        return target->dock(tport, this, port);
+
+    SuperVehicle *sveh = target->superVehicle;
+    SuperVehicle *oldsveh = superVehicle;
+    bool bCreated = sveh == nullptr;
+    if (bCreated)
+        sveh = new SuperVehicle(target);
+
+    bool bDocked = (oldsveh != nullptr)
+        ? sveh->merge(target, tport, oldsveh, this, port)
+        : sveh->addVehicle(target, tport, this, port);
+    if (!bDocked)
+    {
+        if (bCreated)
+        {
+            sveh->detachAll();
+            delete sveh;
+        }
+        return false;
+    }
+
+    if (bCreated)
+        system->addSuperVehicle(sveh);
+    if (oldsveh != nullptr)
+    {
+        system->removeSuperVehicle(oldsveh);
+        delete oldsveh;
+    }
+
+    ofsLogger->info("{}: Docked with {} (port {} to {})\n",
+        getsName(), target->getsName(), port, tport);
+    return true;
+}
+
+// Leave assembly. Assembly is dissolved when only
+// one vehicle is left.
+bool Vehicle::undock()
+{
+    SuperVehicle *sveh = superVehicle;
+    if (sveh == nullptr)
+        return false;
+
+    sveh->detach(this);
+    if (sveh->getVehicleCount() <= 1)
+    {
+        sveh->detachAll();
+        if (system != nullptr)
+            system->removeSuperVehicle(sveh);
+        delete sveh;
+    }
+
+    ofsLogger->info("{}: Undocked\n", getsName());
+    return true;
+}
+
 void Vehicle::getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt)
 {
     glm::dvec3 F = cflin;
@@ -650,150 +736,10 @@ void Vehicle::getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const Stat
     //     getsName(), acc.x, acc.y, acc.z, am.x, am.y, am.z, mass);
 }
 
-bool Vehicle::addSurfaceForces(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &s, double tfrac, double dt)
-{
-    // double alt = s.pos - cbody->getRadius();
-    // if (alt > sp.elev + 1e4)
-    //     return false;
-    
-
-    surface_t &sp = surfParam;
-    StateVectors ps;
-    sp.update(s, ps, cbody, &elevTiles);
-    double alt = sp.alt;
-    // if (alt > 2.0*size)
-    //     return false;
-
-    CelestialPlanet *planet = dynamic_cast<CelestialPlanet *>(cbody);
-    ElevationManager *emgr = planet->getElevationManager();
-
-    // Check any touchdown points to touch ground
-    double tdymin = std::numeric_limits<double>::infinity();
-    int rlod = int(21.0 - log(std::max(sp.alt0, 0.1))*(1.0 / log(2.0)));
-    glm::dmat3 T = glm::transpose(ps.R) * s.R;
-    glm::dvec3 shift = glm::transpose(ps.R) * (s.pos - ps.pos);
-
-    for (auto tp : tpVertices)
-    {
-        glm::dvec3 p = T * tp.pos + shift;
-        double lat, lng, rad, elev = 0.0;
-        cbody->convertLocalToEquatorial(p, lat, lng, rad);
-        if (emgr != nullptr)
-            elev = emgr->getElevationData({lat, lng, 0}, rlod, &elevTiles);
-        tp.tdy = rad - elev - cbody->getRadius();
-        if (tp.tdy < tdymin)
-            tdymin = tp.tdy;
-    }
-
-    // No, did not touch ground
-    if (tdymin >= 0.0)
-        return false;
-    ofsLogger->info("Collision detected!\n");
-    if (!enableGroundContact)
-        return true;
-
-    glm::dvec3 d1 = tpVertices[0].pos - (tpVertices[1].pos + tpVertices[2].pos) * 0.5;
-    glm::dvec3 hn = {};
-    glm::dvec3 d1h = glm::normalize(d1 - hn * glm::dot(d1, hn));
-    glm::dvec3 d2h = glm::cross(hn, d1h);
-
-    double gvn, gvlng, gvlat;
-    double tflng = 0;
-    double tflat = 0;
-    double tfn = 0;
-    double tfnu = 0;
-    double mu;
-    double massdt = mass/dt;
-
-    // if (bDynamicGroundContact) {
-    //     for (auto tp : tpVertices) {
-    //         if (tp.tdy < 0.0) {
-
-    //             glm::dvec3 gv = sp.gvlocal + glm::cross(tp.pos, s.omega);
-    //             gvn = glm::dot(gv, hn);
-    //             gvlng = glm::dot(gv, d1h);
-    //             gvlat = glm::dot(gv, d2h);
-
-    //             tp.fn = -tp.tdy * tp.stiffness;
-    //             double maxpress = std::min(-tp.tdy, 0.1)*tp.stiffness;
-    //             // if (tp.bTire) {
-    //             // } else {
-    //             // }
-    //             tp.flng = mu * maxpress;
-    //             if (gvlng > 0.0)
-    //                 tp.flng = -tp.flng;
-    //             tflng += tp.flng;
-
-    //             mu = tp.mu;
-    //             tp.flat = mu * maxpress;
-    //             if (fabs(gvlat) < 10.0)
-    //                 tp.flat *= sqrt(fabs(gvlat*0.1));
-    //             if (gvlat > 0.0)
-    //                 tp.flat = -tp.flat;
-    //             tflat += tp.flat;
-
-    //             // Ecomp -= tp.fn * tp.tdy * 0.5;
-    //             tfnu += tp.fn;
-    //             tp.fn -= gvn*tp.damping;
-    //             tfn += tp.fn;
-
-    //         } else {
-    //             tp.flng = 0;
-    //             tp.flat = 0;
-    //             tp.fn = 0;
-    //         }
-    //     }
-
-    //     gvlng = glm::dot(sp.gvlocal, d1h);
-    //     gvlat = glm::dot(sp.gvlocal, d2h);
-    //     gvn = glm::dot(sp.gvlocal, hn);
-
-    //     double mflng = -gvlng * massdt;
-    //     if ((mflng >= 0.0 && tflng > mflng) ||
-    //         (mflng <= 0.0 && tflng < mflng)) {
-    //         for (auto tp : tpVertices)
-    //             tp.flng *= mflng/tflng;
-    //         tflng = mflng;
-    //     }
-
-    //     double mflat = -gvlat * massdt;
-    //     if ((mflat >= 0.0 && tflat > mflat) ||
-    //         (mflat <= 0.0 && tflat < mflat)) {
-    //         for (auto tp : tpVertices)
-    //             tp.flat *= mflat/tflat;
-    //         tflat = mflat;
-    //     }
-
-    //     glm::dvec3 Fsurf = hn*tfn + d1h*tflng + d2h*tflat;
-    //     glm::dvec3 Msurf;
-
-    //     for (auto tp : tpVertices) {
-    //         int j = tp.tidx;
-    //         Msurf += glm::cross(hn*tpVertices[j].flng + d2h*tpVertices[j].flat, tpVertices[j].pos);
-    //     }
-
-    //     glm::dvec3 dA = computeInverseEulerFull(Msurf/mass, s.omega)*dt*dt;
-    //     double da = glm::length(dA);
-    //     static double damax = 0.0;
-    //     if (da > damax)
-    //         damax = da;
-    //     if (da > glm::radians(10.0))
-    //         Msurf *= glm::radians(10.0)/da;
-
-    //     acc += Fsurf;
-    //     am += Msurf;
-    // }
-
-    return true;
-}
-
 void Vehicle::updateMass()
 {
     pfmass = fmass;
-    fmass = 0.0;
-
-    for (auto &ts : tankList)
-        fmass += ts->mass;
+    fmass = thpool.getPropellantMass();
     mass = emass + fmass;
 
     // ofsLogger->debug("{}: mass update - total {} vehicle {} fuel {}\n",
@@ -824,6 +770,10 @@ void Vehicle::updateBodyForces()
 {
     surface_t &sp = surfParam;
 
+    // Nothing to do while coasting until thrusters engage
+    if (bCoasting && !thpool.isActive())
+        return;
+
     updateThrustForces();
     if (sp.isInAtomsphere) {
         // updateAerodynamicForces();
@@ -833,47 +783,171 @@ void Vehicle::updateBodyForces()
                      camom.x || camom.y || camom.z);
 }
 
-void Vehicle::update(bool force)
+// Landed and taxiing vehicles. Vehicles at rest with no applied
+// force stay pinned to their surface location, otherwise touchdown
+// contact is integrated in local horizon frame.
+void Vehicle::updateGround()
 {
     surface_t &sp = surfParam;
+    double dt = ofsDate->getSimDeltaTime1();
+    double R = cbody->getRadius() * M_PER_KM;
+
+    const CelestialPlanet *planet = dynamic_cast<const CelestialPlanet *>(cbody);
+    const ElevationManager *emgr = (planet != nullptr) ? planet->getElevationManager() : nullptr;
+    int rlod = int(21.0 - log(std::max(gstate.alt / M_PER_KM, 0.1))*(1.0 / log(2.0)));
+
+    if (fsType == fsLanded && bActiveForce)
+    {
+        // Settle onto touchdown points before moving
+        fsType = fsDriving;
+        gstate.alt = contact.getRestAltitude(gstate, R, emgr, rlod, &elevTiles);
+    }
+
+    if (fsType == fsDriving)
+    {
+        double r = R + gstate.alt;
+        double g = astro::G * cbody->getMass() / (r*r);
+        bool bContact = contact.update(dt, gstate, mass, mass * pmi.y, cflin, camom.y,
+            g, R, emgr, rlod, &elevTiles);
+
+        if (!bContact && gstate.vel.y > 0.0)
+        {
+            // Lifted off - continue in free flight
+            fsType = fsFlight;
+            bOrbitNotInitialized = true;
+        }
+        else if (!bActiveForce && glm::length(gstate.vel) < CONTACT_REST_SPEED &&
+            fabs(gstate.yawRate) * radius * M_PER_KM < CONTACT_REST_SPEED)
+        {
+            // All stopped
+            fsType = fsLanded;
+            gstate.vel = {};
+            gstate.yawRate = 0.0;
+        }
+    }
+
+    sp.lat = gstate.lat, sp.lng = gstate.lng;
+    sp.heading = gstate.heading;
+    sp.alt0 = gstate.alt / M_PER_KM;
+    sp.rad = cbody->getRadius() + sp.alt0;
+    sp.slat = sin(sp.lat), sp.clat = cos(sp.lat);
+    sp.slng = sin(sp.lng), sp.clng = cos(sp.lng);
+
+    sp.ploc = cbody->convertEquatorialToLocal(sp.slat, sp.clat, sp.slng, sp.clng, sp.rad);
+    lhrot = { sp.slat*sp.clng,  sp.clat*sp.clng, sp.slng,
+             -sp.clat,          sp.slat,         0,
+             -sp.slat*sp.slng, -sp.clat*sp.slng, sp.clng };
+    drot = ofs::hRotate(sp.heading);
+
+    // Surface rotation plus ground velocity (east, up, north)
+    double period = cbody->getRotationPeriod();
+    double gvel = (period != 0.0) ? (cbody->getRadius() * sp.clat * pi2) / period : 0.0;
+    glm::dvec3 east  = { -sp.slng, 0.0, -sp.clng };
+    glm::dvec3 up    = { sp.clat*sp.clng, sp.slat, -sp.clat*sp.slng };
+    glm::dvec3 north = { -sp.slat*sp.clng, sp.clat, sp.slat*sp.slng };
+    glm::dvec3 vloc = glm::dvec3(-gvel * sp.slng, 0.0, gvel * sp.clng) +
+        (east*gstate.vel.x + up*gstate.vel.y + north*gstate.vel.z) / M_PER_KM;
+
+    s1->pos = cbody->convertLocalToGlobalS1(sp.ploc);
+    s1->vel = (vloc * cbody->s1->R) + cbody->s1->vel;
+    s1->R = drot * lhrot * cbody->s1->R;
+    s1->Q = s1->R;
+}
+
+// Hand free flight over to ground contact at impact. Position
+// and velocity are relative to reference body [km, km/s] and
+// mapped back the same way updateGround maps ground state.
+void Vehicle::touchdown(const glm::dvec3 &rpos, const glm::dvec3 &rvel)
+{
+    const glm::dmat3 &brot = cbody->s1->R;
+    double lat, lng, rad;
+    cbody->convertLocalToEquatorial(rpos * glm::transpose(brot), lat, lng, rad);
+
+    double slat = sin(lat), clat = cos(lat);
+    double slng = sin(lng), clng = cos(lng);
+    glm::dmat3 lh = { slat*clng,  clat*clng, slng,
+                     -clat,       slat,      0,
+                     -slat*slng, -clat*slng, clng };
+
+    // Ground velocity relative to rotating surface (east, up, north)
+    double period = cbody->getRotationPeriod();
+    double gvel = (period != 0.0) ? (cbody->getRadius() * clat * pi2) / period : 0.0;
+    glm::dvec3 east  = { -slng, 0.0, -clng };
+    glm::dvec3 up    = { clat*clng, slat, -clat*slng };
+    glm::dvec3 north = { -slat*clng, clat, slat*slng };
+    glm::dvec3 vloc = rvel * glm::transpose(brot) - glm::dvec3(-gvel * slng, 0.0, gvel * clng);
+
+    // Heading from attitude relative to horizon frame
+    glm::dmat3 hrot = s1->R * glm::transpose(brot) * glm::transpose(lh);
+
+    gstate.lat = lat, gstate.lng = lng;
+    gstate.alt = (rad - cbody->getRadius()) * M_PER_KM;
+    gstate.heading = atan2(hrot[0][0], hrot[0][2]);
+    gstate.vel = glm::dvec3(glm::dot(east, vloc), glm::dot(up, vloc), glm::dot(north, vloc)) * M_PER_KM;
+    gstate.yawRate = 0.0;
+
+    const CelestialPlanet *planet = dynamic_cast<const CelestialPlanet *>(cbody);
+    const ElevationManager *emgr = (planet != nullptr) ? planet->getElevationManager() : nullptr;
+    int rlod = int(21.0 - log(std::max(gstate.alt / M_PER_KM, 0.1))*(1.0 / log(2.0)));
+    gstate.alt = std::max(gstate.alt, contact.getRestAltitude(gstate,
+        cbody->getRadius() * M_PER_KM, emgr, rlod, &elevTiles));
+
+    fsType = fsDriving;
+    bCoasting = false;
+    updateGround();
+}
 
-    if (fsType == fsFlight) {
+void Vehicle::update(bool force)
+{
+    // Leave coast mode on applied forces, docking
+    // or when next predicted event is reached.
+    if (bCoasting && (bActiveForce || superVehicle != nullptr ||
+        fsType != fsFlight || ofsDate->getSimTime1() >= coastUntil))
+        bCoasting = false;
+
+    if (superVehicle != nullptr) {
+        // Docked - integrated as part of super vehicle
+        superVehicle->updateVehicleState(this);
+    } else if (bCoasting) {
+        updateCoast();
+    } else if (fsType == fsFlight) {
         RigidBody::update(force);
-    } else if (fsType == fsLanded) {
-        // ofsLogger->info("{}: S0 {}, {}, {}\n", cbody->getsName(),
-        //     cbody->s0.pos.x, cbody->s0.pos.y, cbody->s0.pos.z);
-        // ofsLogger->info("{}: S1 {}, {}, {} Flag: {}\n", cbody->getsName(),
-        //     cbody->s1.pos.x, cbody->s1.pos.y, cbody->s1.pos.z, cbody->s1.bUpdates);
-
-        s1->pos = cbody->convertLocalToGlobalS1(sp.ploc);
-        double period = cbody->getRotationPeriod();
-        double gvel = (period != 0.0) ? (cbody->getRadius()  * sp.clat * pi2) / period : 0.0;
-        s1->vel = { -gvel * sp.slng, 0.0, gvel * sp.clng};
-        s1->R = drot * lhrot * cbody->s1->R;
-        s1->Q = s1->R;
-
-        // glm::dvec3 loc = cbody->convertGlobalToEquatorialS1(s1.pos);
-        // ofsLogger->info("{}: V {},{},{}\n", cbody->getsName(),
-        //     ofs::degrees(loc.x), ofs::degrees(loc.y), loc.z);
-
-        // if (bActiveForce) {
-        //     // Whenever the user engages engine,
-        //     // change status to orbital flight.
-        //     fsType = fsFlight;
-
-        //     brpos = s1.pos, irpos = {};
-        //     brvel = s1.vel, irvel = {};
-        //     s1.omega = {};
-        // }
+    } else if (fsType == fsLanded || fsType == fsDriving) {
+        updateGround();
     }
 
-    if (cbody != nullptr && fsType != fsLanded)
-        updateSurfaceParam();
+    // Land on trajectory events within this step. Coasting
+    // vehicles are checked too as prediction above only
+    // covers reference body, not secondaries.
+    if (fsType == fsFlight && superVehicle == nullptr &&
+        cbody != nullptr && !bOrbitNotInitialized)
+    {
+        vehEvent_t ev;
+        if (detectEvents(ev))
+            processEvent(ev);
+    }
+
+    if (cbody != nullptr && fsType != fsLanded && fsType != fsDriving) {
+        if (bCoasting)
+            bSurfaceStale = true;
+        else
+            updateSurfaceParam();
+    }
 
     // Update position and velocity in orbit reference frame
     cpos = s1->pos - cbody->s1->pos;
     cvel = s1->vel - cbody->s1->vel;
 
+    // Enter coast mode when nothing but central body
+    // gravity acts until next predicted event.
+    if (!bCoasting && bEnableCoast && !bActiveForce && fsType == fsFlight &&
+        superVehicle == nullptr && cbody != nullptr && !bOrbitNotInitialized)
+    {
+        double t = ofsDate->getSimTime1();
+        coastUntil = predictCoastEvent(t);
+        bCoasting = coastUntil > t;
+    }
+
     // Reset linear and angular forces
     // for next update phase
     flin += cflin;
@@ -889,11 +963,149 @@ void Vehicle::update(bool force)
     updateMass();
 }
 
+// Vehicle state follows from simulation time alone - coasting
+// until next predicted event or parked on surface.
+bool Vehicle::isIdle() const
+{
+    if (superVehicle != nullptr || thpool.isActive())
+        return false;
+    if (fsType == fsLanded)
+        return true;
+    return bCoasting && ofsDate->getSimTime1() < coastUntil;
+}
+
+// Next time radius crosses entry interface/terrain clearance
+// or sphere of influence of reference body (Laplace radius).
+double Vehicle::predictCoastEvent(double t) const
+{
+    double tev = std::numeric_limits<double>::max();
+    double r = glm::length(cpos) * M_PER_KM;
+
+    double rlow = (cbody->getRadius() + COAST_TERRAIN_ALT) * M_PER_KM;
+    const CelestialPlanet *planet = dynamic_cast<const CelestialPlanet *>(cbody);
+    if (planet != nullptr && planet->hasAtmosphere())
+        rlow = std::max(rlow, (cbody->getRadius() +
+            std::min(planet->getAtmConstants().altLimit, COAST_ENTRY_ALT)) * M_PER_KM);
+    if (r <= rlow)
+        return t;
+
+    double dt = oel.getTimeToRadius(t, rlow);
+    if (dt >= 0.0)
+        tev = std::min(tev, t + dt);
+
+    double rsoi = cbody->getSOIRadius() * M_PER_KM;
+    if (rsoi > 0.0)
+    {
+        if (r >= rsoi)
+            return t;
+        dt = oel.getTimeToRadius(t, rsoi);
+        if (dt >= 0.0)
+            tev = std::min(tev, t + dt);
+    }
+
+    return tev;
+}
+
+// Keplerian propagation with free spin - no force, torque
+// or surface updates. Orbit is still evaluated every step
+// because renderer and cameras read state vectors directly.
+void Vehicle::updateCoast()
+{
+    s1->set(*s0);
+    oel.update(ofsDate->getSimTime1(), cpos, cvel);
+    s1->pos = cbody->s1->pos + cpos;
+    s1->vel = cbody->s1->vel + cvel;
+    ofs::rotate(s1->Q, s1->omega);
+    s1->R = glm::mat3_cast(s1->Q);
+}
+
 void Vehicle::updatePost()
 {
 
 }
 
+void Vehicle::saveState(Checkpoint &cp) const
+{
+    RigidBody::saveState(cp);
+
+    cp.write(fsType);
+    cp.write(lhrot), cp.write(drot);
+    cp.write(gstate);
+    cp.write(F), cp.write(L);
+    cp.write(Fadd), cp.write(Ladd);
+
+    cp.write(emass), cp.write(fmass), cp.write(pfmass);
+    cp.write(lift), cp.write(drag);
+    cp.write(flin), cp.write(amom);
+    cp.write(cflin), cp.write(camom);
+    cp.write(thrust);
+    cp.write(bActiveForce);
+    cp.write(rcsMode);
+    cp.write(navFlags);
+    cp.write(afctrlLevels);
+
+    // Propellant tanks and thruster levels
+    thpool.saveState(cp);
+
+    // Animation states
+    cp.write<uint32_t>(animList.size());
+    for (auto an : animList)
+        cp.write(an->state);
+
+    // Module-provided state
+    std::vector<uint8_t> blob;
+    if (vif.module != nullptr)
+        vif.module->saveState(blob);
+    cp.writeBlob(blob);
+}
+
+bool Vehicle::restoreState(Checkpoint &cp)
+{
+    if (!RigidBody::restoreState(cp))
+        return false;
+
+    // Coast mode is re-evaluated on next update
+    bCoasting = false;
+
+    cp.read(fsType);
+    cp.read(lhrot), cp.read(drot);
+    cp.read(gstate);
+    cp.read(F), cp.read(L);
+    cp.read(Fadd), cp.read(Ladd);
+
+    cp.read(emass), cp.read(fmass), cp.read(pfmass);
+    cp.read(lift), cp.read(drag);
+    cp.read(flin), cp.read(amom);
+    cp.read(cflin), cp.read(camom);
+    cp.read(thrust);
+    cp.read(bActiveForce);
+    cp.read(rcsMode);
+    cp.read(navFlags);
+    cp.read(afctrlLevels);
+
+    if (!thpool.restoreState(cp, getsName()))
+        return false;
+
+    uint32_t count = 0;
+    cp.read(count);
+    if (count != animList.size())
+    {
+        ofsLogger->error("{}: Checkpoint has {} animations, expected {}\n",
+            getsName(), count, animList.size());
+        return false;
+    }
+    for (auto an : animList)
+        cp.read(an->state);
+
+    std::vector<uint8_t> blob;
+    if (!cp.readBlob(blob))
+        return false;
+    if (vif.module != nullptr && !blob.empty())
+        vif.module->restoreState(blob);
+
+    return cp.isValid();
+}
+
 void Vehicle::drawHUD(HUDPanel *hud, Sketchpad *pad)
 {
     hud->drawDefault(pad);
@@ -9,6 +9,8 @@
 #include "api/ofsapi.h"
 #include "api/elevmgr.h"
 #include "api/vehicle.h"
+#include "engine/vehicle/thrpool.h"
+#include "engine/vehicle/contact.h"
 
 // class SuperVessel
 // {
@@ -35,6 +37,7 @@ class HUDPanel;
 class Sketchpad;
 class Mesh;
 class Keymap;
+class AeroTable;
 
 // planetary surface parameters for flight simulation (air flight)
 struct surface_t
@@ -108,6 +111,28 @@ enum airfoilType_t
 #define AIRCTRL_RUDTRIM     5   // Rudder trim control
 #define AIRCTRL_NLEVEL      6   // Maxinum number of levels
 
+#define COAST_ENTRY_ALT     120.0   // Entry interface altitude limit [km]
+#define COAST_TERRAIN_ALT   25.0    // Terrain clearance altitude [km]
+
+enum vehEventType_t
+{
+    evtNone = 0,            // No event
+    evtSOIExit,             // Left sphere of influence of reference body
+    evtSOIEntry,            // Entered sphere of influence of secondary body
+    evtAtmEntry,            // Crossed entry interface downwards
+    evtAtmExit,             // Crossed entry interface upwards
+    evtImpact,              // Reached ground elevation
+    evtPeriapsis,           // Passed periapsis
+    evtApoapsis             // Passed apoapsis
+};
+
+struct vehEvent_t
+{
+    vehEventType_t type = evtNone;
+    double t = 0.0;                 // event time [s]
+    Celestial *body = nullptr;      // body event refers to
+};
+
 enum ControlType_t
 {
     aircAileron = 0,        // Aileron control (bank control)
@@ -137,6 +162,9 @@ struct airfoil_t
     affunc_t  cf = nullptr;
     affuncx_t cfx = nullptr;
     void *ctx = nullptr;
+
+    const AeroTable *table = nullptr;   // coefficient table (replaces callbacks)
+    int defl = -1;                      // control level for deflection axis (-1 = none)
 };
 
 struct afctrl_t
@@ -157,64 +185,6 @@ struct afctrlLevel_t
     double delay;
 };
 
-struct tank_t
-{
-    double maxMass;         // maximum propellant mass
-    double mass;            // current propellant mass
-    double pmass;           // previous propellant mass (last time)
-    double efficiency;      // fuel efficiency factor
-};
-
-struct thrust_t
-{
-    glm::dvec3 pos;            // thruster position in vessel frame
-    glm::dvec3 dir;            // thrister direction
-
-    double maxth;           // Maximum thrust force [N]
-    double isp;             // Vacuum isp setting [m/s]
-    double pfac;            // Pressure-dependency of thrust and isp
-
-    double level;           // level [0..1]
-    double lvperm;          // level permament
-    double lvover;          // level override
-
-    tank_t  *tank;          // propellant resources
-
-    inline void setThrustLevel(double lvl)
-    {
-        double dlevel = lvl - lvperm;
-        lvperm = lvl;
-        if (tank != nullptr && tank->mass > 0)
-            level = std::max(0.0, std::min(1.0, level + dlevel));
-    }
-
-    inline void adjustThrustLevel(double dlvl)
-    {
-        lvperm += dlvl;
-        if (tank != nullptr && tank->mass > 0)
-            level = std::max(0.0, std::min(1.0, level + dlvl));
-    }
-
-    inline void setThrustOverride(double lvl)
-    {
-        lvover = lvl;
-    }
-
-    inline void adjustThrustOverride(double dlvl)
-    {
-        lvover += dlvl;
-    }
-};
-
-using thlist_t = std::vector<thrust_t *>;
-
-struct thrustgrp_t
-{
-    thlist_t thrusters;
-    double sum_maxth;
-};
-using tglist_t = std::vector<thrustgrp_t *>;
-
 // enum thrustType_t
 // {
 //     thgMain = 0,            // main thruster
@@ -335,13 +305,20 @@ public:
     VehicleBase(cjson &config);
     virtual ~VehicleBase() = default;
 
-    inline surface_t *getSurfaceParameters() { return &surfParam; }
-    inline csurface_t *getSurfaceParameters() const { return &surfParam; }
+    inline FlightStatus getFlightStatus() const         { return fsType; }
+
+    inline surface_t *getSurfaceParameters() { refreshSurfaceParam(); return &surfParam; }
+    inline csurface_t *getSurfaceParameters() const { refreshSurfaceParam(); return &surfParam; }
     
-    inline double getAltitudeMSL() const { return surfParam.alt0; }
-    inline double getAltitudeAGL() const { return surfParam.alt; }
+    inline double getAltitudeMSL() const { refreshSurfaceParam(); return surfParam.alt0; }
+    inline double getAltitudeAGL() const { refreshSurfaceParam(); return surfParam.alt; }
 
     void updateSurfaceParam();
+
+    // Surface parameters are not updated while coasting
+    // until something reads them.
+    inline void refreshSurfaceParam() const
+        { if (bSurfaceStale) const_cast<VehicleBase *>(this)->updateSurfaceParam(); }
     void updatePost();
 
     // virtual void getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt);
@@ -351,6 +328,7 @@ protected:
     FlightStatus fsType = fsFlight;
 
     surface_t surfParam;    // ship parameters in planet atomsphere
+    bool bSurfaceStale = false;
     // surface_t sp;               // surface parameters
 
     glm::dmat3  lhrot;      // Local horizon frame rotation
@@ -389,6 +367,10 @@ public:
 
     inline void clearTouchdownPoints()          { tpVertices.clear(); }
 
+    inline SuperVehicle *getSuperVehicle() const    { return superVehicle; }
+    inline int getPortCount() const                 { return ports.size(); }
+    inline const port_t *getPort(int idx) const     { return idx < ports.size() ? ports[idx] : nullptr; }
+
     inline glm::dvec3 *getCameraPosition()      { return &vcpos; }
     inline glm::dvec3 *getCameraDirection()     { return &vcdir; }
 
@@ -398,8 +380,10 @@ public:
     void initOrbiting(const glm::dvec3 &pos, const glm::dvec3 &vel, const glm::dvec3 &rot, const glm::dvec3 *vrot);
     void initDocked();
 
+    bool dock(int port, Vehicle *target, int tport);
+    bool undock();
+
     void getIntermediateMoments(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt) override;
-    bool addSurfaceForces(glm::dvec3 &acc, glm::dvec3 &am, const StateVectors &state, double tfrac, double dt) override;
     
     inline void setSize(double val)         { radius = (val / M_PER_KM) / 2; }
     inline void setEmptyMass(double val)    { emass = val; updateMass(); };
@@ -432,21 +416,36 @@ public:
 
     void updateRadiationForces();
     void updateAerodynamicForces();
+    void getAirfoilCoeffs(const airfoil_t *af, double aoa, double M, double Re,
+        double &cl, double &cm, double &cd);
     void updateThrustForces();
     void updateBodyForces();
+    void updateGround();
+    void touchdown(const glm::dvec3 &rpos, const glm::dvec3 &rvel);
+
+    inline bool isCoasting() const                  { return bCoasting; }
+    inline double getCoastUntil() const             { return coastUntil; }
+    bool isIdle() const;
+    inline void enableCoasting(bool enable)         { bEnableCoast = enable; bCoasting &= enable; }
+    double predictCoastEvent(double t) const;
+    void updateCoast();
+
+    bool detectEvents(vehEvent_t &ev) const;
+    void processEvent(const vehEvent_t &ev);
+    inline const vehEvent_t &getLastEvent() const   { return lastEvent; }
 
     void updatePost();
 
+    void saveState(Checkpoint &cp) const override;
+    bool restoreState(Checkpoint &cp) override;
+
     void drawHUD(HUDPanel *hud, Sketchpad *pad);
 
     tank_t *createPropellant(double maxMass, double mass = -1.0, double efficiency = 1.0);
     inline void setDefaultPropellant(tank_t *ts)        { dTank = ts; }
     inline tank_t *getDefaultPropellant()               { return dTank; }
-    inline double getPropellantLevel(tank_t *ts)
-        { return ts->maxMass ? (ts->mass/ts->maxMass) : 0.0; }
-
-    inline double computeAtmThrustScale(thrust_t *eng, double p) const
-        { return (!eng->pfac) ? std::max(0.0, 1.0 - p * eng->pfac) : 1.0; }
+    inline double getPropellantLevel(tank_t *ts)        { return thpool.getTankLevel(ts); }
+    inline bool isThrustActive() const                  { return thpool.isActive(); }
 
     thrust_t *createThruster(const glm::dvec3 &pos, const glm::dvec3 &dir, double maxth,
          tank_t *tank = nullptr, double isp = 0.0, double ispref = 0.0, double pref = 101.4e3);
@@ -483,6 +482,9 @@ public:
 
     airfoil_t *createAirfoil(airfoilType_t align, const glm::dvec3 &pos,
         affuncx_t cf, void *ctx, double c, double S, double A);
+    airfoil_t *createAirfoil(airfoilType_t align, const glm::dvec3 &pos,
+        const AeroTable *table, double c, double S, double A, int defl = -1);
+    void tabulateAirfoils();
     afctrl_t *createControlSurface(ControlType_t type, glm::dvec3 &ref,
         double area, double dcl, double axis, double delay, unsigned int anim);
     void setControlSurfaceLevel(ControlType_t ctrl, double level, bool transient, bool direct);
@@ -494,6 +496,7 @@ public:
     void createMesh(cstr_t &name, const glm::dvec3 &ofs = {});
     int getMeshCount() const        { return meshList.size(); }
     MeshEntry *getMesh(int idx)     { return idx < meshList.size() ? meshList[idx] : nullptr; }
+    const MeshEntry *getMesh(int idx) const { return idx < meshList.size() ? meshList[idx] : nullptr; }
 
     // Animation function calls
 
@@ -533,12 +536,13 @@ private:
     glm::dvec3 thrust;      // linear thrust force
     bool bActiveForce = false;
     bool bCollisionUpdate = false;      // Collision detection flag
-    bool enableGroundContact = false;
 
     // Collision detection parameters (touchdown points)
     std::vector<tdVertex_t> tpVertices; // touchdown vertices (vessel frame)
     glm::dvec3 tpNormal;                   // upward normal of touchdown plane (vessel frame)
     glm::dvec3 tpCGravity;                 // center of gravity projection
+    ContactSolver contact;                 // touchdown contact solver
+    groundState_t gstate;                  // landed/taxiing state
     int tpTires;
     double  cogElev;
     bool bSteeringEnable = false;
@@ -548,6 +552,10 @@ private:
 
     tank_t *dTank = nullptr; // default propellant tank
     bool bEnableBurnFuel = false;
+    bool bEnableCoast = true;           // Allow Keplerian coast mode
+    bool bCoasting = false;             // Propagated by orbital elements only
+    double coastUntil = 0.0;            // Next predicted event [s]
+    vehEvent_t lastEvent;               // Last detected trajectory event
     uint32_t navFlags = 0;              // Navigation controls
 
     int ctrlKeyThrusters[thgMaxThrusters];
@@ -555,10 +563,8 @@ private:
 
     std::vector<port_t *> ports;        // docking port list
 
-    std::vector<tank_t *> tankList;             // Propellant tank list
-    std::vector<thrust_t *> thrustList;         // Individual thruster list
+    ThrusterPool thpool;                        // Tanks, thrusters and groups
     std::vector<thrustgrp_t *> thgrpList;       // Main thruster group list
-    std::vector<thrustgrp_t *> thgrpUserList;   // User thruster group list
 
     // Aerodynamics parameters for planes
     std::vector<airfoil_t *> airfoilList;           // airfoil wing list
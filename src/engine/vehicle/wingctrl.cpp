@@ -7,6 +7,7 @@
 
 #include "main/core.h"
 #include "engine/vehicle/vehicle.h"
+#include "engine/vehicle/aerotab.h"
 
 airfoil_t *Vehicle::createAirfoil(airfoilType_t align, const glm::dvec3 &ref, affuncx_t cf, void *ctx, double c, double S, double A)
 {
@@ -28,6 +29,58 @@ airfoil_t *Vehicle::createAirfoil(airfoilType_t align, const glm::dvec3 &ref, af
     return wing;
 }
 
+airfoil_t *Vehicle::createAirfoil(airfoilType_t align, const glm::dvec3 &ref, const AeroTable *table,
+    double c, double S, double A, int defl)
+{
+    assert(table != nullptr);
+
+    // Deflection comes from control surface level (or none)
+    if (defl < -1 || defl >= AIRCTRL_NLEVEL)
+    {
+        ofsLogger->error("Vehicle {}: airfoil deflection control {} out of range - rejected\n",
+            getsName(), defl);
+        return nullptr;
+    }
+
+    airfoil_t *wing = new airfoil_t();
+
+    wing->align = align;
+    wing->ref = ref;
+    wing->c = c;
+    wing->A = A;
+    wing->S = S;
+
+    wing->table = table;
+    wing->defl = defl;
+
+    airfoilList.push_back(wing);
+
+    return wing;
+}
+
+// Sample module callbacks into coefficient tables at load time,
+// so no module code runs during flight. Only valid for callbacks
+// that depend on aoa, Mach and Reynolds number alone.
+void Vehicle::tabulateAirfoils()
+{
+    for (auto af : airfoilList)
+        if (af->table == nullptr && af->cfx != nullptr)
+            af->table = AeroTable::getSampled(af->cfx, this, af->ctx);
+}
+
+void Vehicle::getAirfoilCoeffs(const airfoil_t *af, double aoa, double M, double Re,
+    double &cl, double &cm, double &cd)
+{
+    cl = cm = cd = 0.0;
+    if (af->table != nullptr)
+    {
+        double defl = (af->defl >= 0) ? afctrlLevels[af->defl].curr : 0.0;
+        af->table->getCoeffs(aoa, M, Re, defl, cl, cm, cd);
+    }
+    else if (af->cfx != nullptr)
+        af->cfx(this, aoa, M, Re, af->ctx, cl, cm, cd);
+}
+
 afctrl_t *Vehicle::createControlSurface(ControlType_t type, glm::dvec3 &ref,
     double area, double dcl, double axis, double delay, unsigned int anim)
 {
@@ -132,8 +185,7 @@ void Vehicle::updateAerodynamicForces()
         switch (af->align)
         {
         case afHorizontal:
-            if (af->cfx != nullptr)
-                af->cfx(this, beta, sp.atmMach, Re0 * af->c, af->ctx, cl, cm, cd);
+            getAirfoilCoeffs(af, beta, sp.atmMach, Re0 * af->c, cl, cm, cd);
             S = (af->S != 0.0) ? af->S : fabs(ddir.z)*cs.z + fabs(ddir.x)*cs.z;
             l = cl * sp.atmPressure * S;
             d = cd * sp.atmPressure * S;
@@ -144,8 +196,7 @@ void Vehicle::updateAerodynamicForces()
             break;
 
         case afVertical:
-            if (af->cfx != nullptr)
-                af->cfx(this, aoa, sp.atmMach, Re0 * af->c, af->ctx, cl, cm, cd);
+            getAirfoilCoeffs(af, aoa, sp.atmMach, Re0 * af->c, cl, cm, cd);
             S = (af->S != 0.0) ? af->S : fabs(ddir.z)*cs.z + fabs(ddir.y)*cs.y;
             l = cl * sp.atmPressure * S;
             d = cd * sp.atmPressure * S;
@@ -7,7 +7,6 @@
 #include "universe/astro.h"
 #include "ephem/elements.h"
 
-static constexpr const double E_CIRCLE_LIMIT = 1e-8;
 static constexpr const double I_NOINC_LIMIT  = 1e-8;
 
 OrbitalElements::OrbitalElements(double a, double e, double i,
@@ -7,7 +7,6 @@
 #include "universe/astro.h"
 #include "ephem/elements.h"
 
-static const double E_CIRCLE_LIMIT = 1e-8;
 static const double I_NOINC_LIMIT  = 1e-8;
 
 OrbitalElements::OrbitalElements(double a, double e, double i,
@@ -61,7 +60,7 @@ void OrbitalElements::updatePolar(double t, double &r, double &ta)
         double ma = calculateMeanAnomaly(t);
         if (e < 1.0)
             ma = ofs::posangle(ma);
-        ta = calculateTrueAnomalyE(ma);
+        ta = calculateTrueAnomalyE(calculateEccentricAnomaly(ma));
     }
 
     r = p / (1.0 + e*cos(ta)); 
@@ -122,13 +121,54 @@ double OrbitalElements::calculateEccentricAnomaly(double ma)
     return E;
 }
 
+// Time from t until radius vector length next reaches rc [m].
+// Returns -1 if orbit never reaches that distance.
+double OrbitalElements::getTimeToRadius(double t, double rc) const
+{
+    if (e < E_CIRCLE_LIMIT || rc < pd || (e < 1.0 && rc > ad))
+        return -1.0;
+
+    double costa = std::clamp((p/rc - 1.0) / e, -1.0, 1.0);
+    double mnow = calculateMeanAnomaly(t);
+
+    if (e < 1.0) {      // closed orbit
+        // Crossings at mean anomaly +mc (outbound) and -mc (inbound)
+        double ea = 2.0 * atan(tan(0.5 * acos(costa)) / tmp);
+        double mc = ea - e * sin(ea);
+        mnow = ofs::posangle(mnow);
+        return std::min(ofs::posangle(mc - mnow), ofs::posangle(-mc - mnow)) / n;
+    } else {            // open orbit
+        double ea = acosh((e + costa) / (1.0 + e*costa));
+        double mc = e * sinh(ea) - ea;
+        if (mnow < -mc)
+            return (-mc - mnow) / n;
+        if (mnow < mc)
+            return (mc - mnow) / n;
+        return -1.0;
+    }
+}
+
+// Time from t until next periapsis (apo = false) or apoapsis
+// passage. Returns -1 for circular orbits or when open orbit
+// has already passed periapsis.
+double OrbitalElements::getTimeToApsis(double t, bool apo) const
+{
+    if (e < E_CIRCLE_LIMIT)
+        return -1.0;
+
+    double mnow = calculateMeanAnomaly(t);
+    if (e < 1.0)        // closed orbit
+        return ofs::posangle((apo ? pi : 0.0) - mnow) / n;
+    return (!apo && mnow < 0.0) ? -mnow / n : -1.0;
+}
+
 double OrbitalElements::calculateTrueAnomalyE(double ea)
 {
     if (e < 1.0) {      // closed orbit
         return 2.0 * atan(tmp * tan(0.5 * ea));
     } else {            // open orbit
         double coshea = cosh(ea);
-        double tra = acos((e - coshea)/(e*coshea) - 1.0);
+        double tra = acos((coshea - e)/(1.0 - e*coshea));
         return (ea >= 0.0) ? tra : -tra;
     }
 }
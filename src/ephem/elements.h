@@ -8,6 +8,8 @@
 #define NELEMENTS   6
 #define DEFAULT_ELEMENTS    { 1.0, 0.0, 0.0, 0.0, 0.0, 0.0 }
 
+#define E_CIRCLE_LIMIT      1e-8    // Eccentricity limit of circular orbit
+
 class OrbitalElements
 {
 public:
@@ -50,6 +52,8 @@ public:
 
     double calculateEccentricAnomaly(double ma);
     double calculateTrueAnomalyE(double ea);
+    double getTimeToRadius(double t, double rc) const;
+    double getTimeToApsis(double t, bool apo) const;
     bool getAscendingNode(glm::dvec3 &an) const;
     bool getDescendingNode(glm::dvec3 &dn) const;
 
@@ -24,6 +24,7 @@ AtmosphereEarthNRLMSISE00::AtmosphereEarthNRLMSISE00()
     //     nullptr // pointer to deltailed magnetic values
     // };
 
+    setEpoch(0);
 }
 
 str_t AtmosphereEarthNRLMSISE00::getsAtmName() const
@@ -41,56 +42,73 @@ void AtmosphereEarthNRLMSISE00::getAtmConstants(atmconst_t &atmc) const
     atmc.gamma = 1.4;
 }
 
-void AtmosphereEarthNRLMSISE00::getAtmParams(const iatmprm_t &in, atmprm_t &out)
+// Convert MJD epoch to day of year and seconds of day. Done
+// once per epoch, not on every atmosphere query.
+void AtmosphereEarthNRLMSISE00::setEpoch(double mjd)
 {
-    std::array<double, 7> ap = { 3.0 };
-    std::array<double, 9> d = { 0 };
-    std::array<double, 2> t = { 0 };
-
-    double ijd, mjd = 0;
+    double ijd;
     double h = 24.0 * modf(mjd, &ijd);
-    double doy;
-    double sec = h * 3600.0;
+    double c, e, mjd2;
+    int a, b, f, m, y;
 
-    double lat = ofs::degrees(in.lat);
-    double lng = ofs::degrees(in.lng);
-    double lst = h * lng / 15.0;
-    double f107a = 140;
-    double f107 = 140;
+    std::unique_lock<std::mutex> lock(muModel);
+    sec = h * 3600.0;
 
+    if (ijd < -100840)
+        c = ijd + 2401525.0;
+    else
     {
-        double c, e, mjd2;
-        int a, b, f, m, y;
-        if (ijd < -100840)
-            c = ijd + 2401525.0;
-        else
-        {
-            b = (int)((ijd + 532784.75) / 36524.25);
-            c = ijd + 2401526.0 + (b - b/4);
-        }
-        a = (int)((c - 122.1) / 365.25);
-        e = 365.0 * a + a/4;
-        f = (int)((c - e)/30.6001);
-        m = f-1 - 12 * (f/14);
-        y = a - 4715 - ((7 + m)/10) - 1;
-        double a2 = (double)(10000 * y + 1231);
-        if (a2 <= 15821004.1)
-            b = (y + 4716)/4 - 1181;
-        else
-            b = y/400 - y/100 + y/4;
-        mjd2 = 365.0 * y + b - 78576.0;
-        doy = (int)(mjd - mjd2);
-        // pmjd = mjd;
+        b = (int)((ijd + 532784.75) / 36524.25);
+        c = ijd + 2401526.0 + (b - b/4);
     }
+    a = (int)((c - 122.1) / 365.25);
+    e = 365.0 * a + a/4;
+    f = (int)((c - e)/30.6001);
+    m = f-1 - 12 * (f/14);
+    y = a - 4715 - ((7 + m)/10) - 1;
+    double a2 = (double)(10000 * y + 1231);
+    if (a2 <= 15821004.1)
+        b = (y + 4716)/4 - 1181;
+    else
+        b = y/400 - y/100 + y/4;
+    mjd2 = 365.0 * y + b - 78576.0;
+    doy = (int)(mjd - mjd2);
+}
+
+void AtmosphereEarthNRLMSISE00::getAtmParams(const iatmprm_t &in, atmprm_t &out)
+{
+    atmbatch_t batch = { 1, &in.alt, &in.lat, &in.lng, &out.p, &out.rho, &out.T };
+    getAtmBatch(batch);
+}
 
+// Model keeps intermediate results in its own members, so
+// queries are serialized. Inputs that depend only on epoch and
+// solar/geomagnetic indices are set up once per batch.
+void AtmosphereEarthNRLMSISE00::getAtmBatch(const atmbatch_t &batch)
+{
+    std::unique_lock<std::mutex> lock(muModel);
 
-    atm.gtd7(doy, sec, in.alt, lat, lng, lst, f107a, f107, ap, d, t);
+    std::array<double, 7> ap = { 3.0 };
+    std::array<double, 9> d;
+    std::array<double, 2> t;
 
-    double n = d[0] + d[1] + d[2] + d[3] + d[4] + d[6] + d[7];
+    double uth = sec / 3600.0;
+    double f107a = 140;
+    double f107 = 140;
     double k = 1.380649e-23 * 1e6; // Boltzmann constant and scale conversion of cm^3 to m^-3
 
-    out.T = t[1];
-    out.rho = d[5];
-    out.p = n*k*out.T;
+    for (int idx = 0; idx < batch.n; idx++)
+    {
+        double lat = ofs::degrees(batch.lat[idx]);
+        double lng = ofs::degrees(batch.lng[idx]);
+        double lst = fmod(uth + lng / 15.0 + 24.0, 24.0);
+
+        atm.gtd7(doy, sec, batch.alt[idx], lat, lng, lst, f107a, f107, ap, d, t);
 
+        double n = d[0] + d[1] + d[2] + d[3] + d[4] + d[6] + d[7];
+
+        batch.T[idx] = t[1];
+        batch.rho[idx] = d[5] * 1e3;   // g/cm^3 to kg/m^3
+        batch.p[idx] = n*k*t[1];
+    }
 }
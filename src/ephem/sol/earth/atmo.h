@@ -17,12 +17,16 @@ public:
     AtmosphereEarthNRLMSISE00();
 
     str_t getsAtmName() const override;
+    // 2 - density converted from g/cm^3 to kg/m^3
+    uint32_t getAtmVersion() const override { return 2; }
     void getAtmConstants(atmconst_t &atmc) const override;
     void getAtmParams(const iatmprm_t &in, atmprm_t &out) override;
+    void getAtmBatch(const atmbatch_t &batch) override;
 
-private:
-    atmos::CNrlmsise00 atm;
+    void setEpoch(double mjd);
 
+private:
+    // Must be declared before atm (initialized from it)
     const std::array<int, 24> swFlags = 
         {
             0, 1, 1, 1, 1, 1,
@@ -30,4 +34,10 @@ private:
             1, 1, 1, 1, 1, 1,
             1, 1, 1, 1, 1, 1
         };
+
+    atmos::CNrlmsise00 atm;
+    std::mutex muModel;
+
+    double doy = 0;         // Day of year
+    double sec = 0;         // Seconds of day [UT]
 };
\ No newline at end of file
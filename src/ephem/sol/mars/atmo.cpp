@@ -21,7 +21,30 @@ void AtmosphereMars2006::getAtmConstants(atmconst_t &atmc) const
     atmc.gamma = 1.2941;
 }
 
+// Temperature profile (altitude [km], T [K], dT/dz [K/km])
+static const atmlayer_t marsLayers[] = {
+    {   0.0, 242.15, -0.998 },
+    {   7.0, 235.17, -2.22  },
+    {  45.0, 150.81,  0.0   }
+};
+
 void AtmosphereMars2006::getAtmParams(const iatmprm_t &in, atmprm_t &out)
 {
+    atmconst_t atmc;
+    getAtmConstants(atmc);
+    getLayeredParams(marsLayers, ARRAY_SIZE(marsLayers), atmc.p0, atmc.R, 3.711, in.alt, out);
+}
 
+void AtmosphereMars2006::getAtmBatch(const atmbatch_t &batch)
+{
+    atmconst_t atmc;
+    getAtmConstants(atmc);
+    for (int idx = 0; idx < batch.n; idx++)
+    {
+        atmprm_t out;
+        getLayeredParams(marsLayers, ARRAY_SIZE(marsLayers), atmc.p0, atmc.R, 3.711, batch.alt[idx], out);
+        batch.p[idx]   = out.p;
+        batch.rho[idx] = out.rho;
+        batch.T[idx]   = out.T;
+    }
 }
@@ -21,7 +21,30 @@ void AtmosphereVenus2006::getAtmConstants(atmconst_t &atmc) const
     atmc.gamma = 1.2857;
 }
 
+// Temperature profile (altitude [km], T [K], dT/dz [K/km])
+static const atmlayer_t venusLayers[] = {
+    {   0.0, 737.0, -7.75 },
+    {  60.0, 272.0, -1.70 },
+    { 100.0, 204.0,  0.0  }
+};
+
 void AtmosphereVenus2006::getAtmParams(const iatmprm_t &in, atmprm_t &out)
 {
+    atmconst_t atmc;
+    getAtmConstants(atmc);
+    getLayeredParams(venusLayers, ARRAY_SIZE(venusLayers), atmc.p0, atmc.R, 8.87, in.alt, out);
+}
 
+void AtmosphereVenus2006::getAtmBatch(const atmbatch_t &batch)
+{
+    atmconst_t atmc;
+    getAtmConstants(atmc);
+    for (int idx = 0; idx < batch.n; idx++)
+    {
+        atmprm_t out;
+        getLayeredParams(venusLayers, ARRAY_SIZE(venusLayers), atmc.p0, atmc.R, 8.87, batch.alt[idx], out);
+        batch.p[idx]   = out.p;
+        batch.rho[idx] = out.rho;
+        batch.T[idx]   = out.T;
+    }
 }
@@ -15,4 +15,5 @@ public:
     str_t getsAtmName() const override;
     void getAtmConstants(atmconst_t &atmc) const override;
     void getAtmParams(const iatmprm_t &in, atmprm_t &out) override;
+    void getAtmBatch(const atmbatch_t &batch) override;
 };
\ No newline at end of file
@@ -16,10 +16,11 @@
 #include "universe/astro.h"
 // #include "render/scene.h"
 #include "control/panel.h"
-#include "engine/dlgcam.h"
-#include "main/guimgr.h"
 #include "main/app.h"
+#include "main/profiler.h"
+#include "main/checkpoint.h"
 #include "utils/json.h"
+#include "utils/threadpool.h"
 
 // Global variables
 CoreApp *ofsAppCore = nullptr;
@@ -37,40 +38,29 @@ CoreApp::CoreApp()
 void CoreApp::init()
 {
     ofsLogger = new Logger(Logger::logDebug, "ofs.log");
+    ofsLogger->setCategoryLevel(Logger::catConfig, Logger::logInfo);
+    ofsProfiler = new Profiler();
     ofsDate = &td;
 
-    if (glfwInit() != GLFW_TRUE)
-    {
-        ofsLogger->fatal("OFS: Unable to initialize GLFW interface.\n");
-        abort();
-    }
-    ofsLogger->info("OFS: Loaded GLFW version: {}\n",
-        glfwGetVersionString());
+    threadPool = new ThreadPool();
+    ofsLogger->info("OFS: Started {} worker threads\n", threadPool->getThreadCount());
 
     // camera = new Camera(width, height);
 
     // Loading startup modules
     loadStartupModules();
-
-    // Loading plugin modules
-#ifdef OFS_LIBRARY_DIR
-    str_t libpath = OFS_LIBRARY_DIR;
-    loadModule(libpath + "/plugin", "glclient");
-#else
-    loadModule("modules/plugin", "glclient");
-#endif
-
-    // Initialize graphics client module
-    if (gclient != nullptr)
-        createSceneWindow();
 }
 
 void CoreApp::cleanup()
 {
     // Unloading modules
 
-    if (guimgr != nullptr)
-        delete guimgr;
+    if (threadPool != nullptr)
+        delete threadPool;
+    threadPool = nullptr;
+
+    // Write out all pending log messages
+    ofsLogger->flush();
 }
 
 void CoreApp::setFocusingObject(Celestial *object)
@@ -86,20 +76,51 @@ void CoreApp::setFocusingObject(Celestial *object)
 void CoreApp::launch()
 {
     fs::path homePath = OFS_HOME_DIR;
-    fs::path startPath = homePath / "scen/start.json";
+    launch(homePath / "scen/start.json");
+}
+
+void CoreApp::launch(const fs::path &startPath)
+{
     ofsLogger->info("Open file: {}\n", startPath.string());
-    std::ifstream inFile(homePath / "scen/start.json");
+    std::ifstream inFile(startPath);
     if (!inFile.is_open()) {
-        ofsLogger->info("File {}: {} - aborted\n",
+        ofsLogger->fatal("File {}: {} - aborted\n",
             startPath.string(), strerror(errno));
         abort();
     }
     json config = json::parse(inFile, nullptr, false, true);
 
-    universe = new Universe();
-    universe->init();
-    universe->configure(config);
+    {
+        ProfileScope scope("Load universe");
+
+        // Build startup task graph and run all loads
+        // concurrently on worker threads.
+        TaskGraph startup;
+        universe = new Universe();
+        universe->init(startup);
+        universe->configure(config, startup);
+        ofsLogger->info("Running {} startup tasks on {} threads\n",
+            startup.getTaskCount(), threadPool->getThreadCount());
+        try
+        {
+            startup.run(*threadPool);
+        }
+        catch (const std::exception &e)
+        {
+            ofsLogger->error("Startup failed: {} - aborted\n", e.what());
+            abort();
+        }
+    }
+
     openSession(config);
+
+    if (ofsProfiler != nullptr)
+    {
+        ofsProfiler->report("startup");
+        ofsProfiler->report("task");
+        ofsProfiler->writeChromeTrace("ofs-startup.json");
+        ofsProfiler->endStartup();
+    }
 }
 
 void CoreApp::openSession(json &config)
@@ -116,18 +137,32 @@ void CoreApp::openSession(json &config)
     td.reset(nowTime.count(), mjdref);
     prevTime = now;
 
-    VideoData *video = gclient->getVideoData();
+    // Deterministic fixed-step clock mode
+    setFixedTimeStep(myjson::getFloat<double>(config, "fixedStep", td.getFixedStep()));
+
+    // Default viewport size for running without graphics client
+    int width = 1920, height = 1080;
+    if (gclient != nullptr) {
+        VideoData *video = gclient->getVideoData();
+        width = video->width;
+        height = video->height;
+        panel = new Panel(gclient, width, height, 8);
+    }
 
-    player = new Player(&td, video->width, video->height);
-    panel = new Panel(gclient, video->width, video->height, 8);
-    guimgr->setPlayer(player);
+    player = new Player(&td, width, height);
 
     // initializing solar system with
     // new time for that session.
-    universe->start();
+    {
+        ProfileScope scope("Start universe");
+        universe->start();
+    }
 
     // Now load and configure vehicles (ships)
-    universe->configureVehicles(config);
+    {
+        ProfileScope scope("Load vehicles");
+        universe->configureVehicles(config);
+    }
 
     // Now configure player
     json pconfig;
@@ -143,16 +178,22 @@ void CoreApp::openSession(json &config)
     player->configure(pconfig);
 
     if (gclient != nullptr) {
+        ProfileScope scope("Start graphics client");
         gclient->cbStart(universe);
         gclient->showWindow();
     }
 
-    panel->init(config);
-    if (player->isExternal())
-        panel->setPanelMode(PANEL_PLANET);
+    if (panel != nullptr) {
+        panel->init(config);
+        if (player->isExternal())
+            panel->setPanelMode(PANEL_PLANET);
+    }
 
     // Finalize all vehicles after creation
-    universe->finalizePostCreation();
+    {
+        ProfileScope scope("Finalize vehicles");
+        universe->finalizePostCreation();
+    }
 
     bSession = true;
 
@@ -182,6 +223,66 @@ void CoreApp::closeSession()
     bSession = false;
 }
 
+bool CoreApp::saveCheckpoint(Checkpoint &cp)
+{
+    CheckpointHeader hdr = {};
+    hdr.magic = CHECKPOINT_MAGIC;
+    hdr.version = CHECKPOINT_VERSION;
+    hdr.size = sizeof(hdr);
+    hdr.flags = td.isFixedStep() ? CHECKPOINT_FIXEDSTEP : 0;
+    hdr.simt = td.getSimTime0();
+    hdr.mjd = td.getMJD0();
+
+    cp.clear();
+    cp.write(hdr);
+    td.saveState(cp);
+    universe->saveState(cp);
+
+    ofsLogger->info("Checkpoint: Saved at MJD {} ({} bytes)\n",
+        hdr.mjd, cp.getSize());
+    return true;
+}
+
+bool CoreApp::restoreCheckpoint(Checkpoint &cp)
+{
+    CheckpointHeader hdr;
+
+    cp.rewind();
+    if (!cp.read(hdr) || hdr.magic != CHECKPOINT_MAGIC ||
+        hdr.version < CHECKPOINT_MINVERSION || hdr.version > CHECKPOINT_VERSION ||
+        hdr.size != sizeof(hdr))
+    {
+        ofsLogger->error("Checkpoint: Invalid checkpoint header\n");
+        return false;
+    }
+    cp.setVersion(hdr.version);
+
+    if (!td.restoreState(cp) || !universe->restoreState(cp))
+    {
+        ofsLogger->error("Checkpoint: Restore failed - world state may be inconsistent\n");
+        return false;
+    }
+
+    // Do not count wall time spent on restoring.
+    prevTime = std::chrono::system_clock::now();
+
+    ofsLogger->info("Checkpoint: Restored at MJD {} Date: {}\n",
+        hdr.mjd, astro::getMJDDateStr(hdr.mjd));
+    return true;
+}
+
+bool CoreApp::saveCheckpoint(const fs::path &fname)
+{
+    Checkpoint cp;
+    return saveCheckpoint(cp) && cp.save(fname);
+}
+
+bool CoreApp::restoreCheckpoint(const fs::path &fname)
+{
+    Checkpoint cp;
+    return cp.load(fname) && restoreCheckpoint(cp);
+}
+
 void CoreApp::updateWorld()
 {
     universe->update(player, td);
@@ -205,21 +306,6 @@ bool CoreApp::detachGraphicsClient(GraphicsClient *gc)
     return true;
 }
 
-void CoreApp::createSceneWindow()
-{
-    if (gclient == nullptr)
-        exit(EXIT_FAILURE);
-    guimgr = new GUIManager(gclient);
-
-    // Initialize callbacks for window events
-    guimgr->setupCallbacks();
-
-    dlgCamera = new DialogCamera("Camera");
-
-    guimgr->registerControl(dlgCamera);
-
-}
-
 void CoreApp::renderScene()
 {
     if (gclient != nullptr)
@@ -253,33 +339,6 @@ void CoreApp::setWindowTitle(cstr_t &title)
         gclient->cbSetWindowTitle(title);
 }
 
-void CoreApp::run()
-{
-    while (!guimgr->shouldClose())
-    {
-        // Process polling events
-        guimgr->pollEvents();
-        
-        if (bSession)
-        {
-            if (beginTimeStep(bRunning))
-            {
-                updateWorld();
-                endTimeStep(bRunning);
-            }
-
-            processUserInputs();
-        }
-
-        renderScene();
-        drawHUD();
-        guimgr->render();
-        displayFrame();
-    }
-
-    closeSession();
-}
-
 // ******** Time/date updating routines/controls ********
 
 bool CoreApp::beginTimeStep(bool running)
@@ -332,6 +391,13 @@ void CoreApp::setWarpFactor(double warp)
         td.setTimeWarp(warp);
 }
 
+void CoreApp::setFixedTimeStep(double dt)
+{
+    td.setFixedStep(dt);
+    if (td.isFixedStep())
+        ofsLogger->info("Fixed-step clock mode: {} s per step\n", td.getFixedStep());
+}
+
 void CoreApp::increaseTimeWarp()
 {
     const double eps = 1e-6;
@@ -508,9 +574,6 @@ void CoreApp::processUserInputs()
 
 void CoreApp::keyBufferedSystem(uint8_t key)
 {
-    // if (stateKey[ofs::keyF5] || stateKey[ofs::key5])
-    //     guimgr->showControl<DialogCamera>();
-
     if (player->isInternal()) {
         if (keymap.isLogicalKey(key, keyState, ofs::lkeyObserverResetHome))
             player->resetCockpitDir();
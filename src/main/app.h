@@ -16,10 +16,10 @@ class Camera;
 class View;
 class Panel;
 class GraphicsClient;
-class GUIManager;
 class Celestial;
 class Vehicle;
-class DialogCamera;
+class ThreadPool;
+class Checkpoint;
 
 
 struct ModuleEntry
@@ -38,7 +38,7 @@ public:
     // Virtual main function calls packages
     virtual void init();
     virtual void cleanup();
-    virtual void run();
+    virtual void run() = 0;
 
     inline GraphicsClient *getClient() { return gclient; }
     inline Camera    *getCamera()   { return player->getCamera(); }
@@ -46,11 +46,19 @@ public:
     inline Panel     *getPanel()    { return panel; }
     inline Universe  *getUniverse() { return universe; }
     inline Keymap    &getKeymap()   { return keymap; }
+    inline ThreadPool *getThreadPool() { return threadPool; }
 
     void launch();
+    void launch(const fs::path &scenario);
     void openSession(json &config);
     void closeSession();
     void updateWorld();
+
+    // Simulation state checkpoints
+    bool saveCheckpoint(Checkpoint &cp);
+    bool restoreCheckpoint(Checkpoint &cp);
+    bool saveCheckpoint(const fs::path &fname);
+    bool restoreCheckpoint(const fs::path &fname);
     void renderScene();
     // void render2D();
     void drawHUD();
@@ -66,7 +74,6 @@ public:
 
     bool attachGraphicsClient(GraphicsClient *gc);
     bool detachGraphicsClient(GraphicsClient *gc);
-    void createSceneWindow();
 
     void displayFrame();
     void setWindowTitle(cstr_t &title);
@@ -75,6 +82,7 @@ public:
     bool beginTimeStep(bool running);
     void endTimeStep(bool running);
     void setWarpFactor(double warp);
+    void setFixedTimeStep(double dt);
     void increaseTimeWarp();
     void decreaseTimeWarp();
     void pause(bool flag);
@@ -88,7 +96,7 @@ public:
     void keyPress(uint8_t key, bool down);
 
     void processUserInputs();
-    void keyBufferedSystem(uint8_t key);
+    virtual void keyBufferedSystem(uint8_t key);
     void keyBufferedOnRunning(uint8_t key);
     void keyImmediateSystem();
     void keyImmediateOnRunning();
@@ -110,13 +118,12 @@ protected:
     // Camera   *camera = nullptr;
     // Camerax  *camerax = nullptr;
 
-    GUIManager *guimgr = nullptr;
-    DialogCamera *dlgCamera = nullptr;
-
     Panel    *panel = nullptr;
 
     GraphicsClient *gclient = nullptr;
 
+    ThreadPool *threadPool = nullptr;
+
     // Focusing vehicle object
     Celestial *focObject = nullptr;
     Vehicle *focVehicle = nullptr;
@@ -0,0 +1,240 @@
+// batch.cpp - Headless batch runner package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "engine/vehicle/vehicle.h"
+#include "universe/universe.h"
+#include "universe/body.h"
+#include "main/profiler.h"
+#include "main/batch.h"
+#include "utils/threadpool.h"
+
+extern bool ofsStateUpdate;
+
+void BatchApp::init()
+{
+    ofsLogger = new Logger(Logger::logInfo, "ofs-batch.log");
+    ofsProfiler = new Profiler();
+    ofsDate = &td;
+
+    threadPool = new ThreadPool();
+    ofsLogger->info("OFS: Started {} worker threads\n", threadPool->getThreadCount());
+
+    // No graphics client and no GLFW window - only
+    // startup modules (vehicles load their own).
+    loadStartupModules();
+}
+
+void BatchApp::cleanup()
+{
+    if (threadPool != nullptr)
+        delete threadPool;
+    threadPool = nullptr;
+
+    ofsLogger->flush();
+}
+
+void BatchApp::stepWorld(double dt)
+{
+    td.beginStep(dt, true);
+    ofsStateUpdate = true;
+
+    updateWorld();
+    endTimeStep(true);
+}
+
+void BatchApp::dumpStateVectors(std::ostream &out)
+{
+    for (auto psys : universe->getSystemList())
+    {
+        for (int idx = 0; idx < psys->getVehiclesSize(); idx++)
+        {
+            Vehicle *veh = psys->getVehicle(idx);
+            glm::dvec3 pos = veh->getgPosition();
+            glm::dvec3 vel = veh->getgVelocity();
+
+            out << std::format("{:.3f},{:.10f},{},{},{:.6f},{:.6f},{:.6f},{:.9f},{:.9f},{:.9f}\n",
+                td.getSimTime0(), td.getMJD0(), psys->getName(), veh->getsName(),
+                pos.x, pos.y, pos.z, vel.x, vel.y, vel.z);
+        }
+    }
+}
+
+void BatchApp::reportStatistics(std::vector<double> &stepTimes, double simTime, double wallTime)
+{
+    if (stepTimes.empty())
+        return;
+
+    std::sort(stepTimes.begin(), stepTimes.end());
+
+    double total = 0.0;
+    for (auto t : stepTimes)
+        total += t;
+
+    auto percentile = [&](double p)
+        { return stepTimes[std::min(stepTimes.size() - 1, size_t(p * stepTimes.size()))]; };
+
+    ofsLogger->info("Batch run: {} steps, {:.3f} s simulated in {:.3f} s ({:.1f}x real time)\n",
+        stepTimes.size(), simTime, wallTime, simTime / wallTime);
+    ofsLogger->info("Step time [ms]: mean {:.3f} min {:.3f} p50 {:.3f} p99 {:.3f} max {:.3f}\n",
+        total / stepTimes.size() * 1000.0, stepTimes.front() * 1000.0,
+        percentile(0.50) * 1000.0, percentile(0.99) * 1000.0, stepTimes.back() * 1000.0);
+}
+
+// Compare scalar and batch atmosphere queries at random points
+// on every planet with atmosphere, also split on worker pool.
+void BatchApp::benchmarkAtmosphere(int nPoints)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::vector<double> alt(nPoints), lat(nPoints), lng(nPoints);
+    std::vector<double> p(nPoints), rho(nPoints), T(nPoints);
+    std::vector<double> rho1(nPoints);
+    atmbatch_t batch = { nPoints, alt.data(), lat.data(), lng.data(), p.data(), rho.data(), T.data() };
+
+    auto elapsed = [](clock::time_point t0, int n)
+        { return std::chrono::duration<double, std::micro>(clock::now() - t0).count() / n; };
+
+    srand(1);
+    for (auto psys : universe->getSystemList())
+    {
+        for (auto body : psys->getBodies())
+        {
+            CelestialPlanet *planet = dynamic_cast<CelestialPlanet *>(body);
+            if (planet == nullptr || !planet->hasAtmosphere())
+                continue;
+
+            double altLimit = planet->getAtmConstants().altLimit;
+            for (int idx = 0; idx < nPoints; idx++)
+            {
+                alt[idx] = altLimit * rand() / RAND_MAX;
+                lat[idx] = (double(rand()) / RAND_MAX - 0.5) * pi;
+                lng[idx] = double(rand()) / RAND_MAX * pi2;
+            }
+
+            // Model without lookup table
+            Atmosphere *atm = planet->getAtmosphere();
+            auto t0 = clock::now();
+            atm->getAtmBatch(batch);
+            double tModel = elapsed(t0, nPoints);
+
+            t0 = clock::now();
+            for (int idx = 0; idx < nPoints; idx++)
+            {
+                atmprm_t prm;
+                planet->getAtmParam({ lat[idx], lng[idx], alt[idx] }, &prm);
+                rho1[idx] = prm.rho;
+            }
+            double tScalar = elapsed(t0, nPoints);
+
+            t0 = clock::now();
+            planet->getAtmParams(batch);
+            double tBatch = elapsed(t0, nPoints);
+
+            t0 = clock::now();
+            planet->getAtmParams(batch, threadPool);
+            double tPool = elapsed(t0, nPoints);
+
+            double dev = 0.0;
+            for (int idx = 0; idx < nPoints; idx++)
+                if (rho1[idx] > 0.0)
+                    dev = std::max(dev, fabs(rho[idx] / rho1[idx] - 1.0));
+
+            ofsLogger->info("Atmosphere {}: {} points, per point [us]: model {:.3f} scalar {:.3f} "
+                "batch {:.3f} pool {:.3f} (batch/scalar deviation {:.2e})\n",
+                planet->getsName(), nPoints, tModel, tScalar, tBatch, tPool, dev);
+        }
+    }
+}
+
+void BatchApp::run()
+{
+    using clock = std::chrono::steady_clock;
+
+    if (timeStep <= 0.0)
+    {
+        ofsLogger->error("Batch run: Invalid time step {} - aborted\n", timeStep);
+        closeSession();
+        return;
+    }
+
+    if (atmBenchPoints > 0)
+    {
+        benchmarkAtmosphere(atmBenchPoints);
+        closeSession();
+        return;
+    }
+
+    // Fixed steps independent of wall clock - same
+    // scenario or checkpoint gives same results.
+    setFixedTimeStep(timeStep);
+
+    if (!restoreName.empty() && !restoreCheckpoint(restoreName))
+    {
+        closeSession();
+        return;
+    }
+
+    std::ofstream out(outputName, std::ios::out);
+    if (!out.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", outputName.string(), strerror(errno));
+        closeSession();
+        return;
+    }
+    out << "simt,mjd,system,vehicle,x,y,z,vx,vy,vz\n";
+    dumpStateVectors(out);
+
+    std::vector<double> stepTimes;
+    stepTimes.reserve(size_t(duration / timeStep) + 1);
+
+    double startTime = td.getSimTime0();
+    double endTime = startTime + duration;
+    double nextDump = startTime + dumpInterval;
+    auto start = clock::now();
+
+    // Ignore round-off left over from summing steps
+    double eps = timeStep * 1e-6;
+    while (endTime - td.getSimTime0() > eps)
+    {
+        // Shorten last step to end exactly at requested duration
+        double dt = std::min(timeStep, endTime - td.getSimTime0());
+        if (dt < timeStep)
+            td.setFixedStep(dt);
+
+        auto t0 = clock::now();
+        stepWorld(dt);
+        std::chrono::duration<double> elapsed = clock::now() - t0;
+        stepTimes.push_back(elapsed.count());
+
+        if (dumpInterval > 0.0 && td.getSimTime0() >= nextDump)
+        {
+            dumpStateVectors(out);
+            nextDump += dumpInterval;
+        }
+
+        // Hold simulation time at fixed warp against wall clock
+        if (pacedWarp > 0.0)
+        {
+            auto target = start + std::chrono::duration_cast<clock::duration>(
+                std::chrono::duration<double>((td.getSimTime0() - startTime) / pacedWarp));
+            std::this_thread::sleep_until(target);
+        }
+    }
+
+    std::chrono::duration<double> wallTime = clock::now() - start;
+    td.setFixedStep(timeStep);
+
+    dumpStateVectors(out);
+    out.close();
+
+    if (!checkpointName.empty())
+        saveCheckpoint(checkpointName);
+
+    reportStatistics(stepTimes, td.getSimTime0() - startTime, wallTime.count());
+    closeSession();
+}
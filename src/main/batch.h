@@ -0,0 +1,48 @@
+// batch.h - Headless batch runner package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#include "main/app.h"
+
+// Batch runner - run scenario without window or graphics
+// client as fast as possible or at fixed time warp, dumping
+// vehicle state vectors and timing statistics.
+class BatchApp : public CoreApp
+{
+public:
+    BatchApp() = default;
+    virtual ~BatchApp() = default;
+
+    inline void setDuration(double secs)        { duration = secs; }
+    inline void setTimeStep(double secs)        { timeStep = secs; }
+    inline void setPacedWarp(double warp)       { pacedWarp = warp; }
+    inline void setDumpInterval(double secs)    { dumpInterval = secs; }
+    inline void setOutputFile(const fs::path &fname) { outputName = fname; }
+    inline void setCheckpointFile(const fs::path &fname) { checkpointName = fname; }
+    inline void setRestoreFile(const fs::path &fname) { restoreName = fname; }
+    inline void setAtmBenchmark(int points)     { atmBenchPoints = points; }
+
+    void init() override;
+    void cleanup() override;
+    void run() override;
+
+protected:
+    void stepWorld(double dt);
+    void dumpStateVectors(std::ostream &out);
+    void reportStatistics(std::vector<double> &stepTimes, double simTime, double wallTime);
+    void benchmarkAtmosphere(int nPoints);
+
+private:
+    double duration = 3600.0;       // Simulation duration [s]
+    double timeStep = 1.0 / 60.0;   // Simulation time step [s]
+    double pacedWarp = 0.0;         // Fixed time warp (0 = as fast as possible)
+    double dumpInterval = 60.0;     // State vector dump interval [s]
+    int atmBenchPoints = 0;         // Atmosphere benchmark points (0 = no benchmark)
+
+    fs::path outputName = "ofs-states.csv";
+    fs::path checkpointName;        // Checkpoint saved at end of run
+    fs::path restoreName;           // Checkpoint restored at start of run
+};
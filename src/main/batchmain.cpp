@@ -0,0 +1,80 @@
+// batchmain.cpp - Main OFS batch runner routines
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#include "main/core.h"
+#include "main/batch.h"
+
+static void usage(cchar_t *name)
+{
+    std::cout << "Usage: " << name << " [options] <scenario.json>\n"
+              << "  -d <secs>   Simulation duration (default 3600)\n"
+              << "  -s <secs>   Simulation time step (default 1/60)\n"
+              << "  -w <warp>   Run at fixed time warp (default as fast as possible)\n"
+              << "  -i <secs>   State vector dump interval (default 60, 0 = start/end only)\n"
+              << "  -o <file>   State vector output file (default ofs-states.csv)\n"
+              << "  -c <file>   Save checkpoint at end of run\n"
+              << "  -r <file>   Restore checkpoint before run\n"
+              << "  -a <n>      Benchmark atmosphere queries at n points and exit\n";
+}
+
+int main(int argc, char **argv)
+{
+    BatchApp *app = new BatchApp();
+    fs::path scenario;
+
+    for (int idx = 1; idx < argc; idx++)
+    {
+        str_t arg = argv[idx];
+
+        if (arg[0] != '-')
+        {
+            scenario = arg;
+            continue;
+        }
+        if (idx + 1 >= argc)
+        {
+            usage(argv[0]);
+            exit(1);
+        }
+
+        cchar_t *val = argv[++idx];
+        if (arg == "-d")
+            app->setDuration(atof(val));
+        else if (arg == "-s")
+            app->setTimeStep(atof(val));
+        else if (arg == "-w")
+            app->setPacedWarp(atof(val));
+        else if (arg == "-i")
+            app->setDumpInterval(atof(val));
+        else if (arg == "-o")
+            app->setOutputFile(val);
+        else if (arg == "-c")
+            app->setCheckpointFile(val);
+        else if (arg == "-r")
+            app->setRestoreFile(val);
+        else if (arg == "-a")
+            app->setAtmBenchmark(atoi(val));
+        else
+        {
+            usage(argv[0]);
+            exit(1);
+        }
+    }
+
+    if (scenario.empty())
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    ofsAppCore = app;
+    app->init();
+    app->launch(scenario);
+    app->run();
+    app->cleanup();
+
+    delete app;
+    exit(0);
+}
@@ -0,0 +1,93 @@
+// checkpoint.cpp - Simulation state checkpoint package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "main/checkpoint.h"
+
+void Checkpoint::clear()
+{
+    data.clear();
+    rpos = 0;
+    version = CHECKPOINT_VERSION;
+    bFailed = false;
+}
+
+void Checkpoint::rewind()
+{
+    rpos = 0;
+    bFailed = false;
+}
+
+void Checkpoint::writeString(cstr_t &str)
+{
+    write<uint32_t>(str.size());
+    data.insert(data.end(), str.begin(), str.end());
+}
+
+bool Checkpoint::readString(str_t &str)
+{
+    uint32_t len;
+    if (!read(len) || rpos + len > data.size())
+        return !(bFailed = true);
+    str.assign((const char *)data.data() + rpos, len);
+    rpos += len;
+    return true;
+}
+
+void Checkpoint::writeBlob(const std::vector<uint8_t> &blob)
+{
+    write<uint32_t>(blob.size());
+    data.insert(data.end(), blob.begin(), blob.end());
+}
+
+bool Checkpoint::readBlob(std::vector<uint8_t> &blob)
+{
+    uint32_t len;
+    if (!read(len) || rpos + len > data.size())
+        return !(bFailed = true);
+    blob.assign(data.begin() + rpos, data.begin() + rpos + len);
+    rpos += len;
+    return true;
+}
+
+bool Checkpoint::save(const fs::path &fname) const
+{
+    std::ofstream ofile(fname, std::ios::binary|std::ios::out);
+    if (!ofile.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), strerror(errno));
+        return false;
+    }
+
+    ofile.write((char *)data.data(), data.size());
+    ofile.close();
+
+    return !ofile.fail();
+}
+
+bool Checkpoint::load(const fs::path &fname)
+{
+    std::ifstream ifile(fname, std::ios::binary|std::ios::in|std::ios::ate);
+    if (!ifile.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), strerror(errno));
+        return false;
+    }
+
+    clear();
+    data.resize(ifile.tellg());
+    ifile.seekg(0);
+    ifile.read((char *)data.data(), data.size());
+    if (ifile.fail())
+    {
+        ofsLogger->error("File '{}': Truncated checkpoint file\n", fname.string());
+        clear();
+        return false;
+    }
+
+    return true;
+}
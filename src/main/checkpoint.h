@@ -0,0 +1,76 @@
+// checkpoint.h - Simulation state checkpoint package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#define CHECKPOINT_MAGIC        0x4b434643  // 'CFCK'
+#define CHECKPOINT_VERSION      4
+#define CHECKPOINT_MINVERSION   3           // Oldest version still restored
+
+#define CHECKPOINT_FIXEDSTEP    0x0001      // Saved in fixed-step mode
+
+struct CheckpointHeader
+{
+    uint32_t magic;         // checkpoint magic code
+    uint32_t version;       // checkpoint format version
+    uint32_t size;          // header size
+    uint32_t flags;         // checkpoint flags
+    double   simt;          // simulation time [s]
+    double   mjd;           // Modified Julian date [days]
+};
+
+// Compact binary snapshot of simulation state
+//
+// Snapshot is held in memory so that one saved state can be
+// restored many times (what-if runs) without touching disk.
+// Values are stored as raw bytes in native byte order - restore
+// requires same build and same scenario loaded.
+class OFSAPI Checkpoint
+{
+public:
+    Checkpoint() = default;
+    ~Checkpoint() = default;
+
+    inline size_t getSize() const       { return data.size(); }
+    inline bool isValid() const         { return !bFailed; }
+    inline uint32_t getVersion() const  { return version; }
+    inline void setVersion(uint32_t ver) { version = ver; }
+
+    void clear();
+    void rewind();
+
+    template <typename T>
+    void write(const T &val)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoint: non-trivial type");
+        const uint8_t *ptr = reinterpret_cast<const uint8_t *>(&val);
+        data.insert(data.end(), ptr, ptr + sizeof(T));
+    }
+
+    template <typename T>
+    bool read(T &val)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoint: non-trivial type");
+        if (bFailed || rpos + sizeof(T) > data.size())
+            return !(bFailed = true);
+        std::memcpy(&val, data.data() + rpos, sizeof(T));
+        rpos += sizeof(T);
+        return true;
+    }
+
+    void writeString(cstr_t &str);
+    bool readString(str_t &str);
+    void writeBlob(const std::vector<uint8_t> &blob);
+    bool readBlob(std::vector<uint8_t> &blob);
+
+    bool save(const fs::path &fname) const;
+    bool load(const fs::path &fname);
+
+private:
+    std::vector<uint8_t> data;
+    size_t rpos = 0;
+    uint32_t version = CHECKPOINT_VERSION;     // format of data being read
+    bool bFailed = false;
+};
@@ -0,0 +1,99 @@
+// dlgprof.cpp - Dialog Frame Profiler package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#include "main/core.h"
+#include "api/ofsapi.h"
+#include "api/graphics.h"
+#include "main/app.h"
+#include "main/guimgr.h"
+#include "main/profiler.h"
+#include "main/dlgprof.h"
+
+DialogProfiler::DialogProfiler(cstr_t &name)
+: GUIElement(name, typeid(DialogProfiler))
+{
+    bEnabled = false;
+}
+
+void DialogProfiler::show()
+{
+    if (ofsProfiler == nullptr)
+        return;
+
+    ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(560, 380), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    ImGui::Begin("Frame Profiler", &bEnabled);
+
+    // Frame time history
+    float times[PRF_WINDOW];
+    int count = ofsProfiler->getFrameHistory(times, PRF_WINDOW);
+    ProfileStats frame;
+    ofsProfiler->getStats(prfFrame, false, frame);
+    str_t overlay = std::format("{:.2f} ms ({:.0f} fps)",
+        frame.avg, frame.avg > 0.0 ? 1000.0 / frame.avg : 0.0);
+    ImGui::PlotLines("##frames", times, count, 0, overlay.c_str(),
+        0.0f, float(frame.max * 1.1), ImVec2(-1, 60));
+
+    showSections();
+
+    // Chrome trace capture (chrome://tracing, Perfetto)
+    ImGui::Separator();
+    if (ofsProfiler->isCapturing())
+        ImGui::Text("Capturing trace...");
+    else if (ImGui::Button("Capture trace"))
+        ofsProfiler->startCapture(nCaptureFrames, "ofs-frames.json");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(160);
+    ImGui::SliderInt("frames", &nCaptureFrames, 30, 1000);
+
+    ImGui::End();
+}
+
+void DialogProfiler::showSections()
+{
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    if (!ImGui::BeginTable("sections", 7, flags))
+        return;
+
+    ImGui::TableSetupColumn("Section");
+    ImGui::TableSetupColumn("CPU avg");
+    ImGui::TableSetupColumn("CPU p50");
+    ImGui::TableSetupColumn("CPU p95");
+    ImGui::TableSetupColumn("CPU p99");
+    ImGui::TableSetupColumn("GPU p50");
+    ImGui::TableSetupColumn("GPU p95");
+    ImGui::TableHeadersRow();
+
+    // Section times are inclusive - nested sections
+    // (system in universe, stars in scene) count twice.
+    for (int idx = 0; idx < prfMaxSections; idx++)
+    {
+        ProfileSection sec = ProfileSection(idx);
+        ProfileStats cpu, gpu;
+        ofsProfiler->getStats(sec, false, cpu);
+        bool hasGPU = ofsProfiler->getStats(sec, true, gpu);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", Profiler::getSectionName(sec));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", cpu.avg);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", cpu.p50);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", cpu.p95);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", cpu.p99);
+        ImGui::TableNextColumn();
+        if (hasGPU)
+            ImGui::Text("%.3f", gpu.p50);
+        ImGui::TableNextColumn();
+        if (hasGPU)
+            ImGui::Text("%.3f", gpu.p95);
+    }
+
+    ImGui::EndTable();
+}
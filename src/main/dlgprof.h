@@ -0,0 +1,19 @@
+// dlgprof.h - Dialog Frame Profiler package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+class DialogProfiler : public GUIElement
+{
+public:
+    DialogProfiler(cstr_t &name);
+
+    void show() override;
+
+private:
+    void showSections();
+
+    int nCaptureFrames = 300;   // Frames per trace capture
+};
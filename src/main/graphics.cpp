@@ -8,7 +8,6 @@
 #include "main/core.h"
 #include "api/module.h"
 #include "api/graphics.h"
-#include "main/guimgr.h"
 #include "main/app.h"
 
 GraphicsClient::GraphicsClient(ModuleHandle handle)
@@ -29,9 +28,4 @@ LIBEXPORT bool ofsRegisterGraphicsClient(GraphicsClient *gc)
 LIBEXPORT bool ofsUnregisterGraphicsClient(GraphicsClient *gc)
 {
     return ofsAppCore->detachGraphicsClient(gc);
-}
-
-LIBEXPORT void ofsInitGLFW(GLFWwindow *window)
-{
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
 }
\ No newline at end of file
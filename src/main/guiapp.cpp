@@ -0,0 +1,120 @@
+// guiapp.cpp - Windowed application main routines
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#define OFSAPI_SERVER_BUILD
+
+#include "main/core.h"
+#include "api/graphics.h"
+#include "engine/player.h"
+#include "engine/celestial.h"
+#include "engine/dlgcam.h"
+#include "main/dlgprof.h"
+#include "main/guimgr.h"
+#include "main/guiapp.h"
+#include "main/profiler.h"
+
+void GUIApp::init()
+{
+    CoreApp::init();
+
+    if (glfwInit() != GLFW_TRUE)
+    {
+        ofsLogger->fatal("OFS: Unable to initialize GLFW interface.\n");
+        abort();
+    }
+    ofsLogger->info("OFS: Loaded GLFW version: {}\n",
+        glfwGetVersionString());
+
+    // Loading plugin modules
+#ifdef OFS_LIBRARY_DIR
+    str_t libpath = OFS_LIBRARY_DIR;
+    loadModule(libpath + "/plugin", "glclient");
+#else
+    loadModule("modules/plugin", "glclient");
+#endif
+
+    // Initialize graphics client module
+    if (gclient != nullptr)
+        createSceneWindow();
+}
+
+void GUIApp::cleanup()
+{
+    if (guimgr != nullptr)
+        delete guimgr;
+    guimgr = nullptr;
+
+    CoreApp::cleanup();
+}
+
+void GUIApp::createSceneWindow()
+{
+    if (gclient == nullptr)
+        exit(EXIT_FAILURE);
+    guimgr = new GUIManager(gclient);
+
+    // Initialize callbacks for window events
+    guimgr->setupCallbacks();
+
+    dlgCamera = new DialogCamera("Camera");
+    dlgProfiler = new DialogProfiler("Profiler");
+
+    guimgr->registerControl(dlgCamera);
+    guimgr->registerControl(dlgProfiler);
+}
+
+void GUIApp::run()
+{
+    if (guimgr == nullptr)
+        return;
+    guimgr->setPlayer(player);
+
+    while (!guimgr->shouldClose())
+    {
+        {
+            FrameScope scope(prfFrame);
+
+            // Process polling events
+            guimgr->pollEvents();
+
+            if (bSession)
+            {
+                if (beginTimeStep(bRunning))
+                {
+                    updateWorld();
+                    endTimeStep(bRunning);
+                }
+
+                processUserInputs();
+            }
+
+            renderScene();
+            drawHUD();
+            guimgr->render();
+            displayFrame();
+        }
+        if (ofsProfiler != nullptr)
+            ofsProfiler->endFrame();
+    }
+
+    closeSession();
+}
+
+void GUIApp::keyBufferedSystem(uint8_t key)
+{
+    // if (stateKey[ofs::keyF5] || stateKey[ofs::key5])
+    //     guimgr->showControl<DialogCamera>();
+
+    if (keymap.isLogicalKey(key, keyState, ofs::lkeyToggleProfiler))
+        guimgr->toggleControl<DialogProfiler>();
+
+    CoreApp::keyBufferedSystem(key);
+}
+
+// Graphics client modules hook their window into ImGui
+LIBEXPORT void ofsInitGLFW(GLFWwindow *window)
+{
+    ImGui_ImplGlfw_InitForOpenGL(window, true);
+}
@@ -0,0 +1,35 @@
+// guiapp.h - Windowed application package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#include "main/app.h"
+
+class GUIManager;
+class DialogCamera;
+class DialogProfiler;
+
+// Interactive application - GLFW window, graphics client
+// module and ImGui dialogs on top of headless core.
+class GUIApp : public CoreApp
+{
+public:
+    GUIApp() = default;
+    virtual ~GUIApp() = default;
+
+    void init() override;
+    void cleanup() override;
+    void run() override;
+
+    void keyBufferedSystem(uint8_t key) override;
+
+protected:
+    void createSceneWindow();
+
+private:
+    GUIManager *guimgr = nullptr;
+    DialogCamera *dlgCamera = nullptr;
+    DialogProfiler *dlgProfiler = nullptr;
+};
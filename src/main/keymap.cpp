@@ -212,6 +212,8 @@ struct {
     { ofs::lkeyLRCSLinMoveForward,      ofs::pkeyPad1|KEYM_CTRL,             "RCS-Forward-Lean"},
     { ofs::lkeyLRCSLinMoveBackward,     ofs::pkeyPad3|KEYM_CTRL,             "RCS-Backwrd-LeaN"},
 
+    { ofs::lkeyToggleProfiler,          ofs::pkeyP|KEYM_CTRL,               "Toggle-Profiler"},
+
 };
 
 Keymap::Keymap()
@@ -4,9 +4,7 @@
 // Date:    Sep 4, 2022
 
 #include "main/core.h"
-#include "main/app.h"
-
-class CoreApp;
+#include "main/guiapp.h"
 
 int main(int argc, char **argv)
 {
@@ -16,7 +14,7 @@ int main(int argc, char **argv)
 #endif // OFS_HOME_DIR
     std::cout << "Working directory: " << fs::current_path() << std::endl;
 
-    ofsAppCore = new CoreApp();
+    ofsAppCore = new GUIApp();
 
     ofsAppCore->init();
 
@@ -0,0 +1,234 @@
+// profiler.cpp - Profiler package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#include "main/core.h"
+#include "main/profiler.h"
+
+Profiler *ofsProfiler = nullptr;
+
+Profiler::Profiler()
+: epoch(std::chrono::steady_clock::now())
+{
+}
+
+double Profiler::now() const
+{
+    std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - epoch;
+    return elapsed.count();
+}
+
+uint32_t Profiler::getThreadIndex()
+{
+    std::thread::id id = std::this_thread::get_id();
+
+    for (uint32_t idx = 0; idx < threads.size(); idx++)
+        if (threads[idx] == id)
+            return idx;
+    threads.push_back(id);
+    return threads.size() - 1;
+}
+
+// Events are kept only while capturing - tasks and
+// scopes run all session long.
+void Profiler::record(cstr_t &name, cchar_t *category, double start, double end)
+{
+    if (!isCapturing())
+        return;
+
+    std::unique_lock<std::mutex> lock(muEvents);
+
+    events.push_back({ name, category, getThreadIndex(), start, end - start });
+}
+
+// Log per-phase timing breakdown
+void Profiler::report(cchar_t *category) const
+{
+    std::unique_lock<std::mutex> lock(muEvents);
+    double first = 0.0, last = 0.0;
+    bool found = false;
+
+    ofsLogger->info("Timing breakdown ({}):\n", category);
+    for (auto &event : events)
+    {
+        if (strcmp(event.category, category) != 0)
+            continue;
+        ofsLogger->info("  {:<40} {:10.3f} ms (thread {})\n",
+            event.name, event.duration / 1000.0, event.tid);
+
+        if (!found || event.start < first)
+            first = event.start;
+        if (!found || event.start + event.duration > last)
+            last = event.start + event.duration;
+        found = true;
+    }
+    ofsLogger->info("  {:<40} {:10.3f} ms\n", "Total", (last - first) / 1000.0);
+}
+
+bool Profiler::writeChromeTrace(const fs::path &fname) const
+{
+    std::ofstream ofile(fname, std::ios::out);
+    if (!ofile.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), strerror(errno));
+        return false;
+    }
+
+    json trace = json::array();
+
+    {
+        std::unique_lock<std::mutex> lock(muEvents);
+        for (auto &event : events)
+            trace.push_back({
+                { "name", event.name },
+                { "cat", event.category },
+                { "ph", "X" },
+                { "ts", event.start },
+                { "dur", event.duration },
+                { "pid", 1 },
+                { "tid", event.tid }
+            });
+    }
+
+    ofile << json({ { "traceEvents", trace } }).dump() << std::endl;
+    ofile.close();
+
+    ofsLogger->info("Wrote profiler trace to {}\n", fname.string());
+    return true;
+}
+
+// ******** Scoped timer ********
+
+ProfileScope::ProfileScope(cstr_t &name, cchar_t *category)
+: name(name), category(category)
+{
+    if (ofsProfiler != nullptr && ofsProfiler->isCapturing())
+        start = ofsProfiler->now();
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (ofsProfiler != nullptr && start >= 0.0)
+        ofsProfiler->record(name, category, start, ofsProfiler->now());
+}
+
+// ******** Per-frame section timers ********
+
+static cchar_t *sectionNames[] =
+{
+    "Frame",
+    "Universe",
+    "System",
+    "Scene",
+    "Stars",
+    "Surface",
+    "Vehicles",
+    "Panel",
+    "Loader"
+};
+
+cchar_t *Profiler::getSectionName(ProfileSection sec)
+{
+    return (sec < prfMaxSections) ? sectionNames[sec] : "Unknown";
+}
+
+// Called from any thread (loader thread included)
+void Profiler::addTime(ProfileSection sec, double start, double end)
+{
+    frames[sec].cpuAccum += int64_t((end - start) * 1000.0);
+    if (nCapture > 0)
+        record(sectionNames[sec], "frame", start, end);
+}
+
+// GPU times arrive a few frames late from timer query ring
+void Profiler::addGPUTime(ProfileSection sec, double ms)
+{
+    frames[sec].gpuAccum += ms;
+    frames[sec].gpuValid = true;
+}
+
+// Push accumulated section times into rolling window
+void Profiler::endFrame()
+{
+    int idx = nFrames % PRF_WINDOW;
+
+    for (auto &frame : frames)
+    {
+        frame.cpu[idx] = frame.cpuAccum.exchange(0) / 1.0e6;
+        if (frame.gpuValid)
+        {
+            frame.gpu[frame.nGPU % PRF_WINDOW] = frame.gpuAccum;
+            frame.nGPU++;
+        }
+        frame.gpuAccum = 0.0;
+        frame.gpuValid = false;
+    }
+    nFrames++;
+
+    if (nCapture > 0 && --nCapture == 0)
+        writeChromeTrace(captureFile);
+}
+
+bool Profiler::getStats(ProfileSection sec, bool gpu, ProfileStats &stats) const
+{
+    const FrameStat &frame = frames[sec];
+    int count = std::min(gpu ? frame.nGPU : nFrames, PRF_WINDOW);
+
+    stats = {};
+    if (count == 0)
+        return false;
+
+    float samples[PRF_WINDOW];
+    std::copy_n(gpu ? frame.gpu : frame.cpu, count, samples);
+
+    double sum = 0.0;
+    for (int idx = 0; idx < count; idx++)
+        sum += samples[idx];
+
+    // Select n-th smallest sample without full sort
+    auto percentile = [&](double pct) {
+        int n = std::min(count-1, int(pct * count));
+        std::nth_element(samples, samples + n, samples + count);
+        return double(samples[n]);
+    };
+
+    stats.count = count;
+    stats.avg = sum / count;
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = *std::max_element(samples, samples + count);
+    return true;
+}
+
+// Copy frame times (oldest first) for plotting
+int Profiler::getFrameHistory(float *times, int size) const
+{
+    int count = std::min({ nFrames, PRF_WINDOW, size });
+    const float *ring = frames[prfFrame].cpu;
+
+    for (int idx = 0; idx < count; idx++)
+        times[idx] = ring[(nFrames - count + idx) % PRF_WINDOW];
+    return count;
+}
+
+void Profiler::startCapture(int count, const fs::path &fname)
+{
+    {
+        std::unique_lock<std::mutex> lock(muEvents);
+        events.clear();
+    }
+    captureFile = fname;
+    nCapture = count;
+}
+
+// Startup reports are done - stop recording events
+void Profiler::endStartup()
+{
+    bStartup = false;
+
+    std::unique_lock<std::mutex> lock(muEvents);
+    events.clear();
+}
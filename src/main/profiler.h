@@ -0,0 +1,140 @@
+// profiler.h - Profiler package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#include <chrono>
+
+// Per-frame profiling sections
+enum ProfileSection
+{
+    prfFrame = 0,       // Whole frame (main loop)
+    prfUniverse,        // Universe update
+    prfSystem,          // Planetary system update
+    prfScene,           // Scene rendering
+    prfStars,           // Star field rendering
+    prfSurface,         // Planet surface rendering
+    prfVehicles,        // Vehicle mesh rendering
+    prfPanel,           // 2D panels and HUD
+    prfLoader,          // Surface tile loading (loader thread)
+    prfMaxSections
+};
+
+#define PRF_WINDOW      256     // Rolling statistics window [frames]
+
+struct ProfileStats
+{
+    int    count;       // Number of samples in window
+    double avg;         // [ms]
+    double p50;         // [ms]
+    double p95;         // [ms]
+    double p99;         // [ms]
+    double max;         // [ms]
+};
+
+class Profiler
+{
+public:
+    struct Event
+    {
+        str_t    name;
+        cchar_t *category;
+        uint32_t tid;           // Thread index
+        double   start;         // Start time [us]
+        double   duration;      // Duration [us]
+    };
+
+    Profiler();
+    ~Profiler() = default;
+
+    // Time since profiler was created [us]
+    double now() const;
+
+    void record(cstr_t &name, cchar_t *category, double start, double end);
+
+    void report(cchar_t *category) const;
+    bool writeChromeTrace(const fs::path &fname) const;
+
+    // Per-frame section timers
+    static cchar_t *getSectionName(ProfileSection sec);
+
+    void addTime(ProfileSection sec, double start, double end);
+    void addGPUTime(ProfileSection sec, double ms);
+    void endFrame();
+
+    bool getStats(ProfileSection sec, bool gpu, ProfileStats &stats) const;
+    int getFrameHistory(float *times, int size) const;
+
+    // Chrome trace capture of next frames. Startup phases
+    // are recorded until endStartup is called.
+    void startCapture(int count, const fs::path &fname);
+    void endStartup();
+    inline bool isCapturing() const     { return bStartup || nCapture > 0; }
+
+private:
+    uint32_t getThreadIndex();
+
+    struct FrameStat
+    {
+        std::atomic<int64_t> cpuAccum = 0;      // CPU time in current frame [ns]
+        double gpuAccum = 0.0;                  // GPU time resolved in current frame [ms]
+        bool   gpuValid = false;
+
+        float cpu[PRF_WINDOW] = {};             // CPU time ring [ms]
+        float gpu[PRF_WINDOW] = {};             // GPU time ring [ms]
+        int   nGPU = 0;                         // GPU samples recorded
+    };
+
+    FrameStat frames[prfMaxSections];
+    int nFrames = 0;                            // Frames recorded
+
+    std::atomic<int> nCapture = 0;              // Frames left to capture
+    std::atomic<bool> bStartup = true;          // Recording startup phases
+    fs::path captureFile;
+
+    std::chrono::steady_clock::time_point epoch;
+
+    mutable std::mutex muEvents;
+    std::vector<Event> events;
+    std::vector<std::thread::id> threads;
+};
+
+// Scoped timer - record time spent in current scope
+class ProfileScope
+{
+public:
+    ProfileScope(cstr_t &name, cchar_t *category = "startup");
+    ~ProfileScope();
+
+private:
+    str_t   name;
+    cchar_t *category;
+    double  start = -1.0;   // not recording if negative
+};
+
+extern Profiler *ofsProfiler;
+
+// Scoped frame timer - add time spent in current scope
+// to per-frame section statistics
+class FrameScope
+{
+public:
+    FrameScope(ProfileSection sec)
+    : sec(sec)
+    {
+        if (ofsProfiler != nullptr)
+            start = ofsProfiler->now();
+    }
+
+    ~FrameScope()
+    {
+        if (ofsProfiler != nullptr)
+            ofsProfiler->addTime(sec, start, ofsProfiler->now());
+    }
+
+private:
+    ProfileSection sec;
+    double start = 0.0;
+};
@@ -5,6 +5,7 @@
 
 #include "main/core.h"
 #include "main/timedate.h"
+#include "main/checkpoint.h"
 
 void TimeDate::reset(double now, double mjd)
 {
@@ -32,10 +33,11 @@ void TimeDate::beginStep(double dt, bool running)
     sysdt = dt;
     syst1 = syst0 + sysdt;
 
-    // Update simulation time if running enabled
+    // Update simulation time if running enabled.
+    // Fixed-step mode ignores wall clock for reproducible runs.
     if (running)
     {
-        simdt1 = sysdt * timeWarp;
+        simdt1 = (fixedStep > 0.0 ? fixedStep : sysdt) * timeWarp;
         simt1 = simt0 + simdt1;
         mjd1 = mjdref + astro::days(simt1);
         // jd1 = jdref + astro::Day(simt1);
@@ -83,3 +85,35 @@ void TimeDate::setTimeWarp(double twarp)
     timeWarp = twarp;
 }
 
+
+void TimeDate::saveState(Checkpoint &cp) const
+{
+    cp.write(simt0);
+    cp.write(simt1);
+    cp.write(simdt0);
+    cp.write(simdt1);
+    cp.write(mjdref);
+    cp.write(mjd0);
+    cp.write(mjd1);
+    cp.write(jd0);
+    cp.write(jd1);
+    cp.write(timeWarp);
+    cp.write(fixedStep);
+}
+
+bool TimeDate::restoreState(Checkpoint &cp)
+{
+    cp.read(simt0);
+    cp.read(simt1);
+    cp.read(simdt0);
+    cp.read(simdt1);
+    cp.read(mjdref);
+    cp.read(mjd0);
+    cp.read(mjd1);
+    cp.read(jd0);
+    cp.read(jd1);
+    cp.read(timeWarp);
+    cp.read(fixedStep);
+
+    return cp.isValid();
+}
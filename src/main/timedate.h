@@ -7,6 +7,8 @@
 
 #include "universe/astro.h"
 
+class Checkpoint;
+
 class TimeDate
 {
 public:
@@ -30,6 +32,11 @@ public:
     inline double getFPS() const            { return fps; }
     inline double getTimeWarp() const       { return timeWarp; }
 
+    // Fixed-step clock mode (0 = wall clock steps)
+    inline void setFixedStep(double dt)     { fixedStep = std::max(0.0, dt); }
+    inline double getFixedStep() const      { return fixedStep; }
+    inline bool isFixedStep() const         { return fixedStep > 0.0; }
+
     void reset(double now, double mjd);
 
     void beginStep(double dt, bool bRunning);
@@ -38,12 +45,16 @@ public:
 
     double jumpTo(double mjd);
 
+    void saveState(Checkpoint &cp) const;
+    bool restoreState(Checkpoint &cp);
+
 private:
 
     double syst0, syst1;    // system time since system started [s]
     double sysdt;           // system delta time [s]
 
     double timeWarp = 1.0;
+    double fixedStep = 0.0; // fixed simulation step [s]
 
     double simt0, simt1;    // Simulation time since simulation time started [s]
     double simdt0, simdt1;  // Simulation delta time [s]
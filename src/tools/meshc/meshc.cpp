@@ -0,0 +1,65 @@
+// meshc.cpp - Mesh compiler package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#include "main/core.h"
+#include "engine/mesh.h"
+
+// Converts text meshes (.msh) into compiled binary meshes (.mshb)
+// with precomputed normals and tangents.
+
+static void usage(cchar_t *name)
+{
+    std::cout << "Usage: " << name << " [-o <output.mshb>] <mesh.msh> ...\n"
+              << "  -o <file>   Output file (single input only, default <mesh>.mshb)\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<fs::path> inputs;
+    fs::path output;
+
+    for (int idx = 1; idx < argc; idx++)
+    {
+        str_t arg = argv[idx];
+
+        if (arg == "-o" && idx + 1 < argc)
+            output = argv[++idx];
+        else if (arg[0] == '-')
+        {
+            usage(argv[0]);
+            exit(1);
+        }
+        else
+            inputs.push_back(arg);
+    }
+
+    if (inputs.empty() || (!output.empty() && inputs.size() > 1))
+    {
+        usage(argv[0]);
+        exit(1);
+    }
+
+    ofsLogger = new Logger(Logger::logInfo, std::cout, std::cerr);
+
+    int nErrors = 0;
+    for (auto &src : inputs)
+    {
+        fs::path dst = output;
+        if (dst.empty())
+            dst = fs::path(src).replace_extension(".mshb");
+
+        // Input must be a source mesh
+        if (src.extension() == ".mshb" || !MeshManager::compileMesh(src, dst))
+        {
+            std::cerr << "Error: Can't compile mesh " << src.string() << "\n";
+            nErrors++;
+            continue;
+        }
+        std::cout << src.string() << " -> " << dst.string() << "\n";
+    }
+
+    delete ofsLogger;
+    return nErrors > 0 ? 1 : 0;
+}
@@ -19,4 +19,268 @@ Atmosphere *Atmosphere::create(str_t &name)
     if (name == "atm2006-venus")
         return new AtmosphereVenus2006();
     return nullptr;
-}
\ No newline at end of file
+}
+
+// Default batch evaluation - one point at a time
+void Atmosphere::getAtmBatch(const atmbatch_t &batch)
+{
+    for (int idx = 0; idx < batch.n; idx++)
+    {
+        iatmprm_t in = { batch.alt[idx], batch.lat[idx], batch.lng[idx], 0 };
+        atmprm_t out = {};
+
+        getAtmParams(in, out);
+        batch.p[idx]   = out.p;
+        batch.rho[idx] = out.rho;
+        batch.T[idx]   = out.T;
+    }
+}
+
+// Hydrostatic pressure through piecewise linear temperature
+// layers (as used by standard atmosphere tables).
+void Atmosphere::getLayeredParams(const atmlayer_t *layers, int nLayers,
+    double p0, double R, double g, double alt, atmprm_t &out)
+{
+    double p = p0, T = layers[0].T;
+
+    alt = std::max(alt, 0.0);
+    for (int idx = 0; idx < nLayers; idx++)
+    {
+        const atmlayer_t &layer = layers[idx];
+        bool last = (idx+1 == nLayers) || (alt <= layers[idx+1].alt);
+        double dz = ((last ? alt : layers[idx+1].alt) - layer.alt) * 1000.0;
+        double lapse = layer.lapse * 1e-3;
+
+        T = layer.T + lapse * dz;
+        if (lapse != 0.0)
+            p *= pow(T / layer.T, -g / (R * lapse));
+        else
+            p *= exp(-g * dz / (R * layer.T));
+        if (last)
+            break;
+    }
+
+    out.p = p;
+    out.T = T;
+    out.rho = p / (R * T);
+}
+
+// ******** Atmosphere Lookup Table ********
+
+// Floor for log-space tables (vacuum above model limits)
+static constexpr double atmMinValue = 1e-30;
+
+// Table file format - bump when layout changes
+#define ATM_TABLE_MAGIC     "OFSATM02"
+
+AtmosphereTable::AtmosphereTable(Atmosphere *model, double altLimit)
+: model(model), altLimit(altLimit)
+{
+}
+
+void AtmosphereTable::sample(double alt, double lat, double lng, node_t &node) const
+{
+    iatmprm_t in = { alt, lat, lng, 0 };
+    atmprm_t out = {};
+
+    model->getAtmParams(in, out);
+    node.lrho = log(std::max(out.rho, atmMinValue));
+    node.lp   = log(std::max(out.p, atmMinValue));
+    node.T    = out.T;
+}
+
+void AtmosphereTable::build()
+{
+    nodes.resize(nAlt * nLat * nLng);
+
+    double dLat = pi / (nLat - 1);
+    double dLng = pi2 / nLng;
+
+    for (int ilng = 0; ilng < nLng; ilng++)
+        for (int ilat = 0; ilat < nLat; ilat++)
+            for (int ialt = 0; ialt < nAlt; ialt++)
+            {
+                double u = double(ialt) / (nAlt - 1);
+                sample(altLimit * u * u, ilat * dLat - pi05, ilng * dLng,
+                    nodes[index(ialt, ilat, ilng)]);
+            }
+
+    ofsLogger->info("OFS: Built {} atmosphere table ({}x{}x{} nodes)\n",
+        model->getsAtmName(), nAlt, nLat, nLng);
+    checkErrors();
+}
+
+void AtmosphereTable::interpolate(const iatmprm_t &in, node_t &node) const
+{
+    double u = sqrt(in.alt / altLimit) * (nAlt - 1);
+    double v = std::clamp(in.lat + pi05, 0.0, pi) * ((nLat - 1) / pi);
+    double w = ofs::posangle(in.lng) * (nLng / pi2);
+
+    int ia = std::min(int(u), nAlt - 2);
+    int it = std::min(int(v), nLat - 2);
+    int ig0 = int(w) % nLng, ig1 = (ig0 + 1) % nLng;
+    float fa = u - ia, ft = v - it, fg = w - int(w);
+
+    const node_t *c00 = &nodes[index(ia, it,   ig0)];
+    const node_t *c10 = &nodes[index(ia, it+1, ig0)];
+    const node_t *c01 = &nodes[index(ia, it,   ig1)];
+    const node_t *c11 = &nodes[index(ia, it+1, ig1)];
+
+    // Blend altitude pairs first (nodes ialt, ialt+1 are adjacent)
+    auto lerp = [](const node_t *c, float f, float node_t::*m)
+        { return c[0].*m + f * (c[1].*m - c[0].*m); };
+    auto blend = [&](float node_t::*m)
+    {
+        float a00 = lerp(c00, fa, m), a10 = lerp(c10, fa, m);
+        float a01 = lerp(c01, fa, m), a11 = lerp(c11, fa, m);
+        float a0 = a00 + ft * (a10 - a00);
+        float a1 = a01 + ft * (a11 - a01);
+        return a0 + fg * (a1 - a0);
+    };
+
+    node.lrho = blend(&node_t::lrho);
+    node.lp   = blend(&node_t::lp);
+    node.T    = blend(&node_t::T);
+}
+
+void AtmosphereTable::getAtmParams(const iatmprm_t &in, atmprm_t &out) const
+{
+    // Outside tabulated range - ask model directly
+    if (nodes.empty() || in.alt < 0.0 || in.alt > altLimit)
+    {
+        model->getAtmParams(in, out);
+        return;
+    }
+
+    node_t node;
+    interpolate(in, node);
+    out.rho = exp(node.lrho);
+    out.p   = exp(node.lp);
+    out.T   = node.T;
+}
+
+void AtmosphereTable::getAtmBatch(const atmbatch_t &batch) const
+{
+    if (nodes.empty())
+    {
+        model->getAtmBatch(batch);
+        return;
+    }
+
+    for (int idx = 0; idx < batch.n; idx++)
+    {
+        iatmprm_t in = { batch.alt[idx], batch.lat[idx], batch.lng[idx], 0 };
+
+        if (in.alt < 0.0 || in.alt > altLimit)
+        {
+            atmprm_t out = {};
+            model->getAtmParams(in, out);
+            batch.p[idx]   = out.p;
+            batch.rho[idx] = out.rho;
+            batch.T[idx]   = out.T;
+            continue;
+        }
+
+        node_t node;
+        interpolate(in, node);
+        batch.p[idx]   = exp(node.lp);
+        batch.rho[idx] = exp(node.lrho);
+        batch.T[idx]   = node.T;
+    }
+}
+
+// Compare table against model at cell centers
+// and report worst interpolation errors.
+void AtmosphereTable::checkErrors() const
+{
+    double dLat = pi / (nLat - 1);
+    double dLng = pi2 / nLng;
+    double erho = 0.0, ep = 0.0, eT = 0.0;
+
+    for (int ilng = 0; ilng < nLng; ilng += 5)
+        for (int ilat = 0; ilat < nLat - 1; ilat += 3)
+            for (int ialt = 0; ialt < nAlt - 1; ialt++)
+            {
+                double u = (ialt + 0.5) / (nAlt - 1);
+                iatmprm_t in = { altLimit * u * u, (ilat + 0.5) * dLat - pi05, (ilng + 0.5) * dLng, 0 };
+                atmprm_t ref = {}, out;
+
+                model->getAtmParams(in, ref);
+                if (ref.rho < atmMinValue || ref.p < atmMinValue)
+                    continue;
+                getAtmParams(in, out);
+                erho = std::max(erho, fabs(out.rho / ref.rho - 1.0));
+                ep   = std::max(ep, fabs(out.p / ref.p - 1.0));
+                eT   = std::max(eT, fabs(out.T - ref.T));
+            }
+
+    ofsLogger->info("OFS: Atmosphere table error: rho {:.3f}%, p {:.3f}%, T {:.2f} K\n",
+        erho * 100.0, ep * 100.0, eT);
+}
+
+bool AtmosphereTable::save(const fs::path &fname) const
+{
+    std::ofstream ofile(fname, std::ios::binary|std::ios::out);
+    if (!ofile.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), strerror(errno));
+        return false;
+    }
+
+    str_t name = model->getsAtmName();
+    uint32_t len = name.size();
+    uint32_t version = model->getAtmVersion();
+    int32_t dims[3] = { nAlt, nLat, nLng };
+
+    ofile.write(ATM_TABLE_MAGIC, 8);
+    ofile.write((char *)&version, sizeof(version));
+    ofile.write((char *)&len, sizeof(len));
+    ofile.write(name.data(), len);
+    ofile.write((char *)dims, sizeof(dims));
+    ofile.write((char *)&altLimit, sizeof(altLimit));
+    ofile.write((char *)nodes.data(), nodes.size() * sizeof(node_t));
+    ofile.close();
+
+    return !ofile.fail();
+}
+
+bool AtmosphereTable::load(const fs::path &fname)
+{
+    std::ifstream ifile(fname, std::ios::binary|std::ios::in);
+    if (!ifile.is_open())
+        return false;
+
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t len = 0;
+    int32_t dims[3];
+    double limit;
+
+    // Reject cache built from other model, model version or grid
+    ifile.read(magic, sizeof(magic));
+    ifile.read((char *)&version, sizeof(version));
+    ifile.read((char *)&len, sizeof(len));
+    str_t name(std::min<uint32_t>(len, 256), '\0');
+    ifile.read(name.data(), name.size());
+    ifile.read((char *)dims, sizeof(dims));
+    ifile.read((char *)&limit, sizeof(limit));
+    if (ifile.fail() || memcmp(magic, ATM_TABLE_MAGIC, 8) != 0 ||
+        version != model->getAtmVersion() ||
+        name != model->getsAtmName() || limit != altLimit ||
+        dims[0] != nAlt || dims[1] != nLat || dims[2] != nLng)
+    {
+        ofsLogger->info("File '{}': Stale atmosphere table - rebuilding\n", fname.string());
+        return false;
+    }
+
+    nodes.resize(nAlt * nLat * nLng);
+    ifile.read((char *)nodes.data(), nodes.size() * sizeof(node_t));
+    if (ifile.fail())
+    {
+        ofsLogger->error("File '{}': Truncated atmosphere table\n", fname.string());
+        nodes.clear();
+        return false;
+    }
+
+    return true;
+}
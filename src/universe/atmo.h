@@ -40,6 +40,32 @@ struct atmprm_t
     double T;           // Temperature [K]
 };
 
+// Atmospheric parameters for batch queries (structure of arrays)
+struct atmbatch_t
+{
+    int n;              // Number of points
+    const double *alt;  // Altitude [km]
+    const double *lat;  // Latitude [radians]
+    const double *lng;  // Longitude [radians]
+    double *p;          // Pressure [Pa]
+    double *rho;        // Density [kg/m^3]
+    double *T;          // Temperature [K]
+
+    inline atmbatch_t slice(int first, int count) const
+    {
+        return { count, alt+first, lat+first, lng+first,
+            p+first, rho+first, T+first };
+    }
+};
+
+// Temperature layer for hydrostatic profiles
+struct atmlayer_t
+{
+    double alt;         // Base altitude [km]
+    double T;           // Base temperature [K]
+    double lapse;       // Temperature gradient dT/dz [K/km]
+};
+
 class Atmosphere
 {
 public:
@@ -48,10 +74,19 @@ public:
     static Atmosphere *create(str_t &name);
 
     virtual str_t getsAtmName() const = 0;
+    // Bump when model output changes, so that cached
+    // lookup tables built from old model are rebuilt.
+    virtual uint32_t getAtmVersion() const { return 1; }
     virtual void getAtmConstants(atmconst_t &atmc) const = 0;
+    // Queries may come from worker threads, so models
+    // must be reentrant or serialize internally.
     virtual void getAtmParams(const iatmprm_t &in, atmprm_t &out) = 0;
+    virtual void getAtmBatch(const atmbatch_t &batch);
 
 protected:
+    static void getLayeredParams(const atmlayer_t *layers, int nLayers,
+        double p0, double R, double g, double alt, atmprm_t &out);
+
     double altLimit;        // Altitutde limit [km]
     double radLimit;        // Radius limit [km]
     double horizonLimit;    // rendering altitude
@@ -68,4 +103,57 @@ protected:
     color_t atmColor;       // Atmospheric color
     glm::dvec3 atmWave;        // Wavelength
 
-};
\ No newline at end of file
+};
+
+// Precomputed atmosphere lookup table
+//
+// Samples an atmosphere model once over (altitude, latitude,
+// longitude) and answers queries by trilinear interpolation of
+// ln(rho), ln(p) and T. Model epoch and solar/geomagnetic indices
+// are fixed, so longitude stands for local solar time. Altitude
+// nodes are spaced by sqrt(alt/altLimit) to resolve the lower
+// atmosphere finely. ln(rho) and ln(p) are exact between nodes for
+// isothermal layers; error grows with curvature of the profile,
+// about (h^2/8) * |d^2 ln(rho)/dz^2|. With default grid, error
+// against NRLMSISE-00 stays below 4% in density and pressure and
+// 6 K in temperature, dominated by horizontal spacing; layered
+// Mars/Venus profiles stay below 0.5%. Measured bounds are logged
+// when table is built. Queries outside table go to the model.
+class AtmosphereTable
+{
+public:
+    AtmosphereTable(Atmosphere *model, double altLimit);
+
+    inline bool isValid() const     { return !nodes.empty(); }
+
+    void build();
+    bool load(const fs::path &fname);
+    bool save(const fs::path &fname) const;
+
+    void getAtmParams(const iatmprm_t &in, atmprm_t &out) const;
+    void getAtmBatch(const atmbatch_t &batch) const;
+
+private:
+    struct node_t
+    {
+        float lrho;     // ln(density)
+        float lp;       // ln(pressure)
+        float T;        // Temperature [K]
+    };
+
+    inline int index(int ialt, int ilat, int ilng) const
+        { return (ilng * nLat + ilat) * nAlt + ialt; }
+
+    void sample(double alt, double lat, double lng, node_t &node) const;
+    void interpolate(const iatmprm_t &in, node_t &node) const;
+    void checkErrors() const;
+
+    Atmosphere *model = nullptr;
+    double altLimit;
+
+    int nAlt = 256;     // altitude nodes (sqrt spacing)
+    int nLat = 19;      // latitude nodes, 10 degrees apart
+    int nLng = 24;      // longitude nodes, 15 degrees (1 hour LST) apart
+
+    std::vector<node_t> nodes;
+};
@@ -8,6 +8,7 @@
 #include "engine/vehicle/vehicle.h"
 #include "universe/body.h"
 #include "utils/json.h"
+#include "utils/threadpool.h"
 
 CelestialPlanet::CelestialPlanet(cstr_t &name, celType type)
 : CelestialBody(name, objCelestialBody, type)
@@ -29,6 +30,7 @@ CelestialPlanet::CelestialPlanet(json &config, celType type)
     }
 
     atmc.color0 = myjson::getFloatArray<color_t, float>(config, "atm-color", { 0, 0, 0 });
+    useAtmTable = myjson::getBoolean<bool>(config, "atm-table", true);
 
     if (config["ground-observers"].is_array()) {
 
@@ -92,6 +94,8 @@ CelestialPlanet::~CelestialPlanet()
 {
     if (emgr != nullptr)
         delete emgr;
+    if (atmTable != nullptr)
+        delete atmTable;
 
     for (auto &base : baseList)
         delete base;
@@ -106,11 +110,29 @@ void CelestialPlanet::setup()
     for (auto &base : baseList)
         base->setup();
 
+    setupAtmosphere();
+
     // Initialize orbiter database accesses.
     fs::path folder = getPath() + "/orbiter";
     emgr->setup(folder);
 }
 
+// Sample atmosphere model into lookup table, reusing
+// cached table in body folder if it is still valid.
+void CelestialPlanet::setupAtmosphere()
+{
+    if (atm == nullptr || !useAtmTable || atmTable != nullptr)
+        return;
+
+    fs::path fname = getPath() + "/atmo.tab";
+    atmTable = new AtmosphereTable(atm, atmc.altLimit);
+    if (!atmTable->load(fname))
+    {
+        atmTable->build();
+        atmTable->save(fname);
+    }
+}
+
 void CelestialPlanet::getAtmParam(const glm::dvec3 &loc, atmprm_t *prm) const
 {
     // Clear all atomspheric parameters
@@ -124,10 +146,43 @@ void CelestialPlanet::getAtmParam(const glm::dvec3 &loc, atmprm_t *prm) const
         in.lng = loc.y;
         in.alt = loc.z;
     
-        atm->getAtmParams(in, *prm);
+        if (atmTable != nullptr)
+            atmTable->getAtmParams(in, *prm);
+        else
+            atm->getAtmParams(in, *prm);
     }
 }
 
+void CelestialPlanet::getAtmParams(const atmbatch_t &batch, ThreadPool *pool) const
+{
+    if (atm == nullptr)
+    {
+        std::fill_n(batch.p, batch.n, 0.0);
+        std::fill_n(batch.rho, batch.n, 0.0);
+        std::fill_n(batch.T, batch.n, 0.0);
+        return;
+    }
+
+    auto eval = [this](const atmbatch_t &sub)
+    {
+        if (atmTable != nullptr)
+            atmTable->getAtmBatch(sub);
+        else
+            atm->getAtmBatch(sub);
+    };
+
+    // Direct model queries may be serialized inside model
+    // (NRLMSISE-00), so only table lookups are split up.
+    if (pool == nullptr || atmTable == nullptr || batch.n < ATM_BATCH_CHUNK*2)
+    {
+        eval(batch);
+        return;
+    }
+
+    pool->parallelFor(batch.n, ATM_BATCH_CHUNK,
+        [&](int first, int count) { eval(batch.slice(first, count)); });
+}
+
 double CelestialPlanet::getElevation(glm::dvec3 ploc)
 {
     return (emgr != nullptr) ? emgr->getElevationData(ploc) : 0;
@@ -10,8 +10,11 @@
 #include "universe/atmo.h"
 
 class Base;
+class ThreadPool;
 struct windprm_t;
 
+#define ATM_BATCH_CHUNK 2048    // Points per worker task in batch queries
+
 struct GroundPOI
 {
     GroundPOI(cstr_t &name, glm::dvec3 loc, double dir)
@@ -46,6 +49,9 @@ public:
         int frame = 0, windprm_t *prm = nullptr, double *wspd = nullptr);
 
     void getAtmParam(const glm::dvec3 &loc, atmprm_t *prm) const;
+    void getAtmParams(const atmbatch_t &batch, ThreadPool *pool = nullptr) const;
+
+    inline const atmconst_t &getAtmConstants() const { return atmc; }
 
     inline double getSoundSpeed(double temp) const
         { return (atm != nullptr) ? sqrt(atmc.gamma * atmc.R * temp) : 0.0; }
@@ -61,10 +67,14 @@ public:
     inline int getBaseSize() const              { return baseList.size(); }
 
 private:
+    void setupAtmosphere();
+
     ElevationManager *emgr = nullptr;
 
     Atmosphere *atm = nullptr;
+    AtmosphereTable *atmTable = nullptr;
     atmconst_t atmc;
+    bool useAtmTable = true;
     bool enableWindVelocity = false;
 
     std::vector<Base *> baseList;
@@ -15,6 +15,7 @@
 ElevationManager::ElevationManager(CelestialPlanet *obj)
 : object(obj)
 {
+    localTiles.resize(2);
 }
 
 void ElevationManager::setup(const fs::path &folder)
@@ -187,148 +188,163 @@ bool ElevationManager::getTileIndex(double lat, double lng, int lod, int &ilat,
     return true;
 }
 
-double ElevationManager::getElevationData(glm::dvec3 loc, int reqlod,
-    elevTileList_t *elevTiles, glm::dvec3 *normal, int *lod) const
+// Find cached tile covering location at requested LOD or
+// load it into least recently used slot.
+ElevationTile *ElevationManager::findTile(const glm::dvec3 &loc, int reqlod, elevTileList_t &tiles) const
 {
-    double e = 0.0;
+    for (auto &tile : tiles)
+    {
+        if (tile.data != nullptr && reqlod == tile.tgtlod &&
+            loc.x >= tile.latmin && loc.x <= tile.latmax &&
+            loc.y >= tile.lngmin && loc.y <= tile.lngmax)
+        {
+            tile.lastAccess = ofsDate->getSysTime1();
+            return &tile;
+        }
+    }
 
-    if (zTrees[0] == nullptr)
-        return 0.0;
+    // Find oldest elevation tile
+    ElevationTile *t = &tiles[0];
+    for (int idx = 1; idx < tiles.size(); idx++)
+        if (tiles[idx].lastAccess < t->lastAccess)
+            t = &tiles[idx];
 
-    if (elevMode > 0)
+    // Release old elevation data
+    if (t->data != nullptr)
     {
-        elevTileList_t &tiles = (elevTiles != nullptr) ? *elevTiles : localTiles;
-        ElevationTile *t = nullptr;
-        int lod, ilat, ilng;
+        delete [] t->data;
+        t->data = nullptr;
+    }
 
-        for (auto tile : tiles)
-        {
-            if (tile.data != nullptr && reqlod == tile.tgtlod &&
-                loc.x >= tile.latmin && loc.x <= tile.latmax &&
-                loc.y >= tile.lngmin && loc.y <= tile.lngmax)
-            {
-                t = &tile;
-                break;
-            }
-        }
+    int ilat, ilng;
+    for (int lod = reqlod; lod >= 0; lod--)
+    {
+        getTileIndex(loc.x, loc.y, lod, ilat, ilng);
+        t->data = readElevationFile(lod+4, ilat, ilng, elevScale);
 
-        if (t == nullptr)
+        if (t->data != nullptr)
         {
-            // Find oldest elevation tile
-            t = &tiles[0];
-            for (int idx = 1; idx < elevTiles->size(); idx++)
-                if (tiles[idx].lastAccess < t->lastAccess)
-                    t = &tiles[idx];
-
-            // Release old elevation data
-            if (t->data != nullptr)
-            {
-                delete [] t->data;
-                t->data = nullptr;
-            }
+            readElevationModFile(lod+4, ilat, ilng, elevScale, t->data);
+
+            int nlat = 1 << lod;
+            int nlng = 2 << lod;
+
+            t->lod  = lod;
+            t->ilat = ilat, t->nlat = nlat;
+            t->ilng = ilng, t->nlng = nlng;
+            t->tgtlod = reqlod;
+            t->latmin = (0.5 - (double(ilat+1)/double(nlat)))*pi;
+            t->latmax = (0.5 - (double(ilat)/double(nlat)))*pi;
+            t->lngmin = double(ilng)/double(nlng)*pi2 - pi;
+            t->lngmax = double(ilng+1)/double(nlng)*pi2 - pi;
+
+            // ofsLogger->debug("LOD Level:    {}\n", lod);
+            // ofsLogger->debug("Index:        {}/{}, {}/{}\n", ilat, nlat, ilng, nlng);
+            // ofsLogger->debug("Lat  Min/Max: {:f} - {:f}\n", glm::degrees(t->latmin), glm::degrees(t->latmax));
+            // ofsLogger->debug("Long Min/Max: {:f} - {:f}\n", glm::degrees(t->lngmin), glm::degrees(t->lngmax));
+            // ofsLogger->debug("Location:     {:f}, {:f}\n", glm::degrees(loc.x), glm::degrees(loc.y));
+
+            break;
+        }
+    }
 
-            for (lod = reqlod; lod >= 0; lod--)
-            {
-                getTileIndex(loc.x, loc.y, lod, ilat, ilng);
-                t->data = readElevationFile(lod+4, ilat, ilng, elevScale);
+    t->lat0 = t->lng0 = 0;
+    t->lastAccess = ofsDate->getSysTime1();
+    return t->data != nullptr ? t : nullptr;
+}
 
-                if (t->data != nullptr)
-                {
-                    readElevationModFile(lod+4, ilat, ilng, elevScale, t->data);
-
-                    int nlat = 1 << lod;
-                    int nlng = 2 << lod;
-
-                    t->lod  = lod;
-                    t->ilat = ilat, t->nlat = nlat;
-                    t->ilng = ilng, t->nlng = nlng;
-                    t->tgtlod = reqlod;
-                    t->latmin = (0.5 - (double(ilat+1)/double(nlat)))*pi;
-                    t->latmax = (0.5 - (double(ilat)/double(nlat)))*pi;
-                    t->lngmin = double(ilng)/double(nlng)*pi2 - pi;
-                    t->lngmax = double(ilng+1)/double(nlng)*pi2 - pi;
-
-                    // ofsLogger->debug("LOD Level:    {}\n", lod);
-                    // ofsLogger->debug("Index:        {}/{}, {}/{}\n", ilat, nlat, ilng, nlng);
-                    // ofsLogger->debug("Lat  Min/Max: {:f} - {:f}\n", glm::degrees(t->latmin), glm::degrees(t->latmax));
-                    // ofsLogger->debug("Long Min/Max: {:f} - {:f}\n", glm::degrees(t->lngmin), glm::degrees(t->lngmax));
-                    // ofsLogger->debug("Location:     {:f}, {:f}\n", glm::degrees(loc.x), glm::degrees(loc.y));
-
-                    // uint32_t cksum = 0;
-                    // for (int idx = 0; idx < ELEV_LENGTH; idx++)
-                    //     cksum += t->data[idx];
-                    // ofsLogger->debug("Data: {:p} Checksum: {:x}\n", fmt::ptr(t->data), cksum);
-
-                    break;
-                }
-            }
+// Bilinear elevation [m] within tile
+double ElevationManager::sampleTile(ElevationTile *t, const glm::dvec3 &loc, glm::dvec3 *normal) const
+{
+    double e = 0.0;
 
-            t->lat0 = t->lng0 = 0;
-        }
+    int16_t *elevBase = t->data + ELEV_STRIDE + 1;
+    double latidx = (loc.x - t->latmin) * elevGrid / (t->latmax - t->latmin);
+    double lngidx = (loc.y - t->lngmin) * elevGrid / (t->lngmax - t->lngmin);
+    int lat0 = (int)latidx;
+    int lng0 = (int)lngidx;
 
-        if (t->data != nullptr)
-        {
-            int16_t *elevBase = t->data + ELEV_STRIDE + 1;
-            double latidx = (loc.x - t->latmin) * elevGrid / (t->latmax - t->latmin);
-            double lngidx = (loc.y - t->lngmin) * elevGrid / (t->lngmax - t->lngmin);
-            int lat0 = (int)latidx;
-            int lng0 = (int)lngidx;
+    // ofsLogger->debug("Tile Index: {}, {}\n", lat0, lng0);
+    // dump(t->data);
 
-            // ofsLogger->debug("Tile Index: {}, {}\n", lat0, lng0);
-            // dump(t->data);
+    int16_t *eptr = elevBase + lat0 * ELEV_STRIDE + lng0;
+    if (elevMode == 1)
+    {
+        double wlat = latidx - lat0;
+        double wlng = lngidx - lng0;
 
-            int16_t *eptr = elevBase + lat0 * ELEV_STRIDE + lng0;
-            if (elevMode == 1)
-            {
-                double wlat = latidx - lat0;
-                double wlng = lngidx - lng0;
-
-                // Determine elevation
-                double e1 = eptr[0]*(1.0-wlng) + eptr[1]*wlng;
-                double e2 = eptr[ELEV_STRIDE]*(1.0-wlng) + eptr[ELEV_STRIDE+1]*wlng;
-                e = e1*(1.0-wlat) + e2*wlat;
-
-                // ofsLogger->debug("Tile LOD: {} Index ({},{})\n", t->lod, t->ilat, t->ilng);
-                // ofsLogger->debug("Loc: {:f} {:f} ==> Elev {:f}\n", wlat, wlng, e);
-                // ofsLogger->debug("Data: {} {}\n", eptr[0], eptr[1]);
-                // ofsLogger->debug("Data: {} {}\n", eptr[ELEV_STRIDE], eptr[ELEV_STRIDE+1]);
-                
-                // uint32_t cksum = 0;
-                // for (int idx = 0; idx < ELEV_LENGTH; idx++)
-                //     cksum += t->data[idx];
-                // ofsLogger->debug("Data: {:p} Checksum: {:x}\n", fmt::ptr(t->data), cksum);
-
-                // Determine normals
-                if (normal != nullptr)
-                {
-                    double dlat = (t->latmax - t->latmin) / elevGrids;
-                    double dlng = (t->lngmax - t->lngmin) / elevGrids;
-                    double dz = dlat * object->getRadius();
-                    double dx = dlng * object->getRadius() * cos(loc.x);
-
-                    double nx1 = eptr[1]-eptr[0];
-                    double nx2 = eptr[ELEV_STRIDE+1] - eptr[ELEV_STRIDE];
-                    double nx = wlat*nx2 + (1.0-wlat)*nx1;
-                    glm::dvec3 vnx(dx, nx, 0);
-
-                    double nz1 = eptr[ELEV_STRIDE] - eptr[0];
-                    double nz2 = eptr[ELEV_STRIDE+1] - eptr[1];
-                    double nz = wlng*nz2 + (1.0-wlng)*nz1;
-                    glm::dvec3 vnz(0, nz, dz);
-
-                    *normal = glm::normalize(glm::cross(vnx, vnz));
-                }
-            }
-            else if (elevMode == 2)
-            {
+        // Determine elevation
+        double e1 = eptr[0]*(1.0-wlng) + eptr[1]*wlng;
+        double e2 = eptr[ELEV_STRIDE]*(1.0-wlng) + eptr[ELEV_STRIDE+1]*wlng;
+        e = e1*(1.0-wlat) + e2*wlat;
 
-            }
+        // ofsLogger->debug("Tile LOD: {} Index ({},{})\n", t->lod, t->ilat, t->ilng);
+        // ofsLogger->debug("Loc: {:f} {:f} ==> Elev {:f}\n", wlat, wlng, e);
 
-            // t->lastAccess = td.syst1;
-            t->lat0 = lat0;
-            t->lng0 = lng0;
+        // Determine normals
+        if (normal != nullptr)
+        {
+            double dlat = (t->latmax - t->latmin) / elevGrids;
+            double dlng = (t->lngmax - t->lngmin) / elevGrids;
+            double dz = dlat * object->getRadius();
+            double dx = dlng * object->getRadius() * cos(loc.x);
+
+            double nx1 = eptr[1]-eptr[0];
+            double nx2 = eptr[ELEV_STRIDE+1] - eptr[ELEV_STRIDE];
+            double nx = wlat*nx2 + (1.0-wlat)*nx1;
+            glm::dvec3 vnx(dx, nx, 0);
+
+            double nz1 = eptr[ELEV_STRIDE] - eptr[0];
+            double nz2 = eptr[ELEV_STRIDE+1] - eptr[1];
+            double nz = wlng*nz2 + (1.0-wlng)*nz1;
+            glm::dvec3 vnz(0, nz, dz);
+
+            *normal = glm::normalize(glm::cross(vnx, vnz));
         }
     }
+    else if (elevMode == 2)
+    {
+
+    }
+
+    t->lat0 = lat0;
+    t->lng0 = lng0;
 
     return e * elevScale;
 }
+
+double ElevationManager::getElevationData(glm::dvec3 loc, int reqlod,
+    elevTileList_t *elevTiles, glm::dvec3 *normal, int *lod) const
+{
+    if (zTrees[0] == nullptr || elevMode == 0)
+        return 0.0;
+
+    elevTileList_t &tiles = (elevTiles != nullptr) ? *elevTiles : localTiles;
+    ElevationTile *t = findTile(loc, reqlod, tiles);
+    return (t != nullptr) ? sampleTile(t, loc, normal) : 0.0;
+}
+
+// Elevations [m] for list of (lat, lng) locations. Points close
+// together (touchdown points of one vehicle) mostly fall into same
+// tile, so tile lookup is done only when leaving current tile.
+void ElevationManager::getElevationData(const glm::dvec3 *locs, double *elevs, int count,
+    int reqlod, elevTileList_t *elevTiles) const
+{
+    if (zTrees[0] == nullptr || elevMode == 0)
+    {
+        std::fill(elevs, elevs + count, 0.0);
+        return;
+    }
+
+    elevTileList_t &tiles = (elevTiles != nullptr) ? *elevTiles : localTiles;
+    ElevationTile *t = nullptr;
+
+    for (int idx = 0; idx < count; idx++)
+    {
+        const glm::dvec3 &loc = locs[idx];
+        if (t == nullptr || loc.x < t->latmin || loc.x > t->latmax ||
+            loc.y < t->lngmin || loc.y > t->lngmax)
+            t = findTile(loc, reqlod, tiles);
+        elevs[idx] = (t != nullptr) ? sampleTile(t, loc, nullptr) : 0.0;
+    }
+}
@@ -27,11 +27,16 @@ public:
     bool getTileIndex(double lat, double lng, int lod, int &ilat, int &ilng) const;
     double getElevationData(glm::dvec3 loc, int reqlod = 0, elevTileList_t *elevTiles = nullptr,
         glm::dvec3 *normal = nullptr, int *lod = 0) const;
+    void getElevationData(const glm::dvec3 *locs, double *elevs, int count,
+        int reqlod = 0, elevTileList_t *elevTiles = nullptr) const;
     // int16_t *getElevationData();
 
     inline int getMode() const      { return elevMode; }
 
 private:
+    ElevationTile *findTile(const glm::dvec3 &loc, int reqlod, elevTileList_t &tiles) const;
+    double sampleTile(ElevationTile *t, const glm::dvec3 &loc, glm::dvec3 *normal) const;
+
     CelestialPlanet *object = nullptr;
     int elevMode = 1;
 
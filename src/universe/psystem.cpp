@@ -14,6 +14,8 @@
 #include "universe/psystem.h"
 
 #include "utils/json.h"
+#include "main/checkpoint.h"
+#include "main/profiler.h"
 
 pSystem::pSystem(cstr_t &name)
 : sysName(name)
@@ -47,14 +49,17 @@ void pSystem::addBody(Celestial *cbody)
 
 void pSystem::addSuperVehicle(SuperVehicle *svehicle)
 {
+    svehicle->setSystem(this);
     svehicles.push_back(svehicle);
     addBody(svehicle);
 }
 
 void pSystem::addVehicle(Vehicle *vehicle)
 {
+    vehicle->setSystem(this);
     vehicles.push_back(vehicle);
     addBody(vehicle);
+    proximity.add(vehicle);
 }
 
 void pSystem::addCelestial(Celestial *cel)
@@ -86,6 +91,17 @@ bool pSystem::removeVehicle(Vehicle *vehicle)
     return false;
 }
 
+// Remove dissolved assembly - caller owns and deletes it
+bool pSystem::removeSuperVehicle(SuperVehicle *svehicle)
+{
+    auto it = std::find(svehicles.begin(), svehicles.end(), svehicle);
+    if (it == svehicles.end())
+        return false;
+    svehicles.erase(it);
+    bodies.erase(std::find(bodies.begin(), bodies.end(), svehicle));
+    return true;
+}
+
 Vehicle *pSystem::getVehicle(cstr_t &name, bool incase) const
 {
     for (auto vehicle : vehicles)
@@ -159,8 +175,39 @@ void pSystem::reset()
         body->setupRotation();
 }
 
+// Remote systems may skip time steps only when all vehicles
+// follow from simulation time alone (coasting or parked).
+// Vehicles integrated with step size (thrust, atmospheric
+// flight, ground driving, docked) need every time step.
+bool pSystem::hasActiveVehicles() const
+{
+    for (auto veh : vehicles)
+        if (!veh->isIdle())
+            return true;
+    return false;
+}
+
+// Earliest predicted event of coasting vehicles, so that
+// skipped systems are updated no later than that.
+double pSystem::getNextEvent() const
+{
+    double tNext = std::numeric_limits<double>::infinity();
+    for (auto veh : vehicles)
+        if (veh->isCoasting())
+            tNext = std::min(tNext, veh->getCoastUntil());
+    return tNext;
+}
+
 void pSystem::update(bool force)
 {
+    FrameScope scope(prfSystem);
+
+    // Skipped systems span more than one frame
+    double t1 = ofsDate->getSimTime1();
+    stepTime = (lastUpdate > 0.0 && lastUpdate < t1)
+        ? t1 - lastUpdate : ofsDate->getSimDeltaTime1();
+    lastUpdate = t1;
+
     // Enable update states
     for (auto body : bodies)
         body->beginUpdate();
@@ -183,6 +230,9 @@ void pSystem::update(bool force)
         sveh->update(force);
     for (auto veh : vehicles)
         veh->update(force);
+
+    // Refresh broad phase from new state vectors
+    proximity.update();
 }
 
 void pSystem::finalizeUpdate()
@@ -206,6 +256,92 @@ void pSystem::finalizePostCreation()
         veh->finalizePostCreationModule();
 }
 
+// Docked assemblies come and go at run time, so they are
+// saved apart from fixed body list and rebuilt on restore.
+void pSystem::saveState(Checkpoint &cp) const
+{
+    cp.writeString(sysName);
+    cp.write(lastUpdate);
+    cp.write<uint32_t>(bodies.size() - svehicles.size());
+    for (auto body : bodies)
+    {
+        if (std::find(svehicles.begin(), svehicles.end(), body) != svehicles.end())
+            continue;
+        cp.writeString(body->getsName());
+        body->saveState(cp);
+    }
+
+    cp.write<uint32_t>(svehicles.size());
+    for (auto sveh : svehicles)
+    {
+        cp.writeString(sveh->getsName());
+        sveh->saveState(cp);
+    }
+}
+
+bool pSystem::restoreState(Checkpoint &cp)
+{
+    str_t name;
+    uint32_t count = 0;
+
+    // Dissolve current assemblies first
+    while (!svehicles.empty())
+    {
+        SuperVehicle *sveh = svehicles.back();
+        sveh->detachAll();
+        removeSuperVehicle(sveh);
+        delete sveh;
+    }
+
+    cp.readString(name);
+    // Version 3 checkpoints have no update time - update
+    // on next frame instead.
+    lastUpdate = 0.0;
+    if (cp.getVersion() >= 4)
+        cp.read(lastUpdate);
+    cp.read(count);
+    if (!cp.isValid() || name != sysName || count != bodies.size())
+    {
+        ofsLogger->error("{} system: Checkpoint does not match ({} system, {} bodies)\n",
+            sysName, name, count);
+        return false;
+    }
+
+    for (auto body : bodies)
+    {
+        if (!cp.readString(name) || name != body->getsName())
+        {
+            ofsLogger->error("{} system: Checkpoint expected {}, found {}\n",
+                sysName, body->getsName(), name);
+            return false;
+        }
+        if (!body->restoreState(cp))
+        {
+            ofsLogger->error("{} system: {} - Invalid checkpoint state\n",
+                sysName, body->getsName());
+            return false;
+        }
+    }
+
+    if (!cp.read(count))
+        return false;
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (!cp.readString(name))
+            return false;
+        SuperVehicle *sveh = new SuperVehicle(name);
+        addSuperVehicle(sveh);
+        if (!sveh->restoreState(cp))
+        {
+            ofsLogger->error("{} system: {} - Invalid docked assembly state\n",
+                sysName, name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
 struct {
     const char *name;
     celType type;
@@ -249,6 +385,19 @@ bool pSystem::loadStar(cstr_t &cbName, Universe *univ, pSystem *psys, fs::path &
 }
 
 bool pSystem::loadPlanet(cstr_t &cbName, pSystem *psys, fs::path &cbPath)
+{
+    str_t parentName;
+
+    CelestialPlanet *cbody = createPlanet(cbName, cbPath, parentName);
+    if (cbody == nullptr)
+        return false;
+    return attachPlanet(cbody, psys, parentName);
+}
+
+// Load celestial body configuration and set up its ephemeris
+// and elevation database. It does not touch planetary system
+// so that it can run concurrently with other bodies.
+CelestialPlanet *pSystem::createPlanet(cstr_t &cbName, fs::path &cbPath, str_t &parentName)
 {
     ofsLogger->info("Loading {}...\n", cbName);
     fs::path path = cbPath / "cbody.json";
@@ -258,26 +407,20 @@ bool pSystem::loadPlanet(cstr_t &cbName, pSystem *psys, fs::path &cbPath)
 
     if (!myjson::getBoolean<bool>(config, "activate", true)) {
         ofsLogger->info("OFS info: Disabled celestial body: {}\n", cbName);
-        return false;
+        return nullptr;
     }
 
-    CelestialBody *parent = nullptr;
-    str_t sysName = myjson::getString<str_t>(config, "system");
-    if (sysName.empty()) {
+    parentName = myjson::getString<str_t>(config, "system");
+    if (parentName.empty()) {
         ofsLogger->error("OFS: Required planetary system name - aborted\n");
-        return false;
-    }
-    parent = dynamic_cast<CelestialBody *>(psys->find(sysName));
-    if (parent == nullptr) {
-        ofsLogger->error("OFS: Unknown planetary system: {} - aborted\n", sysName);
-        return false;
+        return nullptr;
     }
 
     celType type = cbUnknown;
     str_t typeName = myjson::getString<str_t>(config, "type");
     if (typeName.empty()) {
         ofsLogger->error("OFS: Required celestial body type - aborted\n");
-        return false;
+        return nullptr;
     }
     for (auto ctype : celTypes)
         if (ctype.name == typeName)
@@ -286,7 +429,7 @@ bool pSystem::loadPlanet(cstr_t &cbName, pSystem *psys, fs::path &cbPath)
     {
         ofsLogger->info("OFS: Unknown celestial body type: {} - aborted\n",
             typeName);
-        return false;
+        return nullptr;
     }
 
     CelestialPlanet *cbody = new CelestialPlanet(config, type);
@@ -295,13 +438,34 @@ bool pSystem::loadPlanet(cstr_t &cbName, pSystem *psys, fs::path &cbPath)
     // cbody->setFolder(cbFolder);
     cbody->setup();
 
+    return cbody;
+}
+
+bool pSystem::attachPlanet(CelestialPlanet *cbody, pSystem *psys, cstr_t &parentName)
+{
+    CelestialBody *parent = dynamic_cast<CelestialBody *>(psys->find(parentName));
+    if (parent == nullptr) {
+        ofsLogger->error("OFS: Unknown planetary system: {} - aborted\n", parentName);
+        delete cbody;
+        return false;
+    }
+
     psys->addPlanet(cbody, parent);
 
     return true;
 }
 
-bool pSystem::loadSystem(Universe *univ, cstr_t &sysName, const fs::path &path)
+bool pSystem::loadSystem(Universe *univ, cstr_t &sysName, const fs::path &path,
+    TaskGraph &graph, TaskGraph::taskId catalogTask)
 {
+    struct bodyEntry
+    {
+        str_t    name, type;
+        fs::path path;
+        str_t    parentName;
+        CelestialPlanet *cbody = nullptr;
+    };
+
     ofsLogger->info("Loading {} system...\n", sysName);
 
     fs::path fname = path / "system.json";
@@ -315,6 +479,7 @@ bool pSystem::loadSystem(Universe *univ, cstr_t &sysName, const fs::path &path)
     pSystem *psys = univ->createSolarSystem(sysName);
     ofsLogger->info("Creating {} planetary system...\n", sysName);
 
+    auto entries = std::make_shared<std::vector<bodyEntry>>();
     if (sysConfig["celestial-bodies"].is_array())
     {
         for (auto &item : sysConfig["celestial-bodies"].items())
@@ -322,23 +487,48 @@ bool pSystem::loadSystem(Universe *univ, cstr_t &sysName, const fs::path &path)
             if (!item.value().is_object())
                 continue;
             auto &entry = item.value();
-            str_t cbName, cbType;
-            fs::path cbPath = OFS_HOME_DIR;
-            cbPath /= "systems";
+            bodyEntry body;
+            body.path = OFS_HOME_DIR;
+            body.path /= "systems";
 
             if (entry["name"].is_string())
-                cbName = entry["name"].get<str_t>();
+                body.name = entry["name"].get<str_t>();
             if (entry["type"].is_string())
-                cbType = entry["type"].get<str_t>();
+                body.type = entry["type"].get<str_t>();
             if (entry["folder"].is_string())
-                cbPath /= entry["folder"].get<fs::path>();
+                body.path /= entry["folder"].get<fs::path>();
 
-            if (cbType == "star")
-                loadStar(cbName, univ, psys, cbPath);
-            else
-                loadPlanet(cbName, psys, cbPath);
+            entries->push_back(body);
         }
     }
 
+    // Each planet/moon loads concurrently. Star lookup needs
+    // star catalog, and planets have to be attached in order
+    // because parent must be in system first.
+    std::vector<TaskGraph::taskId> deps;
+    if (catalogTask >= 0)
+        deps.push_back(catalogTask);
+    for (int idx = 0; idx < entries->size(); idx++)
+    {
+        if ((*entries)[idx].type == "star")
+            continue;
+        deps.push_back(graph.add("Load " + (*entries)[idx].name, [entries, idx]
+        {
+            bodyEntry &body = (*entries)[idx];
+            body.cbody = createPlanet(body.name, body.path, body.parentName);
+        }));
+    }
+
+    graph.add("Link " + sysName + " system", [univ, psys, entries]
+    {
+        for (auto &body : *entries)
+        {
+            if (body.type == "star")
+                loadStar(body.name, univ, psys, body.path);
+            else if (body.cbody != nullptr)
+                attachPlanet(body.cbody, psys, body.parentName);
+        }
+    }, deps);
+
     return true;
 }
@@ -5,13 +5,18 @@
 
 #pragma once
 
+#include "utils/threadpool.h"
+#include "engine/vehicle/proximity.h"
+
 class Universe;
 class Celestial;
 class CelestialStar;
 class CelestialBody;
+class CelestialPlanet;
 class SuperVehicle;
 class Vehicle;
 class TimeDate;
+class Checkpoint;
 
 class pSystem
 {
@@ -35,7 +40,18 @@ public:
     Celestial *find(cstr_t &name) const;
     Vehicle *findVehicle(cstr_t &name) const;
 
+    inline cstr_t &getName() const              { return sysName; }
+    inline const std::vector<Celestial *> &getBodies() const { return bodies; }
+    inline int getVehiclesSize() const          { return vehicles.size(); }
+    inline double getLastUpdate() const         { return lastUpdate; }
+    inline double getStepTime() const           { return stepTime; }
+    inline const ProximityIndex &getProximityIndex() const { return proximity; }
+
+    bool hasActiveVehicles() const;
+    double getNextEvent() const;
+
     bool removeVehicle(Vehicle *);
+    bool removeSuperVehicle(SuperVehicle *svehicle);
     inline Vehicle *getVehicle(int idx) const   { return idx < vehicles.size() ? vehicles[idx] : nullptr; };
     Vehicle *getVehicle(cstr_t &name, bool incase = true) const;
 
@@ -47,13 +63,19 @@ public:
 
     static bool loadStar(cstr_t &cbName, Universe *univ, pSystem *psys, fs::path &cbPath);
     static bool loadPlanet(cstr_t &cbName, pSystem *psys, fs::path &cbPath);
-    static bool loadSystem(Universe *univ, cstr_t &sysName, const fs::path &path);
+    static CelestialPlanet *createPlanet(cstr_t &cbName, fs::path &cbPath, str_t &parentName);
+    static bool attachPlanet(CelestialPlanet *cbody, pSystem *psys, cstr_t &parentName);
+    static bool loadSystem(Universe *univ, cstr_t &sysName, const fs::path &path,
+        TaskGraph &graph, TaskGraph::taskId catalogTask = -1);
 
     void reset();
     void update(bool force);
     void finalizeUpdate();
     void finalizePostCreation();
 
+    void saveState(Checkpoint &cp) const;
+    bool restoreState(Checkpoint &cp);
+
 private:
     cstr_t sysName;
     str_t  sysPath;
@@ -68,6 +90,11 @@ private:
     std::vector<Vehicle *> vehicles;
     std::vector<Celestial *> celestials;
 
+    ProximityIndex proximity;   // vehicle broad phase
+
+    double lastUpdate = 0.0;    // sim time of last update [s]
+    double stepTime = 0.0;      // time span of last update [s]
+
 };
 
 // typedef std::map<uint32_t, pSystem *> SystemsList;
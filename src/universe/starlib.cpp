@@ -14,6 +14,33 @@
 #include "universe/astro.h"
 #include "universe/xhipdata.h"
 
+// Per-user cache directory for generated data. Install data
+// directory is often read-only and must stay untouched.
+static fs::path getCacheDirectory()
+{
+    std::error_code ec;
+    fs::path path;
+#ifdef _WIN32
+    if (const char *dir = std::getenv("LOCALAPPDATA"))
+        path = fs::path(dir) / "OFS";
+#else
+    if (const char *dir = std::getenv("XDG_CACHE_HOME"))
+        path = fs::path(dir) / "ofs";
+    else if (const char *home = std::getenv("HOME"))
+        path = fs::path(home) / ".cache" / "ofs";
+#endif
+    if (path.empty())
+        path = fs::temp_directory_path(ec) / "ofs";
+
+    fs::create_directories(path, ec);
+    if (ec)
+    {
+        ofsLogger->warn("Can't create cache directory {}: {}\n", path.string(), ec.message());
+        return {};
+    }
+    return path;
+}
+
 bool StarDatabase::loadXHIPData(const fs::path &pname)
 {
     fs::path mfname = pname / "main.dat";
@@ -140,7 +167,8 @@ bool StarDatabase::loadXHIPData(const fs::path &pname)
     ofsLogger->info("Total {} stars with negative parallex.\n", cnplx);
     ofsLogger->info("Total {} stars with zero parallel.\n", czplx); 
 
-    finish();
+    fs::path cpath = getCacheDirectory();
+    finish(cpath.empty() ? fs::path() : cpath / "stars.oct");
     
     return true;
 }
@@ -150,24 +178,37 @@ void StarDatabase::addStar(CelestialStar *star)
     uStars.push_back(star);
 }
 
-void StarDatabase::initOctreeData(std::vector<CelestialStar *> stars)
+// Load octree from cache file if it matches catalog,
+// otherwise build it and write cache for next startup.
+void StarDatabase::initOctreeData(const std::vector<CelestialStar *> &stars, const fs::path &cname)
 {
     double absMag = astro::convertAppToAbsMag(STARTREE_MAGNITUDE,
         STARTREE_ROOTSIZE * sqrt(3.0));
+    glm::dvec3 center = { 1000.0, 1000.0, 1000.0 };
 
-    starTree = new StarTree({ 1000.0, 1000.0, 1000.0 }, absMag);
-    for (int idx = 0; idx < uStars.size(); idx++)
-        starTree->insert(*uStars[idx], STARTREE_ROOTSIZE);
+    auto start = std::chrono::steady_clock::now();
+
+    starTree = new StarOctree();
+    bool cached = !cname.empty() && starTree->load(cname, stars, center, absMag, STARTREE_ROOTSIZE);
+    if (!cached)
+    {
+        starTree->build(stars, center, absMag, STARTREE_ROOTSIZE);
+        if (!cname.empty())
+            starTree->save(cname);
+    }
 
-    ofsLogger->info("Star database has {} nodes and {} objects\n",
-        starTree->countNodes(), starTree->countObjects());
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    ofsLogger->info("Star database has {} nodes and {} objects ({:.1f} ms{})\n",
+        starTree->countNodes(), starTree->countObjects(), elapsed.count(),
+        cached ? ", cached" : "");
 }
 
-void StarDatabase::finish()
+void StarDatabase::finish(const fs::path &cname)
 {
     ofsLogger->info("Total star count: {}\n", uStars.size());
 
-    initOctreeData(uStars);
+    initOctreeData(uStars, cname);
 
     // Initialize HIP star catalogue
     int hip, maxHip = 0;
@@ -197,7 +238,7 @@ void StarDatabase::findVisibleStars(const ofsHandler &handle, const glm::dvec3 &
 {
     if (starTree == nullptr)
         return;
-    starTree->processVisibleStars(handle, obs / KM_PER_PC, limitMag, STARTREE_ROOTSIZE);
+    starTree->processVisibleStars(handle, obs / KM_PER_PC, limitMag);
 }
 
 int StarDatabase::findCloseStars(const glm::dvec3 &obs, double radius,
@@ -205,6 +246,6 @@ int StarDatabase::findCloseStars(const glm::dvec3 &obs, double radius,
 {
     if (starTree == nullptr)
         return 0;
-    starTree->processCloseStars(obs / KM_PER_PC, radius, STARTREE_ROOTSIZE, stars);
+    starTree->processCloseStars(obs / KM_PER_PC, radius, stars);
     return stars.size();
 }
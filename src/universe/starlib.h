@@ -6,6 +6,7 @@
 #pragma once
 
 class StarTree;
+class StarOctree;
 class CelestialStar;
 class ofsHandler;
 class Object;
@@ -17,8 +18,8 @@ public:
 
     bool loadXHIPData(const fs::path &pname);
 
-    void initOctreeData(std::vector<CelestialStar *> stars);
-    void finish();
+    void initOctreeData(const std::vector<CelestialStar *> &stars, const fs::path &cname = {});
+    void finish(const fs::path &cname = {});
 
     void addStar(CelestialStar *star);
 
@@ -37,5 +38,5 @@ private:
 
     CelestialStar **hipList = nullptr;
 
-    StarTree *starTree = nullptr;
+    StarOctree *starTree = nullptr;
 };
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #define OFSAPI_SERVER_BUILD
 
+#include <bit>
+
 #include "main/core.h"
 #include "engine/object.h"
 #include "universe/star.h"
@@ -169,4 +171,367 @@ void StarTree::processCloseStars(const glm::dvec3 &obs, const double radius, con
             continue;
         node->processCloseStars(obs, radius, scale * 0.5, stars);
     }
-}
\ No newline at end of file
+}
+// ******** Bulk-loaded star octree ********
+
+// Spread out lower 21 bits to every third bit.
+static inline uint64_t expandMortonBits(uint64_t v)
+{
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffull;
+    v = (v | v << 16) & 0x1f0000ff0000ffull;
+    v = (v | v << 8)  & 0x100f00f00f00f00full;
+    v = (v | v << 4)  & 0x10c30c30c30c30c3ull;
+    v = (v | v << 2)  & 0x1249249249249249ull;
+    return v;
+}
+
+// Compute Morton code of star position within root cell. Bits
+// are interleaved as x, y, z to match xPos, yPos and zPos.
+static inline uint64_t getMortonCode(const glm::dvec3 &pos, const glm::dvec3 &origin, double size)
+{
+    constexpr double maxCell = double(1u << STARTREE_MAXDEPTH);
+    uint64_t code = 0;
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        double q = (pos[axis] - origin[axis]) / size * maxCell;
+        q = std::clamp(q, 0.0, maxCell - 1.0);
+        code |= expandMortonBits(uint64_t(q)) << axis;
+    }
+
+    return code;
+}
+
+void StarOctree::build(const std::vector<CelestialStar *> &stars, const glm::dvec3 &center,
+    double factor, double size)
+{
+    const size_t nStars = stars.size();
+    const glm::dvec3 origin = center - glm::dvec3(size, size, size);
+
+    std::vector<mortonEntry> entries(nStars);
+    auto compare = [](const mortonEntry &a, const mortonEntry &b)
+        { return a.code < b.code || (a.code == b.code && a.index < b.index); };
+
+    // Compute Morton codes and sort them by chunks in parallel.
+    size_t nThreads = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunk = std::max<size_t>((nStars + nThreads - 1) / nThreads, 1024);
+    std::vector<std::thread> workers;
+
+    for (size_t lo = 0; lo < nStars; lo += chunk)
+    {
+        size_t hi = std::min(lo + chunk, nStars);
+        workers.emplace_back([&, lo, hi]
+        {
+            for (size_t idx = lo; idx < hi; idx++)
+            {
+                entries[idx].code = getMortonCode(stars[idx]->getStarPosition(), origin, size * 2.0);
+                entries[idx].index = idx;
+                entries[idx].absMag = stars[idx]->getAbsMag();
+            }
+            std::sort(entries.begin() + lo, entries.begin() + hi, compare);
+        });
+    }
+    for (auto &worker : workers)
+        worker.join();
+
+    // Merge sorted chunks pairwise in parallel.
+    for (size_t width = chunk; width < nStars; width *= 2)
+    {
+        workers.clear();
+        for (size_t lo = 0; lo + width < nStars; lo += width * 2)
+        {
+            size_t mid = lo + width;
+            size_t hi = std::min(lo + width * 2, nStars);
+            workers.emplace_back([&, lo, mid, hi]
+            {
+                std::inplace_merge(entries.begin() + lo, entries.begin() + mid,
+                    entries.begin() + hi, compare);
+            });
+        }
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    // Now build octree in one pass over sorted list.
+    rootSize = size;
+    catalog = stars;
+    nodes.clear();
+    starList.clear();
+    starList.reserve(nStars);
+
+    StarOctreeNode root = {};
+    root.center[0] = center.x;
+    root.center[1] = center.y;
+    root.center[2] = center.z;
+    root.exclusiveFactor = factor;
+    nodes.push_back(root);
+
+    buildNode(0, entries.data(), entries.data() + nStars, 0, size);
+}
+
+void StarOctree::buildNode(uint32_t nidx, mortonEntry *first, mortonEntry *last,
+    int depth, double scale)
+{
+    double factor = nodes[nidx].exclusiveFactor;
+    mortonEntry *faint = last;
+
+    // Bright stars stay at this cell. Stable partition keeps
+    // remaining stars in Morton order.
+    if (last - first > STARTREE_THRESHOLD && depth < STARTREE_MAXDEPTH)
+        faint = std::stable_partition(first, last,
+            [factor](const mortonEntry &e) { return e.absMag < factor; });
+
+    nodes[nidx].firstStar = starList.size();
+    nodes[nidx].nStars = faint - first;
+    for (mortonEntry *e = first; e < faint; e++)
+        starList.push_back(e->index);
+
+    if (faint == last)
+        return;
+
+    // Split remaining stars into child cells. Each child cell is
+    // one contiguous run of Morton codes at this level.
+    int shift = (STARTREE_MAXDEPTH - 1 - depth) * 3;
+    mortonEntry *bound[9];
+    bound[0] = faint;
+    for (int idx = 0; idx < 8; idx++)
+        bound[idx+1] = std::partition_point(bound[idx], last,
+            [shift, idx](const mortonEntry &e) { return int((e.code >> shift) & 7) <= idx; });
+
+    uint32_t firstChild = nodes.size();
+    uint32_t childMask = 0;
+    double cscale = scale * 0.5;
+    double dfactor = convertLumToAbsMag(convertAbsMagToLum(factor) / 4.0);
+
+    for (int idx = 0; idx < 8; idx++)
+    {
+        if (bound[idx] == bound[idx+1])
+            continue;
+        StarOctreeNode child = {};
+        child.center[0] = nodes[nidx].center[0] + (((idx & StarTree::xPos) != 0) ? cscale : -cscale);
+        child.center[1] = nodes[nidx].center[1] + (((idx & StarTree::yPos) != 0) ? cscale : -cscale);
+        child.center[2] = nodes[nidx].center[2] + (((idx & StarTree::zPos) != 0) ? cscale : -cscale);
+        child.exclusiveFactor = dfactor;
+        nodes.push_back(child);
+        childMask |= 1u << idx;
+    }
+    nodes[nidx].firstChild = firstChild;
+    nodes[nidx].childMask = childMask;
+
+    uint32_t cidx = firstChild;
+    for (int idx = 0; idx < 8; idx++)
+    {
+        if (bound[idx] == bound[idx+1])
+            continue;
+        buildNode(cidx++, bound[idx], bound[idx+1], depth + 1, cscale);
+    }
+}
+
+// FNV-1a hash over catalog contents that octree depends on,
+// so that cached octree is rebuilt when catalog changes.
+uint64_t StarOctree::getCatalogHash(const std::vector<CelestialStar *> &stars)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](const void *data, size_t size)
+    {
+        const uint8_t *bytes = (const uint8_t *)data;
+        for (size_t idx = 0; idx < size; idx++)
+            hash = (hash ^ bytes[idx]) * 0x100000001b3ull;
+    };
+
+    for (auto star : stars)
+    {
+        uint32_t hip = star->getHIPnumber();
+        glm::dvec3 pos = star->getStarPosition();
+        double absMag = star->getAbsMag();
+        mix(&hip, sizeof(hip));
+        mix(&pos, sizeof(pos));
+        mix(&absMag, sizeof(absMag));
+    }
+    return hash;
+}
+
+bool StarOctree::save(const fs::path &fname) const
+{
+    std::ofstream ofile(fname, std::ios::binary|std::ios::out);
+    if (!ofile.is_open())
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), strerror(errno));
+        return false;
+    }
+
+    StarOctreeHeader hdr;
+    hdr.magic = STARTREE_MAGIC;
+    hdr.version = STARTREE_VERSION;
+    hdr.size = sizeof(hdr);
+    hdr.nodeCount = nodes.size();
+    hdr.starCount = starList.size();
+    hdr.catalogSize = catalog.size();
+    hdr.catalogHash = getCatalogHash(catalog);
+    hdr.rootSize = rootSize;
+
+    ofile.write((char *)&hdr, sizeof(hdr));
+    ofile.write((char *)nodes.data(), nodes.size() * sizeof(StarOctreeNode));
+    ofile.write((char *)starList.data(), starList.size() * sizeof(uint32_t));
+    ofile.close();
+
+    return !ofile.fail();
+}
+
+bool StarOctree::load(const fs::path &fname, const std::vector<CelestialStar *> &stars,
+    const glm::dvec3 &center, double factor, double size)
+{
+    std::ifstream ifile(fname, std::ios::binary|std::ios::in);
+    if (!ifile.is_open())
+        return false;
+
+    // Stale cache (other catalog or build parameters)
+    // is not an error - caller builds octree instead.
+    StarOctreeHeader hdr;
+    ifile.read((char *)&hdr, sizeof(hdr));
+    if (ifile.fail() || hdr.magic != STARTREE_MAGIC || hdr.version != STARTREE_VERSION ||
+        hdr.size != sizeof(hdr) || hdr.nodeCount == 0)
+    {
+        ofsLogger->info("File '{}': Unknown star octree format - rebuilding\n", fname.string());
+        return false;
+    }
+    if (hdr.catalogSize != stars.size() || hdr.catalogHash != getCatalogHash(stars) ||
+        hdr.rootSize != size)
+    {
+        ofsLogger->info("File '{}': Star octree is out of date - rebuilding\n", fname.string());
+        return false;
+    }
+
+    // Check counts against file size before allocating
+    ifile.seekg(0, std::ios::end);
+    uint64_t remain = uint64_t(ifile.tellg()) - sizeof(hdr);
+    ifile.seekg(sizeof(hdr), std::ios::beg);
+    if (uint64_t(hdr.nodeCount) * sizeof(StarOctreeNode) +
+        uint64_t(hdr.starCount) * sizeof(uint32_t) != remain)
+    {
+        ofsLogger->error("File '{}': Invalid star octree size\n", fname.string());
+        return false;
+    }
+
+    nodes.resize(hdr.nodeCount);
+    starList.resize(hdr.starCount);
+    ifile.read((char *)nodes.data(), nodes.size() * sizeof(StarOctreeNode));
+    ifile.read((char *)starList.data(), starList.size() * sizeof(uint32_t));
+    if (ifile.fail())
+    {
+        ofsLogger->error("File '{}': Truncated star octree file\n", fname.string());
+        nodes.clear();
+        starList.clear();
+        return false;
+    }
+
+    const StarOctreeNode &root = nodes[0];
+    if (root.center[0] != center.x || root.center[1] != center.y ||
+        root.center[2] != center.z || root.exclusiveFactor != factor)
+    {
+        ofsLogger->info("File '{}': Star octree is out of date - rebuilding\n", fname.string());
+        nodes.clear();
+        starList.clear();
+        return false;
+    }
+
+    auto invalid = [&](cstr_t &reason)
+    {
+        ofsLogger->error("File '{}': {}\n", fname.string(), reason);
+        nodes.clear();
+        starList.clear();
+        return false;
+    };
+
+    // Children always follow their parent, so traversal
+    // can neither run out of range nor loop.
+    for (uint32_t nidx = 0; nidx < nodes.size(); nidx++)
+    {
+        const StarOctreeNode &node = nodes[nidx];
+        if (node.childMask > 0xff)
+            return invalid(std::format("Node {} has invalid child mask", nidx));
+        if (node.childMask != 0 && (node.firstChild <= nidx ||
+            uint64_t(node.firstChild) + std::popcount(node.childMask) > nodes.size()))
+            return invalid(std::format("Node {} children out of range", nidx));
+        if (uint64_t(node.firstStar) + node.nStars > starList.size())
+            return invalid(std::format("Node {} stars out of range", nidx));
+    }
+
+    for (auto sidx : starList)
+    {
+        if (sidx >= stars.size())
+            return invalid(std::format("Star index {} out of range", sidx));
+    }
+
+    rootSize = hdr.rootSize;
+    catalog = stars;
+
+    return true;
+}
+
+void StarOctree::processVisibleStars(const ofsHandler &handle, const glm::dvec3 &obs,
+    const double limitingFactor) const
+{
+    if (nodes.empty())
+        return;
+    processVisibleNode(0, handle, obs, limitingFactor, rootSize);
+}
+
+void StarOctree::processCloseStars(const glm::dvec3 &obs, const double radius,
+    std::vector<const CelestialStar *> &stars) const
+{
+    if (nodes.empty())
+        return;
+    processCloseNode(0, obs, radius, rootSize, stars);
+}
+
+void StarOctree::processVisibleNode(uint32_t nidx, const ofsHandler &handle, const glm::dvec3 &obs,
+    const double limitingFactor, const double scale) const
+{
+    const StarOctreeNode &node = nodes[nidx];
+    glm::dvec3 center(node.center[0], node.center[1], node.center[2]);
+    double dist = glm::length(obs - center) - scale * sqrt(3.0);
+
+    for (uint32_t idx = 0; idx < node.nStars; idx++)
+    {
+        CelestialStar &star = *catalog[starList[node.firstStar + idx]];
+
+        double dist = glm::length(obs - star.getStarPosition());
+        double appMag = convertAbsToAppMag(star.getAbsMag(), dist);
+
+        handle.process(star, dist, appMag);
+    }
+
+    if (node.childMask == 0)
+        return;
+    if (dist <= 0 || convertAbsToAppMag(node.exclusiveFactor, dist) <= limitingFactor)
+    {
+        uint32_t cidx = node.firstChild;
+        for (int idx = 0; idx < 8; idx++)
+            if (node.childMask & (1u << idx))
+                processVisibleNode(cidx++, handle, obs, limitingFactor, scale * 0.5);
+    }
+}
+
+void StarOctree::processCloseNode(uint32_t nidx, const glm::dvec3 &obs, const double radius,
+    const double scale, std::vector<const CelestialStar *> &stars) const
+{
+    const StarOctreeNode &node = nodes[nidx];
+    glm::dvec3 center(node.center[0], node.center[1], node.center[2]);
+    double dist = glm::length(obs - center) - scale * sqrt(3.0);
+    if (dist > radius)
+        return;
+
+    for (uint32_t idx = 0; idx < node.nStars; idx++)
+    {
+        const CelestialStar *star = catalog[starList[node.firstStar + idx]];
+        if (glm::length2(obs - star->getStarPosition()) < ofs::square(radius))
+            stars.push_back(star);
+    }
+
+    uint32_t cidx = node.firstChild;
+    for (int idx = 0; idx < 8; idx++)
+        if (node.childMask & (1u << idx))
+            processCloseNode(cidx++, obs, radius, scale * 0.5, stars);
+}
@@ -11,6 +11,10 @@
 #define STARTREE_MAGNITUDE      6.0
 #define STARTREE_ROOTSIZE       (10'000'000.0 / LY_PER_PARSEC)
 #define STARTREE_THRESHOLD      75
+#define STARTREE_MAXDEPTH       21      // Morton code bits per axis
+
+#define STARTREE_MAGIC          0x45525453  // 'STRE'
+#define STARTREE_VERSION        2
 
 class CelestialStar;
 
@@ -47,4 +51,79 @@ private:
     double  exclusiveFactor;
 
     std::vector<CelestialStar *> list;
+};
+
+// Bulk-loaded star octree
+//
+// Stars are sorted by Morton code and octree is built in one pass
+// over sorted star list. All nodes are stored in one contiguous
+// array (children of each node are adjacent) so that it can be
+// written to disk as it is by star catalog compiler.
+
+struct StarOctreeHeader
+{
+    uint32_t magic;         // File ID ('STRE')
+    uint32_t version;       // File version
+    uint32_t size;          // header size [bytes]
+    uint32_t nodeCount;     // Number of octree nodes
+    uint32_t starCount;     // Number of star indices
+    uint32_t catalogSize;   // Number of stars in catalog
+    uint64_t catalogHash;   // Hash of catalog stars
+    double   rootSize;      // Root cell half size [pc]
+};
+
+struct StarOctreeNode
+{
+    double   center[3];     // Cell center [pc]
+    double   exclusiveFactor; // Absolute magnitude limit
+    uint32_t firstChild;    // Index of first child node
+    uint32_t childMask;     // Occupied child cells (xPos|yPos|zPos)
+    uint32_t firstStar;     // Index of first star in star list
+    uint32_t nStars;        // Number of stars in this cell
+};
+
+class OFSAPI StarOctree
+{
+public:
+    StarOctree() = default;
+    ~StarOctree() = default;
+
+    void build(const std::vector<CelestialStar *> &stars, const glm::dvec3 &center,
+        double factor, double size);
+
+    bool save(const fs::path &fname) const;
+    bool load(const fs::path &fname, const std::vector<CelestialStar *> &stars,
+        const glm::dvec3 &center, double factor, double size);
+
+    inline uint32_t countNodes() const      { return nodes.size(); }
+    inline uint32_t countObjects() const    { return starList.size(); }
+
+    void processVisibleStars(const ofsHandler &handle, const glm::dvec3 &obs,
+        const double limitingFactor) const;
+    void processCloseStars(const glm::dvec3 &obs, const double radius,
+        std::vector<const CelestialStar *> &stars) const;
+
+private:
+    static uint64_t getCatalogHash(const std::vector<CelestialStar *> &stars);
+
+    struct mortonEntry
+    {
+        uint64_t code;      // Morton code of star position
+        uint32_t index;     // Index of star in catalog
+        double   absMag;    // Absolute magnitude
+    };
+
+    void buildNode(uint32_t nidx, mortonEntry *first, mortonEntry *last,
+        int depth, double scale);
+
+    void processVisibleNode(uint32_t nidx, const ofsHandler &handle, const glm::dvec3 &obs,
+        const double limitingFactor, const double scale) const;
+    void processCloseNode(uint32_t nidx, const glm::dvec3 &obs, const double radius,
+        const double scale, std::vector<const CelestialStar *> &stars) const;
+
+    double rootSize = 0.0;
+
+    std::vector<StarOctreeNode> nodes;
+    std::vector<uint32_t> starList;
+    std::vector<CelestialStar *> catalog;
 };
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "main/core.h"
 #include "utils/json.h"
 #include "engine/player.h"
+#include "main/checkpoint.h"
+#include "main/profiler.h"
 #include "engine/celestial.h"
 #include "engine/vehicle/vehicle.h"
 #include "ephem/orbit.h"
@@ -23,16 +25,24 @@
 #include "main/app.h"
 #include "engine/player.h"
 
-void Universe::init()
+void Universe::init(TaskGraph &graph)
 {
     fs::path homePath = OFS_HOME_DIR;
-    stardb.loadXHIPData(homePath / "data/xhip");
-    constellations.load(homePath / "data/constellations/western/constellationship.fab");
+
+    // Star catalog and constellations are independent from
+    // each other and can be loaded concurrently.
+    catalogTask = graph.add("Star catalog", [this, homePath]
+        { stardb.loadXHIPData(homePath / "data/xhip"); });
+    graph.add("Constellations", [this, homePath]
+        { constellations.load(homePath / "data/constellations/western/constellationship.fab"); });
     // constellations.load("constellations/western_rey/constellationship.fab");
 }
 
-void Universe::configure(cjson &config)
+void Universe::configure(cjson &config, TaskGraph &graph)
 {
+    lodDistance = myjson::getFloat<double>(config, "lod-distance", 1.0);
+    lodInterval = myjson::getFloat<double>(config, "lod-interval", 60.0);
+
     if (config["systems"].is_array())
     {
         for (auto &item : config["systems"].items())
@@ -57,7 +67,7 @@ void Universe::configure(cjson &config)
             ofsLogger->info("JSON: Name: {}, Folder: {}\n", sysName, sysFolder.string());
 
             sysFolder = OFS_HOME_DIR / sysFolder;
-            if (!pSystem::loadSystem(this, sysName, sysFolder));
+            pSystem::loadSystem(this, sysName, sysFolder, graph, catalogTask);
         }
     }
 }
@@ -118,9 +128,12 @@ void Universe::start()
 
 void Universe::update(Player *player, const TimeDate &td)
 {
+    FrameScope scope(prfUniverse);
+
     // Updating periodic close stars
     nearStars.clear();
-    findCloseStars(player->getPosition(), 1.0, nearStars);
+    activeSystems.clear();
+    findCloseStars(player->getPosition(), lodDistance, nearStars);
     // glm::dvec3 pos = player->getPosition();
     // ofsLogger->info("Update: {} nearby stars - Player position: {:f},{:f},{:f}\n",
     //     nearStars.size(), pos.x, pos.y, pos.z);
@@ -137,22 +150,57 @@ void Universe::update(Player *player, const TimeDate &td)
 
         // Logger::getLogger()->info("{}: Solar System List\n", sun->getsName());
         pSystem *psys = sun->getSystem();
-        if (psys != nullptr)
-            psys->update(true);
+        if (psys != nullptr && std::find(activeSystems.begin(), activeSystems.end(), psys) == activeSystems.end())
+            activeSystems.push_back(psys);
+    }
 
+    // Updating remote solar systems. Ephemerides and free orbits
+    // are analytic in time, so remote systems can advance at
+    // reduced cadence and catch up once observed. Systems with
+    // vehicles other than coasting or parked are promoted to
+    // full rate. Reduced cadence never runs past next predicted
+    // vehicle event.
+    double simt = td.getSimTime1();
+    for (auto psys : systemList)
+    {
+        if (std::find(activeSystems.begin(), activeSystems.end(), psys) != activeSystems.end())
+            continue;
+        if (psys->hasActiveVehicles() || fabs(simt - psys->getLastUpdate()) >= lodInterval ||
+            simt >= psys->getNextEvent())
+            activeSystems.push_back(psys);
     }
+
+    for (auto psys : activeSystems)
+        psys->update(true);
 }
 
 void Universe::finalizeUpdate()
 {
-    for (auto sun : nearStars)
+    for (auto psys : activeSystems)
+        psys->finalizeUpdate();
+}
+
+void Universe::saveState(Checkpoint &cp) const
+{
+    cp.write<uint32_t>(systemList.size());
+    for (auto psys : systemList)
+        psys->saveState(cp);
+}
+
+bool Universe::restoreState(Checkpoint &cp)
+{
+    uint32_t count = 0;
+    if (!cp.read(count) || count != systemList.size())
     {
-        if (!sun->hasSystem())
-            continue;
-        pSystem *psys = sun->getSystem();
-        if (psys != nullptr)
-            psys->finalizeUpdate();
+        ofsLogger->error("Checkpoint has {} systems, expected {}\n",
+            count, systemList.size());
+        return false;
     }
+
+    for (auto psys : systemList)
+        if (!psys->restoreState(cp))
+            return false;
+    return true;
 }
 
 void Universe::addSystem(pSystem *psys)
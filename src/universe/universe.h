@@ -10,11 +10,13 @@
 #include "universe/psystem.h"
 #include "universe/handle.h"
 #include "universe/celbody.h"
+#include "utils/threadpool.h"
 
 class Player;
 class Vehicle;
 class Celestial;
 class CelestialPlanet;
+class Checkpoint;
 
 class OFSAPI Universe
 {
@@ -25,15 +27,19 @@ public:
     inline StarDatabase &getStarDatabase()      { return stardb; }
     inline Constellations &getConstellations()  { return constellations; }
     inline std::vector<const CelestialStar *> &getNearStars() { return nearStars; }
+    inline const std::vector<pSystem *> &getSystemList() const { return systemList; }
 
-    void init();
+    void init(TaskGraph &graph);
     void start();
-    void configure(cjson &config);
+    void configure(cjson &config, TaskGraph &graph);
     void configureVehicles(cjson &config);
     void update(Player *player, const TimeDate &td);
     void finalizeUpdate();
     void finalizePostCreation();
 
+    void saveState(Checkpoint &cp) const;
+    bool restoreState(Checkpoint &cp);
+
     pSystem *createSolarSystem(cstr_t &sysName);
     pSystem *getSolarSystem(cstr_t &sysName) const;
     void addSystem(pSystem *psys);
@@ -66,4 +72,11 @@ private:
     SystemsList  systems;
 
     std::vector<const CelestialStar *> nearStars;
+    std::vector<pSystem *> activeSystems;   // systems updated this step
+
+    // Simulation level of detail
+    double lodDistance = 1.0;       // full-rate update radius [ly]
+    double lodInterval = 60.0;      // remote system update interval [s]
+
+    TaskGraph::taskId catalogTask = -1;
 };
\ No newline at end of file
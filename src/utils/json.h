@@ -19,8 +19,9 @@ namespace myjson
             return defValue;
         if (!config[name].is_boolean())
             return defValue;
-        ofsLogger->debug("JSON: {}: {}\n",
-            name, config[name].dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: {}: {}\n",
+                name, config[name].dump());
         // ofsLogger->info("JSON: {}: {}\n",
         //     name, config[name].get<T>());
         return config[name].get<T>();
@@ -33,8 +34,9 @@ namespace myjson
             return defValue;
         if (!config[name].is_number_integer())
             return defValue;
-        ofsLogger->debug("JSON: {}: {}\n",
-            name, config[name].dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: {}: {}\n",
+                name, config[name].dump());
         // ofsLogger->info("JSON: {}: {:d}\n",
         //     name, config[name].get<T>());
         return config[name].get<T>();
@@ -47,8 +49,9 @@ namespace myjson
             return defValue;
         if (!config[name].is_number())
             return defValue;
-        ofsLogger->debug("JSON: {}: {}\n",
-            name, config[name].dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: {}: {}\n",
+                name, config[name].dump());
         // ofsLogger->info("JSON: {}: {:f}\n",
         //     name, config[name].get<T>());
         return config[name].get<T>();
@@ -61,8 +64,9 @@ namespace myjson
             return defValue;
         if (!config[name].is_string())
             return defValue;
-        ofsLogger->debug("JSON: {}: {}\n",
-            name, config[name].dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: {}: {}\n",
+                name, config[name].dump());
         // ofsLogger->info("JSON: {}: {}\n",
         //     name, config[name].get<cstr_t>());
         return config[name].get<T>();
@@ -77,12 +81,13 @@ namespace myjson
             return defValue;
         T value = {};
         cjson &items = config[name];
-        ofsLogger->debug("JSON: {}: {}\n",
-            name, items.dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: {}: {}\n",
+                name, items.dump());
         for (int idx = 0; idx < items.size(); idx++) {
             if (items[idx].is_number()) {
                 value[idx] = items[idx].get<U>();
-                ofsLogger->info("JSON: {}[{:d}]: {:f}\n",
+                ofsLogger->info(Logger::catConfig, "JSON: {}[{:d}]: {:f}\n",
                     name, idx, value[idx]);
             }
         }
@@ -94,11 +99,12 @@ namespace myjson
     {
         if (!items.is_array())
             return;
-        ofsLogger->debug("JSON: array: {}\n", items.dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: array: {}\n", items.dump());
         for (int idx = 0; idx < size || idx < items.size(); idx++) {
             if (items[idx].is_number()) {
                 val[idx] = items[idx].get<T>();
-                ofsLogger->info("JSON: [{:d}]: {:f}\n", idx, val[idx]);
+                ofsLogger->info(Logger::catConfig, "JSON: [{:d}]: {:f}\n", idx, val[idx]);
             }
         }
     }
@@ -111,11 +117,12 @@ namespace myjson
         cjson &items = config[name];
         if (!items.is_array())
             return;
-        ofsLogger->debug("JSON: {}: {}\n", name, items.dump());
+        if (ofsLogger->isEnabled(Logger::catConfig, Logger::logDebug))
+            ofsLogger->debug(Logger::catConfig, "JSON: {}: {}\n", name, items.dump());
         for (int idx = 0; idx < size || idx < items.size(); idx++) {
             if (items[idx].is_number()) {
                 val[idx] = items[idx].get<T>();
-                ofsLogger->info("JSON: {}[{:d}]: {:f}\n", name, idx, val[idx]);
+                ofsLogger->info(Logger::catConfig, "JSON: {}[{:d}]: {:f}\n", name, idx, val[idx]);
             }
         }
     }
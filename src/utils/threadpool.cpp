@@ -0,0 +1,195 @@
+// threadpool.cpp - Thread pool/task graph package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#include "main/core.h"
+#include "main/profiler.h"
+#include "utils/threadpool.h"
+
+ThreadPool::ThreadPool(int nThreads)
+{
+    if (nThreads <= 0)
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int idx = 0; idx < nThreads; idx++)
+        workers.emplace_back([this]{ handle(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(muQueue);
+        runHandler = false;
+    }
+    cvQueue.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> lock(muQueue);
+        tasks.push(std::move(task));
+    }
+    cvQueue.notify_one();
+}
+
+// Run func(first, count) over [0, n) in chunks. Calling thread
+// takes chunks as well, so it may be a pool worker itself.
+// Returns when all chunks are done and rethrows first exception.
+void ThreadPool::parallelFor(int n, int chunk, const std::function<void(int, int)> &func)
+{
+    int nChunks = (n + chunk - 1) / chunk;
+    if (nChunks <= 1 || workers.empty())
+    {
+        func(0, n);
+        return;
+    }
+
+    struct State
+    {
+        std::atomic<int> next = 0;
+        std::atomic<int> done = 0;
+        std::mutex muDone;
+        std::condition_variable cvDone;
+        std::exception_ptr error;
+    };
+    // Helpers may start after all chunks are taken, so
+    // state outlives this call. func is only touched while
+    // chunk is pending and caller is still waiting.
+    auto state = std::make_shared<State>();
+
+    auto work = [state, n, chunk, nChunks, &func]
+    {
+        for (int idx; (idx = state->next++) < nChunks;)
+        {
+            int first = idx * chunk;
+            try
+            {
+                func(first, std::min(chunk, n - first));
+            }
+            catch (...)
+            {
+                std::unique_lock<std::mutex> lock(state->muDone);
+                if (state->error == nullptr)
+                    state->error = std::current_exception();
+            }
+            if (++state->done == nChunks)
+            {
+                std::unique_lock<std::mutex> lock(state->muDone);
+                state->cvDone.notify_all();
+            }
+        }
+    };
+
+    int nHelpers = std::min<int>(workers.size(), nChunks - 1);
+    for (int idx = 0; idx < nHelpers; idx++)
+        submit(work);
+    work();
+
+    std::unique_lock<std::mutex> lock(state->muDone);
+    state->cvDone.wait(lock, [&]{ return state->done == nChunks; });
+    if (state->error != nullptr)
+        std::rethrow_exception(state->error);
+}
+
+void ThreadPool::handle()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(muQueue);
+            cvQueue.wait(lock, [this]{ return !runHandler || !tasks.empty(); });
+            if (tasks.empty())
+                return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+
+        task();
+    }
+}
+
+// ******** Task Graph ********
+
+TaskGraph::taskId TaskGraph::add(cstr_t &name, std::function<void()> func,
+    const std::vector<taskId> &deps)
+{
+    taskId id = tasks.size();
+    Task &task = tasks.emplace_back();
+
+    task.name = name;
+    task.func = std::move(func);
+    for (auto dep : deps)
+    {
+        if (dep < 0 || dep >= id)
+            continue;
+        tasks[dep].next.push_back(id);
+        task.nDeps++;
+    }
+
+    return id;
+}
+
+void TaskGraph::execute(ThreadPool &pool, taskId id)
+{
+    Task &task = tasks[id];
+    bool failed = task.skip;
+
+    if (!failed)
+    {
+        try
+        {
+            ProfileScope scope(task.name, "task");
+            task.func();
+        }
+        catch (...)
+        {
+            ofsLogger->error("Task '{}' failed\n", task.name);
+            std::unique_lock<std::mutex> lock(muDone);
+            if (error == nullptr)
+                error = std::current_exception();
+            failed = true;
+        }
+    }
+
+    // Release all tasks that are waiting for this task.
+    for (auto next : task.next)
+    {
+        if (failed)
+            tasks[next].skip = true;
+        if (--tasks[next].remain == 0)
+            pool.submit([this, &pool, next]{ execute(pool, next); });
+    }
+
+    // Notify while holding lock so that run() can not return
+    // and destroy this graph before notification is done.
+    std::unique_lock<std::mutex> lock(muDone);
+    nDone++;
+    cvDone.notify_all();
+}
+
+void TaskGraph::run(ThreadPool &pool)
+{
+    nDone = 0;
+    error = nullptr;
+    for (auto &task : tasks)
+    {
+        task.remain = task.nDeps;
+        task.skip = false;
+    }
+
+    for (taskId id = 0; id < tasks.size(); id++)
+        if (tasks[id].nDeps == 0)
+            pool.submit([this, &pool, id]{ execute(pool, id); });
+
+    std::unique_lock<std::mutex> lock(muDone);
+    cvDone.wait(lock, [this]{ return nDone == tasks.size(); });
+    if (error != nullptr)
+        std::rethrow_exception(error);
+}
@@ -0,0 +1,75 @@
+// threadpool.h - Thread pool/task graph package
+//
+// Author:  Tim Stark
+// Date:    Oct 19, 2026
+
+#pragma once
+
+#include <functional>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+
+class ThreadPool
+{
+public:
+    ThreadPool(int nThreads = 0);
+    ~ThreadPool();
+
+    inline int getThreadCount() const       { return workers.size(); }
+
+    void submit(std::function<void()> task);
+    void parallelFor(int n, int chunk, const std::function<void(int, int)> &func);
+
+protected:
+    void handle();
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+
+    std::mutex muQueue;
+    std::condition_variable cvQueue;
+    bool runHandler = true;
+};
+
+// Task graph for running independent jobs concurrently on
+// thread pool. Each task starts when all tasks that it depends
+// on are done. Tasks must be added before run() is called.
+// Exception from a task skips tasks depending on it and is
+// rethrown by run() when all tasks are finished.
+class TaskGraph
+{
+public:
+    using taskId = int;
+
+    TaskGraph() = default;
+    ~TaskGraph() = default;
+
+    taskId add(cstr_t &name, std::function<void()> func,
+        const std::vector<taskId> &deps = {});
+
+    void run(ThreadPool &pool);
+
+    inline int getTaskCount() const         { return tasks.size(); }
+
+private:
+    struct Task
+    {
+        str_t name;
+        std::function<void()> func;
+        std::vector<taskId> next;
+        int nDeps = 0;
+        std::atomic<int> remain = 0;
+        std::atomic<bool> skip = false;
+    };
+
+    void execute(ThreadPool &pool, taskId id);
+
+    std::deque<Task> tasks;
+
+    std::mutex muDone;
+    std::condition_variable cvDone;
+    int nDone = 0;
+    std::exception_ptr error;
+};
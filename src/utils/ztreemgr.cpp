@@ -165,8 +165,11 @@ int zTreeManager::read(int lod, int lat, int lng, uint8_t **data, bool debug)
     zdata = new uint8_t[zsize];
     udata = new uint8_t[usize];
 
-    zfile.seekg(nodes[idx].pos + hdr.dataOfs, zfile.beg);
-    zfile.read((char *)zdata, zsize);
+    {
+        std::unique_lock<std::mutex> lock(muRead);
+        zfile.seekg(nodes[idx].pos + hdr.dataOfs, zfile.beg);
+        zfile.read((char *)zdata, zsize);
+    }
     res = inflateData(zdata, zsize, udata, usize);
     if (res != usize)
     {
@@ -52,6 +52,7 @@ protected:
 
 private:
     std::ifstream zfile;
+    std::mutex    muRead;   // shared by simulation and tile loader threads
 
     zTreeHeader hdr;
     zTreeNode  *nodes;